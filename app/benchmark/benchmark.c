@@ -0,0 +1,85 @@
+#include "benchmark.h"
+#include "../../src/random.h"
+
+#include <stdlib.h>
+
+//
+// 'benchmark.h' implementations
+//
+
+double benchmark_repeat(benchmark_function_t function, void *data, double min_seconds) {
+    function(data);
+    int iterations = 0;
+    double start = timer_seconds();
+    double elapsed;
+    do {
+        function(data);
+        iterations++;
+        elapsed = timer_seconds() - start;
+    } while (elapsed < min_seconds);
+    return elapsed / iterations;
+}
+
+void benchmark_fill_random(double *data, int length) {
+    for (int i = 0; i < length; i++)
+        data[i] = random_double_between(-1, 1);
+}
+
+void benchmark_dataset_create(benchmark_dataset_t *dataset, int n_cases, int input_size, int output_size, double noise) {
+    dataset->n_cases = n_cases;
+    dataset->input_size = input_size;
+    dataset->output_size = output_size;
+    double *centres = (double *)malloc(output_size * input_size * sizeof(double));
+    benchmark_fill_random(centres, output_size * input_size);
+    dataset->input_data = (double *)malloc((size_t)n_cases * input_size * sizeof(double));
+    dataset->label_data = (double *)calloc((size_t)n_cases * output_size, sizeof(double));
+    dataset->classes = (unsigned char *)malloc(n_cases);
+    dataset->inputs = (matrix_t *)malloc(n_cases * sizeof(matrix_t));
+    dataset->labels = (matrix_t *)malloc(n_cases * sizeof(matrix_t));
+    for (int i = 0; i < n_cases; i++) {
+        int class = random_int_between(0, output_size);
+        dataset->classes[i] = class;
+        dataset->label_data[(size_t)i * output_size + class] = 1;
+        for (int j = 0; j < input_size; j++)
+            dataset->input_data[(size_t)i * input_size + j] = centres[class * input_size + j] + noise * random_double_between(-1, 1);
+    }
+    matrix_initialize_multiple_from_array(dataset->inputs, n_cases, 1, input_size, dataset->input_data);
+    matrix_initialize_multiple_from_array(dataset->labels, n_cases, 1, output_size, dataset->label_data);
+    free(centres);
+}
+
+void benchmark_dataset_delete(benchmark_dataset_t *dataset) {
+    free(dataset->input_data);
+    free(dataset->label_data);
+    free(dataset->classes);
+    free(dataset->inputs);
+    free(dataset->labels);
+}
+
+double benchmark_dataset_accuracy(neural_network_t *nn, benchmark_dataset_t *dataset) {
+    neural_network_inference_ctx_t ctx;
+    neural_network_inference_ctx_initialize(nn, &ctx, dataset->n_cases);
+    matrix_t input_rows;
+    int offset = 0;
+    matrix_initialize_from_array(&input_rows, dataset->input_size, dataset->n_cases, dataset->input_data, &offset);
+    matrix_t inputs = matrix_transpose_view(&input_rows);
+    matrix_t outputs = neural_network_inference_evaluate(nn, &ctx, &inputs);
+    int correct = 0;
+    for (int i = 0; i < dataset->n_cases; i++) {
+        int best = 0;
+        for (int j = 1; j < dataset->output_size; j++) {
+            if (matrix_get(&outputs, i, j) > matrix_get(&outputs, i, best))
+                best = j;
+        }
+        correct += best == dataset->classes[i];
+    }
+    neural_network_inference_ctx_delete(&ctx);
+    return (double)correct / dataset->n_cases;
+}
+
+void benchmark_copy_network(neural_network_t *nn_I, neural_network_t *nn_O) {
+    for (int i = 0; i < nn_I->hidden_layer_count + 1; i++) {
+        matrix_copy_o(&nn_I->layers[i].weights, &nn_O->layers[i].weights);
+        matrix_copy_o(&nn_I->layers[i].biases, &nn_O->layers[i].biases);
+    }
+}
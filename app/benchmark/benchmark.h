@@ -0,0 +1,69 @@
+#ifndef BENCHMARK
+#define BENCHMARK
+
+#include "../../src/matrix.h"
+#include "../../src/neural_network.h"
+#include "../../src/timer.h"
+
+//
+// 'benchmark.h' definitions
+//
+
+#define BENCHMARK_MIN_SECONDS 0.25
+
+typedef void (*benchmark_function_t)(void *);
+
+/**
+ * Run the inputted function repeatedly until at least 'min_seconds' has passed, after a single warm-up call.
+ * @param function The function to time.
+ * @param data The data passed to the function on every call.
+ * @param min_seconds The minimum total time spent timing the function.
+ * @return The average number of seconds taken by a single call.
+*/
+double benchmark_repeat(benchmark_function_t function, void *data, double min_seconds);
+
+/**
+ * Fill the inputted array with random values between (-1,1).
+*/
+void benchmark_fill_random(double *data, int length);
+
+/**
+ * A synthetic classification dataset, each case a random class centre plus uniform noise, with a one-hot label per case.
+*/
+typedef struct {
+    int n_cases;
+    int input_size;
+    int output_size;
+    double *input_data;
+    double *label_data;
+    unsigned char *classes;
+    matrix_t *inputs;
+    matrix_t *labels;
+} benchmark_dataset_t;
+
+/**
+ * Create a synthetic classification dataset from the random number generator's current state.
+ * @param dataset The dataset to be initialized.
+ * @param n_cases The number of cases.
+ * @param input_size The number of inputs of each case.
+ * @param output_size The number of classes.
+ * @param noise The largest distance of each input from its class centre, whose inputs are between (-1,1).
+*/
+void benchmark_dataset_create(benchmark_dataset_t *dataset, int n_cases, int input_size, int output_size, double noise);
+
+/**
+ * Free the arrays of a dataset created with 'benchmark_dataset_create'.
+*/
+void benchmark_dataset_delete(benchmark_dataset_t *dataset);
+
+/**
+ * @return The proportion of the dataset's cases whose largest output from the network is their class.
+*/
+double benchmark_dataset_accuracy(neural_network_t *nn, benchmark_dataset_t *dataset);
+
+/**
+ * Copy the weights and biases of one network into another of the same shape.
+*/
+void benchmark_copy_network(neural_network_t *nn_I, neural_network_t *nn_O);
+
+#endif
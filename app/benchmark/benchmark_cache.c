@@ -0,0 +1,134 @@
+#include "benchmark.h"
+#include "benchmark_cache.h"
+#include "../../src/idx.h"
+#include "../../src/idx_cache.h"
+#include "../../src/neural_network.h"
+#include "../../src/neural_network_train.h"
+#include "../../src/error.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+//
+// 'benchmark_cache.c' definitions
+//
+
+#define CACHE_WIDTH 28
+#define CACHE_INPUT_SIZE (CACHE_WIDTH * CACHE_WIDTH)
+#define CACHE_HIDDEN_SIZE 32
+#define CACHE_OUTPUT_SIZE 10
+#define CACHE_CASES 16384
+#define CACHE_BATCH_SIZE 100
+#define CACHE_EPOCHS 3
+#define CACHE_PARAMETER 0.1
+#define CACHE_PIXEL_MAX 255.0
+
+void benchmark_cache_write_idx(const char *filename, benchmark_dataset_t *dataset);
+void benchmark_cache_report(const char *name, double load_seconds, double seconds, double baseline_seconds);
+
+//
+// 'benchmark_cache.h' implementations
+//
+
+void benchmark_cache() {
+    benchmark_dataset_t dataset;
+    benchmark_dataset_create(&dataset, CACHE_CASES, CACHE_INPUT_SIZE, CACHE_OUTPUT_SIZE, 1.0);
+    char source_filename[] = "/tmp/benchmark_cache_XXXXXX";
+    close(mkstemp(source_filename));
+    char cache_filename[64];
+    snprintf(cache_filename, sizeof(cache_filename), "%s.cache", source_filename);
+    benchmark_cache_write_idx(source_filename, &dataset);
+
+    idx_file_t source;
+    idx_file_open(&source, source_filename);
+    idx_cache_t cache;
+    double start = timer_seconds();
+    idx_cache_open(&cache, source_filename, cache_filename, IDX_CACHE_F64, CACHE_PIXEL_MAX);
+    double write_seconds = timer_seconds() - start;
+    idx_cache_close(&cache);
+    start = timer_seconds();
+    idx_cache_open(&cache, source_filename, cache_filename, IDX_CACHE_F64, CACHE_PIXEL_MAX);
+    double map_seconds = timer_seconds() - start;
+
+    int hidden_layer_sizes[1] = { CACHE_HIDDEN_SIZE };
+    char *activation_function_names[2] = { "sigmoid", "sigmoid" };
+    neural_network_t *nn = neural_network_create(CACHE_INPUT_SIZE, CACHE_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_layers_randomize(nn);
+    neural_network_trainer_t trainer;
+    neural_network_trainer_initialize(nn, &trainer, CACHE_BATCH_SIZE);
+    double *inputs_data = (double *)aligned_alloc(64, CACHE_BATCH_SIZE * CACHE_INPUT_SIZE * sizeof(double));
+    matrix_t inputs[CACHE_BATCH_SIZE];
+    matrix_initialize_multiple_from_array(inputs, CACHE_BATCH_SIZE, 1, CACHE_INPUT_SIZE, inputs_data);
+    // The cache's values viewed in place, one matrix per case.
+    matrix_t *cache_inputs = (matrix_t *)malloc(CACHE_CASES * sizeof(matrix_t));
+    matrix_initialize_multiple_from_array(cache_inputs, CACHE_CASES, 1, CACHE_INPUT_SIZE, (double *)idx_cache_item_f64(&cache, 0));
+
+    printf("%d cases of %dx%d bytes, batch %d, %d-%d-%d network, %d epochs\n", CACHE_CASES, CACHE_WIDTH, CACHE_WIDTH, CACHE_BATCH_SIZE, CACHE_INPUT_SIZE, CACHE_HIDDEN_SIZE, CACHE_OUTPUT_SIZE, CACHE_EPOCHS);
+    printf("Writing the cache: %.4fs, mapping the written cache: %.6fs\n", write_seconds, map_seconds);
+    printf("%-12s %14s %16s %10s\n", "Inputs", "Loading/epoch", "Seconds/epoch", "Speedup");
+    double baseline_seconds = 0;
+    for (int mode = 0; mode < 3; mode++) {
+        double load_seconds = 0;
+        start = timer_seconds();
+        for (int epoch = 0; epoch < CACHE_EPOCHS; epoch++) {
+            for (int32_t i = 0; i < CACHE_CASES; i += CACHE_BATCH_SIZE) {
+                int n_cases = CACHE_CASES - i < CACHE_BATCH_SIZE ? CACHE_CASES - i : CACHE_BATCH_SIZE;
+                double load_start = timer_seconds();
+                matrix_t *batch_inputs = inputs;
+                if (mode == 0) {
+                    const uint8_t *bytes = idx_file_item(&source, i);
+                    for (int j = 0; j < n_cases * CACHE_INPUT_SIZE; j++)
+                        inputs_data[j] = bytes[j] / CACHE_PIXEL_MAX;
+                }
+                else if (mode == 1) {
+                    memcpy(inputs_data, idx_cache_item_f64(&cache, i), (size_t)n_cases * CACHE_INPUT_SIZE * sizeof(double));
+                }
+                else {
+                    batch_inputs = cache_inputs + i;
+                }
+                load_seconds += timer_seconds() - load_start;
+                neural_network_trainer_train_batch(&trainer, batch_inputs, dataset.labels + i, n_cases, CACHE_PARAMETER);
+            }
+        }
+        double seconds = (timer_seconds() - start) / CACHE_EPOCHS;
+        if (mode == 0)
+            baseline_seconds = seconds;
+        const char *names[3] = { "normalized", "cache copy", "cache view" };
+        benchmark_cache_report(names[mode], load_seconds / CACHE_EPOCHS, seconds, baseline_seconds);
+    }
+
+    neural_network_trainer_delete(&trainer);
+    neural_network_delete(nn);
+    free(inputs_data);
+    free(cache_inputs);
+    idx_cache_close(&cache);
+    idx_file_close(&source);
+    remove(source_filename);
+    remove(cache_filename);
+    benchmark_dataset_delete(&dataset);
+}
+
+//
+// 'benchmark_cache.c' implementations
+//
+
+/**
+ * Write the dataset's inputs scaled to bytes as an IDX file of square images.
+*/
+void benchmark_cache_write_idx(const char *filename, benchmark_dataset_t *dataset) {
+    FILE *file = fopen(filename, "wb");
+    cnd_make_error(file == NULL, "Failed to create the cache benchmark's file.");
+    unsigned char header[16] = { 0, 0, 0x08, 3, CACHE_CASES >> 24, (CACHE_CASES >> 16) & 0xFF, (CACHE_CASES >> 8) & 0xFF, CACHE_CASES & 0xFF, 0, 0, 0, CACHE_WIDTH, 0, 0, 0, CACHE_WIDTH };
+    fwrite(header, 1, sizeof(header), file);
+    for (size_t i = 0; i < (size_t)CACHE_CASES * CACHE_INPUT_SIZE; i++) {
+        double x = (dataset->input_data[i] + 2) / 4;
+        fputc((int)(x < 0 ? 0 : x > 1 ? 255 : x * 255), file);
+    }
+    fclose(file);
+}
+
+void benchmark_cache_report(const char *name, double load_seconds, double seconds, double baseline_seconds) {
+    printf("%-12s %14.4f %16.4f %9.2fx\n", name, load_seconds, seconds, baseline_seconds / seconds);
+}
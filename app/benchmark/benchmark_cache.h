@@ -0,0 +1,10 @@
+//
+// 'benchmark_cache.h' definitions
+//
+
+/**
+ * Train a network on an IDX file of MNIST shaped cases, normalizing the bytes of every batch each epoch,
+ * copying the batches from a cache of the normalized values, and training on views of the mapped cache,
+ * reporting the time per epoch spent loading batches and the time per epoch in total.
+*/
+void benchmark_cache();
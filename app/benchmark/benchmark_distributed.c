@@ -0,0 +1,140 @@
+#include "benchmark.h"
+#include "benchmark_distributed.h"
+#include "../../src/error.h"
+#include "../../src/matrix.h"
+#include "../../src/matrix_gemm.h"
+#include "../../src/neural_network.h"
+#include "../../src/neural_network_train.h"
+#include "../../src/process_ring.h"
+#include "../../src/thread_pool.h"
+
+#include <stdio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+//
+// 'benchmark_distributed.c' definitions
+//
+
+#define DISTRIBUTED_INPUT_SIZE 784
+#define DISTRIBUTED_HIDDEN_SIZE 64
+#define DISTRIBUTED_OUTPUT_SIZE 10
+#define DISTRIBUTED_CASES 8192
+#define DISTRIBUTED_NOISE 2.0
+#define DISTRIBUTED_EPOCHS 2
+// Each process trains on batches of this many cases, the ring's batch is this many cases per process.
+#define DISTRIBUTED_BATCH_SIZE 16
+#define DISTRIBUTED_MAX_PROCESSES 8
+
+/**
+ * What the first process of a ring reports back through a pipe.
+*/
+typedef struct {
+    double seconds;
+    double accuracy;
+} distributed_result_t;
+
+void distributed_process(const char *address, int rank, int size, neural_network_t *nn, benchmark_dataset_t *dataset, int result_fd);
+distributed_result_t distributed_run(int size, neural_network_t *nn, benchmark_dataset_t *dataset);
+
+//
+// 'benchmark_distributed.h' implementations
+//
+
+void benchmark_distributed() {
+    benchmark_dataset_t dataset;
+    benchmark_dataset_create(&dataset, DISTRIBUTED_CASES, DISTRIBUTED_INPUT_SIZE, DISTRIBUTED_OUTPUT_SIZE, DISTRIBUTED_NOISE);
+    int hidden_layer_sizes[1] = { DISTRIBUTED_HIDDEN_SIZE };
+    char *activation_function_names[2] = { "sigmoid", "sigmoid" };
+    neural_network_t *nn = neural_network_create(DISTRIBUTED_INPUT_SIZE, DISTRIBUTED_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_layers_randomize(nn);
+
+    // Every process of every ring starts from a forked copy of the same weights and dataset.
+    printf("Online CPUs: %d\n", thread_pool_cpu_count());
+    printf("%-10s %15s %9s %11s %10s\n", "Processes", "Epoch seconds", "Speedup", "Efficiency", "Accuracy");
+    double single_seconds = 0;
+    for (int size = 1; size <= DISTRIBUTED_MAX_PROCESSES; size *= 2) {
+        distributed_result_t result = distributed_run(size, nn, &dataset);
+        if (size == 1)
+            single_seconds = result.seconds;
+        double speedup = single_seconds / result.seconds;
+        printf("%-10d %15.3f %8.2fx %10.1f%% %9.2f%%\n", size, result.seconds, speedup, 100 * speedup / size, 100 * result.accuracy);
+    }
+
+    neural_network_delete(nn);
+    benchmark_dataset_delete(&dataset);
+}
+
+//
+// 'benchmark_distributed.c' implementations
+//
+
+distributed_result_t distributed_run(int size, neural_network_t *nn, benchmark_dataset_t *dataset) {
+    char address[64];
+    sprintf(address, "unix:/tmp/benchmark_distributed_%d_%d", (int)getpid(), size);
+    int fds[2];
+    cnd_make_error(pipe(fds) != 0, "Failed to create the distributed benchmark's pipe.");
+    fflush(stdout);
+    pid_t pids[DISTRIBUTED_MAX_PROCESSES];
+    for (int rank = 0; rank < size; rank++) {
+        pids[rank] = fork();
+        cnd_make_error(pids[rank] < 0, "Failed to fork a distributed benchmark process.");
+        if (pids[rank] == 0) {
+            close(fds[0]);
+            distributed_process(address, rank, size, nn, dataset, fds[1]);
+            _exit(0);
+        }
+    }
+    close(fds[1]);
+
+    distributed_result_t result;
+    ssize_t received = read(fds[0], &result, sizeof(result));
+    close(fds[0]);
+    int failed = received != sizeof(result);
+    for (int rank = 0; rank < size; rank++) {
+        int status;
+        waitpid(pids[rank], &status, 0);
+        failed |= !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    }
+    cnd_make_error(failed, "A distributed benchmark process failed.");
+    return result;
+}
+
+void distributed_process(const char *address, int rank, int size, neural_network_t *nn, benchmark_dataset_t *dataset, int result_fd) {
+    // One thread per process, the processes are what is being scaled. The parent's pool threads do not survive the fork.
+    matrix_gemm_set_thread_pool(thread_pool_create(1));
+    process_ring_t *ring = process_ring_create(address, rank, size);
+    neural_network_trainer_t trainer;
+    neural_network_trainer_initialize(nn, &trainer, DISTRIBUTED_BATCH_SIZE);
+
+    // Contiguous shards, every process takes the same number of steps, the shorter shards contributing empty batches at the end.
+    int shard_start = (int)((long)DISTRIBUTED_CASES * rank / size);
+    int shard_end = (int)((long)DISTRIBUTED_CASES * (rank + 1) / size);
+    int largest_shard = (DISTRIBUTED_CASES + size - 1) / size;
+    int steps = (largest_shard + DISTRIBUTED_BATCH_SIZE - 1) / DISTRIBUTED_BATCH_SIZE;
+    // The mean gradient over the ring's batch, scaled as 'benchmark_train' scales the parameter by the batch size.
+    double p = 0.01 * DISTRIBUTED_BATCH_SIZE * size;
+
+    // Wait for every process to be connected before starting the clock.
+    double barrier = 0;
+    process_ring_allreduce(ring, &barrier, 1);
+    double start = timer_seconds();
+    for (int epoch = 0; epoch < DISTRIBUTED_EPOCHS; epoch++) {
+        for (int step = 0; step < steps; step++) {
+            int i = shard_start + step * DISTRIBUTED_BATCH_SIZE;
+            int n = shard_end - i < DISTRIBUTED_BATCH_SIZE ? shard_end - i : DISTRIBUTED_BATCH_SIZE;
+            if (n < 0)
+                n = 0;
+            neural_network_train_distributed(&trainer, ring, dataset->inputs + i, dataset->labels + i, n, p);
+        }
+    }
+    distributed_result_t result = { (timer_seconds() - start) / DISTRIBUTED_EPOCHS, 0 };
+
+    if (rank == 0) {
+        result.accuracy = benchmark_dataset_accuracy(nn, dataset);
+        cnd_make_error(write(result_fd, &result, sizeof(result)) != sizeof(result), "Failed to report the distributed benchmark's result.");
+    }
+    close(result_fd);
+    neural_network_trainer_delete(&trainer);
+    process_ring_delete(ring);
+}
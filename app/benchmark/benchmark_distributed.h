@@ -0,0 +1,9 @@
+//
+// 'benchmark_distributed.h' definitions
+//
+
+/**
+ * Train an MNIST sized network on a synthetic classification dataset split across rings of 1, 2, 4 and 8 processes on this machine,
+ * reporting the seconds per epoch, the speedup and the efficiency over a single process, and the accuracy reached.
+*/
+void benchmark_distributed();
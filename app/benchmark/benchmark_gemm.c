@@ -0,0 +1,115 @@
+#include "benchmark.h"
+#include "benchmark_gemm.h"
+#include "../../src/matrix.h"
+#include "../../src/matrix_f32.h"
+
+#include <stdio.h>
+
+//
+// 'benchmark_gemm.c' definitions
+//
+
+typedef struct {
+    const char *name;
+    // Dimensions in the library's (cols, rows) order.
+    int a_cols;
+    int a_rows;
+    int b_cols;
+} gemm_shape_t;
+
+typedef struct {
+    matrix_t *mat_A;
+    matrix_t *mat_B;
+    matrix_t *mat_O;
+    matrix_f32_t *mat_A_f32;
+    matrix_f32_t *mat_B_f32;
+    matrix_f32_t *mat_O_f32;
+} gemm_operands_t;
+
+/**
+ * The matrix multiplication as it was implemented before the blocked engine, kept as the baseline.
+*/
+void gemm_naive(matrix_t *mat_A, matrix_t *mat_B, matrix_t *mat_O);
+void gemm_naive_call(void *operands);
+void gemm_engine_call(void *operands);
+void gemm_engine_f32_call(void *operands);
+
+//
+// 'benchmark_gemm.h' implementations
+//
+
+void benchmark_gemm() {
+    gemm_shape_t shapes[] = {
+        // A hidden layer of 32 on a 784 pixel input, and the 10 digit output layer, one case at a time.
+        { "MNIST 784x32 * 1x784", 784, 32, 1 },
+        { "MNIST 32x10 * 1x32", 32, 10, 1 },
+        { "Square 64", 64, 64, 64 },
+        { "Square 256", 256, 256, 256 },
+        { "Square 512", 512, 512, 512 },
+        { "Square 1024", 1024, 1024, 1024 },
+    };
+    int n_shapes = sizeof(shapes) / sizeof(shapes[0]);
+
+    printf("%-24s %14s %14s %10s %14s\n", "Shape", "Naive GFLOP/s", "GEMM GFLOP/s", "Speedup", "F32 GFLOP/s");
+    for (int i = 0; i < n_shapes; i++) {
+        gemm_shape_t shape = shapes[i];
+        gemm_operands_t operands = {
+            matrix_create(shape.a_cols, shape.a_rows),
+            matrix_create(shape.b_cols, shape.a_cols),
+            matrix_create(shape.b_cols, shape.a_rows),
+            matrix_f32_create(shape.a_cols, shape.a_rows),
+            matrix_f32_create(shape.b_cols, shape.a_cols),
+            matrix_f32_create(shape.b_cols, shape.a_rows)
+        };
+        benchmark_fill_random(operands.mat_A->data, shape.a_cols * shape.a_rows);
+        benchmark_fill_random(operands.mat_B->data, shape.b_cols * shape.a_cols);
+        for (int j = 0; j < shape.a_cols * shape.a_rows; j++)
+            operands.mat_A_f32->data[j] = (float)operands.mat_A->data[j];
+        for (int j = 0; j < shape.b_cols * shape.a_cols; j++)
+            operands.mat_B_f32->data[j] = (float)operands.mat_B->data[j];
+
+        double flops = 2.0 * shape.a_cols * shape.a_rows * shape.b_cols;
+        double naive_seconds = benchmark_repeat(gemm_naive_call, &operands, BENCHMARK_MIN_SECONDS);
+        double engine_seconds = benchmark_repeat(gemm_engine_call, &operands, BENCHMARK_MIN_SECONDS);
+        double engine_f32_seconds = benchmark_repeat(gemm_engine_f32_call, &operands, BENCHMARK_MIN_SECONDS);
+        printf("%-24s %14.3f %14.3f %9.1fx %14.3f\n", shape.name, flops / naive_seconds * 1e-9, flops / engine_seconds * 1e-9, naive_seconds / engine_seconds, flops / engine_f32_seconds * 1e-9);
+
+        matrix_delete(operands.mat_A);
+        matrix_delete(operands.mat_B);
+        matrix_delete(operands.mat_O);
+        matrix_f32_delete(operands.mat_A_f32);
+        matrix_f32_delete(operands.mat_B_f32);
+        matrix_f32_delete(operands.mat_O_f32);
+    }
+}
+
+//
+// 'benchmark_gemm.c' implementations
+//
+
+void gemm_naive(matrix_t *mat_A, matrix_t *mat_B, matrix_t *mat_O) {
+    for (int j = 0; j < mat_O->rows; j++) {
+        for (int i = 0; i < mat_O->cols; i++) {
+            double sum = 0;
+            for (int k = 0; k < mat_A->cols; k++) {
+                sum += matrix_get(mat_A, k, j) * matrix_get(mat_B, i, k);
+            }
+            matrix_set(mat_O, i, j, sum);
+        }
+    }
+}
+
+void gemm_naive_call(void *operands) {
+    gemm_operands_t *op = (gemm_operands_t *)operands;
+    gemm_naive(op->mat_A, op->mat_B, op->mat_O);
+}
+
+void gemm_engine_call(void *operands) {
+    gemm_operands_t *op = (gemm_operands_t *)operands;
+    matrix_multiply_o(op->mat_A, op->mat_B, op->mat_O);
+}
+
+void gemm_engine_f32_call(void *operands) {
+    gemm_operands_t *op = (gemm_operands_t *)operands;
+    matrix_f32_multiply_o(op->mat_A_f32, op->mat_B_f32, op->mat_O_f32);
+}
@@ -0,0 +1,8 @@
+//
+// 'benchmark_gemm.h' definitions
+//
+
+/**
+ * Compare the naive matrix multiplication against 'matrix_multiply_o' on the MNIST layer shapes and on square matrices, reporting GFLOP/s.
+*/
+void benchmark_gemm();
@@ -0,0 +1,141 @@
+#include "benchmark.h"
+#include "benchmark_hogwild.h"
+#include "../../src/matrix.h"
+#include "../../src/neural_network.h"
+#include "../../src/neural_network_train.h"
+#include "../../src/random.h"
+#include "../../src/thread_pool.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// 'benchmark_hogwild.c' definitions
+//
+
+#define HOGWILD_INPUT_SIZE 784
+#define HOGWILD_HIDDEN_SIZE 32
+#define HOGWILD_OUTPUT_SIZE 10
+#define HOGWILD_CASES 8192
+#define HOGWILD_BATCH_SIZE 16
+#define HOGWILD_EPOCHS 4
+#define HOGWILD_PARAMETER (0.01 * HOGWILD_BATCH_SIZE)
+// Data-parallel training splits batches of this many cases across its workers, with the training parameter scaled to match.
+#define HOGWILD_DATA_PARALLEL_BATCH_SIZE (4 * HOGWILD_BATCH_SIZE)
+#define HOGWILD_DATA_PARALLEL_PARAMETER (0.01 * HOGWILD_DATA_PARALLEL_BATCH_SIZE)
+// The amount of noise added to each case's class centre, large enough that accuracy climbs over several epochs.
+#define HOGWILD_NOISE 2.0
+
+/**
+ * Hands out the cases of a dataset a batch at a time.
+*/
+typedef struct {
+    benchmark_dataset_t *dataset;
+    atomic_int next;
+} hogwild_source_t;
+
+typedef enum {
+    HOGWILD_MODE_SINGLE,
+    HOGWILD_MODE_HOGWILD,
+    HOGWILD_MODE_DATA_PARALLEL
+} hogwild_mode_t;
+
+typedef struct {
+    hogwild_mode_t mode;
+    int n_workers;
+} hogwild_run_t;
+
+int hogwild_next_batch(void *source_ptr, int worker, matrix_t **inputs, matrix_t **labels);
+void hogwild_train_epoch(hogwild_run_t run, neural_network_trainer_t *trainers, hogwild_source_t *source, thread_pool_t *pool);
+
+//
+// 'benchmark_hogwild.h' implementations
+//
+
+void benchmark_hogwild() {
+    benchmark_dataset_t dataset;
+    benchmark_dataset_create(&dataset, HOGWILD_CASES, HOGWILD_INPUT_SIZE, HOGWILD_OUTPUT_SIZE, HOGWILD_NOISE);
+    hogwild_source_t source = { .dataset=&dataset };
+    int hidden_layer_sizes[1] = { HOGWILD_HIDDEN_SIZE };
+    char *activation_function_names[2] = { "sigmoid", "sigmoid" };
+    neural_network_t *nn_initial = neural_network_create(HOGWILD_INPUT_SIZE, HOGWILD_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_t *nn = neural_network_create(HOGWILD_INPUT_SIZE, HOGWILD_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_layers_randomize(nn_initial);
+
+    // Every run starts from the same weights.
+    hogwild_run_t runs[7] = {
+        { HOGWILD_MODE_SINGLE, 1 },
+        { HOGWILD_MODE_HOGWILD, 1 }, { HOGWILD_MODE_HOGWILD, 2 }, { HOGWILD_MODE_HOGWILD, 4 },
+        { HOGWILD_MODE_DATA_PARALLEL, 1 }, { HOGWILD_MODE_DATA_PARALLEL, 2 }, { HOGWILD_MODE_DATA_PARALLEL, 4 }
+    };
+    const char *mode_names[3] = { "single", "hogwild", "data-parallel" };
+    printf("Online CPUs: %d\n", thread_pool_cpu_count());
+    printf("%-18s %6s %14s %10s\n", "Mode", "Epoch", "Train seconds", "Accuracy");
+    for (int run = 0; run < 7; run++) {
+        int n_workers = runs[run].n_workers;
+        int batch_size = HOGWILD_BATCH_SIZE;
+        if (runs[run].mode == HOGWILD_MODE_DATA_PARALLEL)
+            batch_size = (HOGWILD_DATA_PARALLEL_BATCH_SIZE + n_workers - 1) / n_workers;
+        benchmark_copy_network(nn_initial, nn);
+        neural_network_trainer_t *trainers = (neural_network_trainer_t *)malloc(n_workers * sizeof(neural_network_trainer_t));
+        for (int i = 0; i < n_workers; i++)
+            neural_network_trainer_initialize(nn, &trainers[i], batch_size);
+        thread_pool_t *pool = thread_pool_create(n_workers);
+
+        char mode[24];
+        sprintf(mode, "%s x%d", mode_names[runs[run].mode], n_workers);
+        double seconds = 0;
+        for (int epoch = 1; epoch <= HOGWILD_EPOCHS; epoch++) {
+            double start = timer_seconds();
+            hogwild_train_epoch(runs[run], trainers, &source, pool);
+            seconds += timer_seconds() - start;
+            printf("%-18s %6d %14.3f %9.2f%%\n", mode, epoch, seconds, 100 * benchmark_dataset_accuracy(nn, &dataset));
+        }
+
+        thread_pool_delete(pool);
+        for (int i = 0; i < n_workers; i++)
+            neural_network_trainer_delete(&trainers[i]);
+        free(trainers);
+    }
+
+    neural_network_delete(nn_initial);
+    neural_network_delete(nn);
+    benchmark_dataset_delete(&dataset);
+}
+
+//
+// 'benchmark_hogwild.c' implementations
+//
+
+int hogwild_next_batch(void *source_ptr, int worker, matrix_t **inputs, matrix_t **labels) {
+    (void)worker;
+    hogwild_source_t *source = (hogwild_source_t *)source_ptr;
+    int start = atomic_fetch_add(&source->next, HOGWILD_BATCH_SIZE);
+    if (start >= HOGWILD_CASES)
+        return 0;
+    *inputs = source->dataset->inputs + start;
+    *labels = source->dataset->labels + start;
+    return HOGWILD_CASES - start < HOGWILD_BATCH_SIZE ? HOGWILD_CASES - start : HOGWILD_BATCH_SIZE;
+}
+
+void hogwild_train_epoch(hogwild_run_t run, neural_network_trainer_t *trainers, hogwild_source_t *source, thread_pool_t *pool) {
+    benchmark_dataset_t *dataset = source->dataset;
+    switch (run.mode) {
+        case HOGWILD_MODE_SINGLE: {
+            for (int i = 0; i < HOGWILD_CASES; i += HOGWILD_BATCH_SIZE)
+                neural_network_trainer_train_batch(trainers, dataset->inputs + i, dataset->labels + i, HOGWILD_BATCH_SIZE, HOGWILD_PARAMETER);
+            return;
+        }
+        case HOGWILD_MODE_HOGWILD: {
+            atomic_store(&source->next, 0);
+            neural_network_train_hogwild(trainers, run.n_workers, hogwild_next_batch, source, HOGWILD_PARAMETER, pool);
+            return;
+        }
+        case HOGWILD_MODE_DATA_PARALLEL: {
+            for (int i = 0; i < HOGWILD_CASES; i += HOGWILD_DATA_PARALLEL_BATCH_SIZE)
+                neural_network_train_data_parallel(trainers, run.n_workers, dataset->inputs + i, dataset->labels + i, HOGWILD_DATA_PARALLEL_BATCH_SIZE, HOGWILD_DATA_PARALLEL_PARAMETER, pool);
+            return;
+        }
+    }
+}
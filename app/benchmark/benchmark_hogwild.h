@@ -0,0 +1,9 @@
+//
+// 'benchmark_hogwild.h' definitions
+//
+
+/**
+ * Train an MNIST sized network on a synthetic classification dataset, on a single thread, with Hogwild workers and with synchronous
+ * data-parallel workers, reporting the accuracy reached against the wall clock time spent training.
+*/
+void benchmark_hogwild();
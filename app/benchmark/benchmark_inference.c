@@ -0,0 +1,135 @@
+#include "benchmark.h"
+#include "benchmark_inference.h"
+#include "../../src/matrix.h"
+#include "../../src/neural_network.h"
+#include "../../src/neural_network_train.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// 'benchmark_inference.c' definitions
+//
+
+#define INFERENCE_INPUT_SIZE 784
+#define INFERENCE_OUTPUT_SIZE 10
+#define INFERENCE_MAX_BATCH 1024
+// Every timed call evaluates this many cases, in batches, so each batch size does the same work.
+#define INFERENCE_CASES 1024
+
+typedef struct {
+    neural_network_t *nn;
+    int batch_size;
+    double *input_data;
+    double *output_data;
+    matrix_t *inputs;
+    matrix_t *outputs;
+    double *workspace;
+    neural_network_evaluation_t eval;
+    neural_network_inference_ctx_t ctx;
+} inference_operands_t;
+
+void inference_network(int hidden_layer_count, int *hidden_layer_sizes, const char *label);
+void inference_case_call(void *operands);
+void inference_evaluation_call(void *operands);
+void inference_batch_call(void *operands);
+void inference_ctx_call(void *operands);
+
+//
+// 'benchmark_inference.h' implementations
+//
+
+void benchmark_inference() {
+    int mnist_app_sizes[1] = { 32 };
+    inference_network(1, mnist_app_sizes, "784-32-10");
+    int wide_sizes[2] = { 256, 128 };
+    inference_network(2, wide_sizes, "784-256-128-10");
+}
+
+//
+// 'benchmark_inference.c' implementations
+//
+
+void inference_network(int hidden_layer_count, int *hidden_layer_sizes, const char *label) {
+    char *activation_function_names[3] = { "sigmoid", "sigmoid", "sigmoid" };
+    inference_operands_t operands;
+    operands.nn = neural_network_create(INFERENCE_INPUT_SIZE, INFERENCE_OUTPUT_SIZE, hidden_layer_count, hidden_layer_sizes, activation_function_names);
+    neural_network_layers_randomize(operands.nn);
+
+    // Cases are stored a row each, viewed as a matrix per case for 'neural_network_evaluate'.
+    operands.input_data = (double *)malloc(INFERENCE_CASES * INFERENCE_INPUT_SIZE * sizeof(double));
+    operands.output_data = (double *)malloc(INFERENCE_CASES * INFERENCE_OUTPUT_SIZE * sizeof(double));
+    operands.inputs = (matrix_t *)malloc(INFERENCE_CASES * sizeof(matrix_t));
+    operands.outputs = (matrix_t *)malloc(INFERENCE_CASES * sizeof(matrix_t));
+    benchmark_fill_random(operands.input_data, INFERENCE_CASES * INFERENCE_INPUT_SIZE);
+    matrix_initialize_multiple_from_array(operands.inputs, INFERENCE_CASES, 1, INFERENCE_INPUT_SIZE, operands.input_data);
+    matrix_initialize_multiple_from_array(operands.outputs, INFERENCE_CASES, 1, INFERENCE_OUTPUT_SIZE, operands.output_data);
+    operands.workspace = (double *)malloc(neural_network_evaluate_batch_workspace_size(operands.nn, INFERENCE_MAX_BATCH) * sizeof(double));
+    neural_network_evaluation_initialize(operands.nn, &operands.eval);
+    neural_network_inference_ctx_initialize(operands.nn, &operands.ctx, INFERENCE_MAX_BATCH);
+
+    // The training evaluation does not depend on the batch size, it is timed once.
+    operands.batch_size = 1;
+    double evaluation_seconds = benchmark_repeat(inference_evaluation_call, &operands, BENCHMARK_MIN_SECONDS) / INFERENCE_CASES;
+    printf("Network %s, 'neural_network_evaluation_outputs': %.0f cases/s\n", label, 1 / evaluation_seconds);
+    printf("%-10s %16s %16s %16s\n", "Batch", "evaluate", "evaluate_batch", "inference");
+    for (int batch_size = 1; batch_size <= INFERENCE_MAX_BATCH; batch_size *= 2) {
+        operands.batch_size = batch_size;
+        double case_seconds = benchmark_repeat(inference_case_call, &operands, BENCHMARK_MIN_SECONDS) / INFERENCE_CASES;
+        double batch_seconds = benchmark_repeat(inference_batch_call, &operands, BENCHMARK_MIN_SECONDS) / INFERENCE_CASES;
+        double ctx_seconds = benchmark_repeat(inference_ctx_call, &operands, BENCHMARK_MIN_SECONDS) / INFERENCE_CASES;
+        printf("%-10d %16.0f %16.0f %16.0f\n", batch_size, 1 / case_seconds, 1 / batch_seconds, 1 / ctx_seconds);
+    }
+
+    neural_network_delete(operands.nn);
+    free(operands.input_data);
+    free(operands.output_data);
+    free(operands.inputs);
+    free(operands.outputs);
+    free(operands.workspace);
+    neural_network_evaluation_delete(operands.eval);
+    neural_network_inference_ctx_delete(&operands.ctx);
+}
+
+/**
+ * The MNIST apps' old evaluation, 'neural_network_evaluate' called on each batch of per case matrices.
+*/
+void inference_case_call(void *operands) {
+    inference_operands_t *op = (inference_operands_t *)operands;
+    for (int i = 0; i < INFERENCE_CASES; i += op->batch_size)
+        neural_network_evaluate(op->nn, op->batch_size, op->inputs + i, op->outputs + i);
+}
+
+/**
+ * The MNIST app's old accuracy pass, the training evaluation which also computes every layer's derivatives.
+*/
+void inference_evaluation_call(void *operands) {
+    inference_operands_t *op = (inference_operands_t *)operands;
+    for (int i = 0; i < INFERENCE_CASES; i++)
+        neural_network_evaluation_outputs(op->nn, op->inputs + i, op->eval);
+}
+
+void inference_batch_call(void *operands) {
+    inference_operands_t *op = (inference_operands_t *)operands;
+    for (int i = 0; i < INFERENCE_CASES; i += op->batch_size) {
+        matrix_t input_rows, output_rows;
+        int input_offset = i * INFERENCE_INPUT_SIZE;
+        int output_offset = i * INFERENCE_OUTPUT_SIZE;
+        matrix_initialize_from_array(&input_rows, INFERENCE_INPUT_SIZE, op->batch_size, op->input_data, &input_offset);
+        matrix_initialize_from_array(&output_rows, INFERENCE_OUTPUT_SIZE, op->batch_size, op->output_data, &output_offset);
+        matrix_t inputs = matrix_transpose_view(&input_rows);
+        matrix_t outputs = matrix_transpose_view(&output_rows);
+        neural_network_evaluate_batch(op->nn, &inputs, &outputs, op->workspace);
+    }
+}
+
+void inference_ctx_call(void *operands) {
+    inference_operands_t *op = (inference_operands_t *)operands;
+    for (int i = 0; i < INFERENCE_CASES; i += op->batch_size) {
+        matrix_t input_rows;
+        int input_offset = i * INFERENCE_INPUT_SIZE;
+        matrix_initialize_from_array(&input_rows, INFERENCE_INPUT_SIZE, op->batch_size, op->input_data, &input_offset);
+        matrix_t inputs = matrix_transpose_view(&input_rows);
+        neural_network_inference_evaluate(op->nn, &op->ctx, &inputs);
+    }
+}
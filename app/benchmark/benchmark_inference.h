@@ -0,0 +1,8 @@
+//
+// 'benchmark_inference.h' definitions
+//
+
+/**
+ * Time inference of MNIST sized networks on random inputs, through the training evaluation, case by case and in batches of 1 to 1024 cases, reporting cases per second.
+*/
+void benchmark_inference();
@@ -0,0 +1,91 @@
+#include "benchmark.h"
+#include "benchmark_kernels.h"
+#include "../../src/matrix_kernels.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// 'benchmark_kernels.c' definitions
+//
+
+// Small enough for both operands to stay in L1, so the kernels are compute bound.
+#define KERNELS_LENGTH 1024
+
+typedef struct {
+    const matrix_kernels_t *kernels;
+    int kernel;
+    double *a;
+    double *b;
+    // Repeatedly multiplying by random values underflows into denormals, so 'multiply' scales by ones.
+    double *ones;
+} kernels_operands_t;
+
+void kernels_call(void *operands);
+
+//
+// 'benchmark_kernels.h' implementations
+//
+
+void benchmark_kernels() {
+    const char *kernel_names[] = { "add", "subtract", "multiply", "copy", "axpy", "exp" };
+    int n_kernels = sizeof(kernel_names) / sizeof(kernel_names[0]);
+
+    double *a = (double *)malloc(KERNELS_LENGTH * sizeof(double));
+    double *b = (double *)malloc(KERNELS_LENGTH * sizeof(double));
+    benchmark_fill_random(a, KERNELS_LENGTH);
+    double *ones = (double *)malloc(KERNELS_LENGTH * sizeof(double));
+    benchmark_fill_random(b, KERNELS_LENGTH);
+    for (int i = 0; i < KERNELS_LENGTH; i++)
+        ones[i] = 1;
+
+    printf("%-10s", "Elem/ns");
+    for (int k = 0; k < n_kernels; k++)
+        printf(" %10s", kernel_names[k]);
+    printf("\n");
+    for (int isa = 0; isa < MATRIX_ISA_COUNT; isa++) {
+        const matrix_kernels_t *kernels = matrix_kernels_get((matrix_isa_t)isa);
+        if (kernels == NULL)
+            continue;
+        printf("%-10s", kernels->name);
+        for (int k = 0; k < n_kernels; k++) {
+            kernels_operands_t operands = { kernels, k, a, b, ones };
+            double seconds = benchmark_repeat(kernels_call, &operands, BENCHMARK_MIN_SECONDS / 4);
+            printf(" %10.2f", KERNELS_LENGTH / seconds * 1e-9);
+        }
+        printf("\n");
+    }
+    printf("Selected: %s\n", matrix_kernels()->name);
+
+    free(a);
+    free(b);
+    free(ones);
+}
+
+//
+// 'benchmark_kernels.c' implementations
+//
+
+void kernels_call(void *operands) {
+    kernels_operands_t *op = (kernels_operands_t *)operands;
+    switch (op->kernel) {
+        case 0:
+            op->kernels->add(op->a, op->b, KERNELS_LENGTH);
+            break;
+        case 1:
+            op->kernels->subtract(op->a, op->b, KERNELS_LENGTH);
+            break;
+        case 2:
+            op->kernels->multiply(op->a, op->ones, KERNELS_LENGTH);
+            break;
+        case 3:
+            op->kernels->copy(op->a, op->b, KERNELS_LENGTH);
+            break;
+        case 4:
+            op->kernels->axpy(op->a, 1e-9, op->b, KERNELS_LENGTH);
+            break;
+        case 5:
+            op->kernels->exp(op->a, op->b, KERNELS_LENGTH);
+            break;
+    }
+}
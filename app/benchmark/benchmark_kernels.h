@@ -0,0 +1,8 @@
+//
+// 'benchmark_kernels.h' definitions
+//
+
+/**
+ * Time every element-wise kernel for every instruction set supported by the host, reporting elements per nanosecond.
+*/
+void benchmark_kernels();
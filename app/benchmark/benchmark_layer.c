@@ -0,0 +1,157 @@
+#include "benchmark.h"
+#include "benchmark_layer.h"
+#include "../../src/matrix.h"
+#include "../../src/neural_network.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// 'benchmark_layer.c' definitions
+//
+
+typedef struct {
+    const char *name;
+    int input_size;
+    int output_size;
+    int cases;
+} layer_shape_t;
+
+// Entries mapped per call when comparing scalar and batch activation functions.
+#define ACTIVATION_LENGTH 4096
+
+typedef struct {
+    layer_t *layer;
+    matrix_t *inputs;
+    matrix_t *outputs;
+    matrix_t *derivatives;
+} layer_operands_t;
+
+void layer_separate_call(void *operands);
+void layer_separate_derivatives_call(void *operands);
+void layer_fused_call(void *operands);
+void layer_fused_derivatives_call(void *operands);
+void activation_scalar_call(void *operands);
+void activation_batch_call(void *operands);
+void activation_derivative_scalar_call(void *operands);
+void activation_derivative_output_batch_call(void *operands);
+
+//
+// 'benchmark_layer.h' implementations
+//
+
+void benchmark_layer() {
+    layer_shape_t shapes[] = {
+        { "784->32, 1 case", 784, 32, 1 },
+        { "32->10, 1 case", 32, 10, 1 },
+        { "784->32, 256 cases", 784, 32, 256 },
+        { "32->10, 256 cases", 32, 10, 256 },
+        { "512->512, 256 cases", 512, 512, 256 },
+    };
+    int n_shapes = sizeof(shapes) / sizeof(shapes[0]);
+
+    printf("%-24s %12s %12s %12s %12s\n", "Shape (cases/us)", "Separate", "Fused", "Separate+d", "Fused+d");
+    for (int i = 0; i < n_shapes; i++) {
+        layer_shape_t shape = shapes[i];
+        int hidden_layer_sizes[1] = { 1 };
+        char *activation_function_names[2] = { "sigmoid", "sigmoid" };
+        // A network with no hidden layers is a single layer.
+        neural_network_t *nn = neural_network_create(shape.input_size, shape.output_size, 0, hidden_layer_sizes, activation_function_names);
+        neural_network_layers_randomize(nn);
+        layer_operands_t operands = {
+            &nn->layers[0],
+            matrix_create(shape.cases, shape.input_size),
+            matrix_create(shape.cases, shape.output_size),
+            matrix_create(shape.cases, shape.output_size)
+        };
+        benchmark_fill_random(operands.inputs->data, shape.cases * shape.input_size);
+
+        benchmark_function_t calls[] = { layer_separate_call, layer_fused_call, layer_separate_derivatives_call, layer_fused_derivatives_call };
+        printf("%-24s", shape.name);
+        for (int j = 0; j < 4; j++)
+            printf(" %12.3f", shape.cases / benchmark_repeat(calls[j], &operands, BENCHMARK_MIN_SECONDS) * 1e-6);
+        printf("\n");
+
+        matrix_delete(operands.inputs);
+        matrix_delete(operands.outputs);
+        matrix_delete(operands.derivatives);
+        neural_network_delete(nn);
+    }
+
+    // The activation functions alone, one indirect call per entry against one call per array.
+    layer_t layer;
+    layer.activation_function = activation_function_get("sigmoid");
+    layer_operands_t operands = { &layer, matrix_create(1, ACTIVATION_LENGTH), matrix_create(1, ACTIVATION_LENGTH), matrix_create(1, ACTIVATION_LENGTH) };
+    benchmark_fill_random(operands.inputs->data, ACTIVATION_LENGTH);
+    printf("\n%-24s %12s %12s\n", "Sigmoid (entries/ns)", "Scalar", "Batch");
+    printf("%-24s %12.3f %12.3f\n", "function",
+        ACTIVATION_LENGTH / benchmark_repeat(activation_scalar_call, &operands, BENCHMARK_MIN_SECONDS) * 1e-9,
+        ACTIVATION_LENGTH / benchmark_repeat(activation_batch_call, &operands, BENCHMARK_MIN_SECONDS) * 1e-9);
+    printf("%-24s %12.3f %12.3f\n", "derivative",
+        ACTIVATION_LENGTH / benchmark_repeat(activation_derivative_scalar_call, &operands, BENCHMARK_MIN_SECONDS) * 1e-9,
+        ACTIVATION_LENGTH / benchmark_repeat(activation_derivative_output_batch_call, &operands, BENCHMARK_MIN_SECONDS) * 1e-9);
+    matrix_delete(operands.inputs);
+    matrix_delete(operands.outputs);
+    matrix_delete(operands.derivatives);
+}
+
+//
+// 'benchmark_layer.c' implementations
+//
+
+/**
+ * The layer as it was computed before the fused kernel, one pass per step.
+*/
+void layer_separate_call(void *operands) {
+    layer_operands_t *op = (layer_operands_t *)operands;
+    matrix_multiply_o(&op->layer->weights, op->inputs, op->outputs);
+    for (int j = 0; j < op->outputs->cols; j++) {
+        matrix_t column = matrix_block_view(op->outputs, j, 0, 1, op->outputs->rows);
+        matrix_add_i(&column, &op->layer->biases);
+    }
+    matrix_apply_function_i(op->outputs, op->layer->activation_function.function);
+}
+
+void layer_separate_derivatives_call(void *operands) {
+    layer_operands_t *op = (layer_operands_t *)operands;
+    matrix_multiply_o(&op->layer->weights, op->inputs, op->derivatives);
+    for (int j = 0; j < op->derivatives->cols; j++) {
+        matrix_t column = matrix_block_view(op->derivatives, j, 0, 1, op->derivatives->rows);
+        matrix_add_i(&column, &op->layer->biases);
+    }
+    matrix_apply_function_o(op->derivatives, op->layer->activation_function.function, op->outputs);
+    matrix_apply_function_i(op->derivatives, op->layer->activation_function.derivative);
+}
+
+void layer_fused_call(void *operands) {
+    layer_operands_t *op = (layer_operands_t *)operands;
+    neural_network_layer_forward(op->layer, op->inputs, op->outputs, NULL);
+}
+
+void layer_fused_derivatives_call(void *operands) {
+    layer_operands_t *op = (layer_operands_t *)operands;
+    neural_network_layer_forward(op->layer, op->inputs, op->outputs, op->derivatives);
+}
+
+void activation_scalar_call(void *operands) {
+    layer_operands_t *op = (layer_operands_t *)operands;
+    matrix_apply_function_o(op->inputs, op->layer->activation_function.function, op->outputs);
+}
+
+void activation_batch_call(void *operands) {
+    layer_operands_t *op = (layer_operands_t *)operands;
+    matrix_apply_batch_function_o(op->inputs, op->layer->activation_function.function_batch, op->outputs);
+}
+
+void activation_derivative_scalar_call(void *operands) {
+    layer_operands_t *op = (layer_operands_t *)operands;
+    matrix_apply_function_o(op->inputs, op->layer->activation_function.derivative, op->derivatives);
+}
+
+/**
+ * The derivative as training computes it, from the outputs of the function.
+*/
+void activation_derivative_output_batch_call(void *operands) {
+    layer_operands_t *op = (layer_operands_t *)operands;
+    matrix_apply_batch_function_o(op->outputs, op->layer->activation_function.derivative_output_batch, op->derivatives);
+}
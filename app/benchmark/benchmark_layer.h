@@ -0,0 +1,9 @@
+//
+// 'benchmark_layer.h' definitions
+//
+
+/**
+ * Time a sigmoid layer's forward pass as separate multiply, bias and activation passes against the fused layer kernel, with and without derivatives, reporting cases per microsecond.
+ * Then time the scalar sigmoid against its batch variant.
+*/
+void benchmark_layer();
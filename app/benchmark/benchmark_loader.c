@@ -0,0 +1,171 @@
+#include "benchmark.h"
+#include "benchmark_loader.h"
+#include "../../src/data_loader.h"
+#include "../../src/neural_network.h"
+#include "../../src/neural_network_train.h"
+#include "../../src/error.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+//
+// 'benchmark_loader.c' definitions
+//
+
+// Cases shaped like MNIST's, stored a byte per input as in its files.
+#define LOADER_INPUT_SIZE 784
+#define LOADER_HIDDEN_SIZE 64
+#define LOADER_OUTPUT_SIZE 10
+#define LOADER_CASES 8192
+#define LOADER_BATCH_SIZE 64
+#define LOADER_SLOTS 4
+#define LOADER_EPOCHS 3
+#define LOADER_PARAMETER 1.0
+// The time a read waits on its device per batch, without using the CPU, as a disk or network read does.
+#define LOADER_LATENCY_SECONDS 0.001
+
+typedef struct {
+    FILE *file;
+    int index;
+    unsigned char bytes[LOADER_BATCH_SIZE * (LOADER_INPUT_SIZE + 1)];
+} benchmark_loader_source_t;
+
+int benchmark_loader_fill(void *source_ptr, void *slot);
+double *benchmark_loader_inputs(void *slot);
+double *benchmark_loader_labels(void *slot);
+void benchmark_loader_reset(benchmark_loader_source_t *source);
+void benchmark_loader_report(const char *name, double seconds, double stall_seconds, double baseline_seconds);
+
+//
+// 'benchmark_loader.h' implementations
+//
+
+void benchmark_loader() {
+    // The dataset's inputs scaled to bytes, each case's bytes followed by its class.
+    benchmark_dataset_t dataset;
+    benchmark_dataset_create(&dataset, LOADER_CASES, LOADER_INPUT_SIZE, LOADER_OUTPUT_SIZE, 1.0);
+    benchmark_loader_source_t source;
+    source.file = tmpfile();
+    cnd_make_error(source.file == NULL, "Failed to create the loader benchmark's file.");
+    for (int i = 0; i < LOADER_CASES; i++) {
+        unsigned char case_bytes[LOADER_INPUT_SIZE + 1];
+        for (int j = 0; j < LOADER_INPUT_SIZE; j++) {
+            double x = dataset.input_data[(size_t)i * LOADER_INPUT_SIZE + j];
+            x = x < -1 ? -1 : x > 1 ? 1 : x;
+            case_bytes[j] = (unsigned char)((x + 1) * 127.5);
+        }
+        case_bytes[LOADER_INPUT_SIZE] = dataset.classes[i];
+        fwrite(case_bytes, 1, sizeof(case_bytes), source.file);
+    }
+
+    int hidden_layer_sizes[1] = { LOADER_HIDDEN_SIZE };
+    char *activation_function_names[2] = { "sigmoid", "sigmoid" };
+    neural_network_t *nn = neural_network_create(LOADER_INPUT_SIZE, LOADER_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_layers_randomize(nn);
+    neural_network_trainer_t trainer;
+    neural_network_trainer_initialize(nn, &trainer, LOADER_BATCH_SIZE);
+
+    size_t slot_size = (size_t)LOADER_BATCH_SIZE * (LOADER_INPUT_SIZE + LOADER_OUTPUT_SIZE) * sizeof(double);
+    printf("SGD, batch %d, %d epochs of %d cases, %d-%d-%d network, %.1fms latency per batch read\n", LOADER_BATCH_SIZE, LOADER_EPOCHS, LOADER_CASES, LOADER_INPUT_SIZE, LOADER_HIDDEN_SIZE, LOADER_OUTPUT_SIZE, LOADER_LATENCY_SECONDS * 1e3);
+    printf("%-12s %16s %14s %10s\n", "Loading", "Seconds/epoch", "Stall/epoch", "Speedup");
+
+    // Loading on the training thread, the whole of every load is a stall.
+    void *slot = aligned_alloc(64, (slot_size + 63) / 64 * 64);
+    matrix_t inputs[LOADER_BATCH_SIZE];
+    matrix_t labels[LOADER_BATCH_SIZE];
+    matrix_initialize_multiple_from_array(inputs, LOADER_BATCH_SIZE, 1, LOADER_INPUT_SIZE, benchmark_loader_inputs(slot));
+    matrix_initialize_multiple_from_array(labels, LOADER_BATCH_SIZE, 1, LOADER_OUTPUT_SIZE, benchmark_loader_labels(slot));
+    double stall_seconds = 0;
+    double start = timer_seconds();
+    for (int epoch = 0; epoch < LOADER_EPOCHS; epoch++) {
+        benchmark_loader_reset(&source);
+        while (1) {
+            double load_start = timer_seconds();
+            int n_cases = benchmark_loader_fill(&source, slot);
+            stall_seconds += timer_seconds() - load_start;
+            if (!n_cases)
+                break;
+            neural_network_trainer_train_batch(&trainer, inputs, labels, n_cases, LOADER_PARAMETER);
+        }
+    }
+    double synchronous_seconds = (timer_seconds() - start) / LOADER_EPOCHS;
+    benchmark_loader_report("synchronous", synchronous_seconds, stall_seconds / LOADER_EPOCHS, synchronous_seconds);
+    free(slot);
+
+    // Loading ahead on the loader's thread, only the loads training catches up with are stalls.
+    data_loader_t *loader = data_loader_create(LOADER_SLOTS, slot_size, benchmark_loader_fill, &source);
+    matrix_t slot_inputs[LOADER_SLOTS * LOADER_BATCH_SIZE];
+    matrix_t slot_labels[LOADER_SLOTS * LOADER_BATCH_SIZE];
+    for (int i = 0; i < LOADER_SLOTS; i++) {
+        matrix_initialize_multiple_from_array(slot_inputs + i*LOADER_BATCH_SIZE, LOADER_BATCH_SIZE, 1, LOADER_INPUT_SIZE, benchmark_loader_inputs(data_loader_slot(loader, i)));
+        matrix_initialize_multiple_from_array(slot_labels + i*LOADER_BATCH_SIZE, LOADER_BATCH_SIZE, 1, LOADER_OUTPUT_SIZE, benchmark_loader_labels(data_loader_slot(loader, i)));
+    }
+    start = timer_seconds();
+    for (int epoch = 0; epoch < LOADER_EPOCHS; epoch++) {
+        benchmark_loader_reset(&source);
+        data_loader_start_epoch(loader);
+        int n_cases;
+        int slot_index;
+        while ((slot_index = data_loader_acquire(loader, &n_cases)) >= 0) {
+            neural_network_trainer_train_batch(&trainer, slot_inputs + slot_index*LOADER_BATCH_SIZE, slot_labels + slot_index*LOADER_BATCH_SIZE, n_cases, LOADER_PARAMETER);
+            data_loader_release(loader, slot_index);
+        }
+    }
+    double seconds = (timer_seconds() - start) / LOADER_EPOCHS;
+    benchmark_loader_report("background", seconds, data_loader_stall_seconds(loader) / LOADER_EPOCHS, synchronous_seconds);
+    data_loader_delete(loader);
+
+    neural_network_trainer_delete(&trainer);
+    neural_network_delete(nn);
+    fclose(source.file);
+    benchmark_dataset_delete(&dataset);
+}
+
+//
+// 'benchmark_loader.c' implementations
+//
+
+/**
+ * Read the next batch's bytes, wait out the device latency, and normalize the inputs and expand the classes to one-hot labels into the slot.
+ * @param source_ptr Intended to be passed a 'benchmark_loader_source_t *'.
+*/
+int benchmark_loader_fill(void *source_ptr, void *slot) {
+    benchmark_loader_source_t *source = (benchmark_loader_source_t *)source_ptr;
+    int n_cases = LOADER_CASES - source->index < LOADER_BATCH_SIZE ? LOADER_CASES - source->index : LOADER_BATCH_SIZE;
+    if (n_cases == 0)
+        return 0;
+    size_t read = fread(source->bytes, LOADER_INPUT_SIZE + 1, n_cases, source->file);
+    cnd_make_error(read != (size_t)n_cases, "Failed to read the loader benchmark's file.");
+    source->index += n_cases;
+    struct timespec latency = { 0, (long)(LOADER_LATENCY_SECONDS * 1e9) };
+    nanosleep(&latency, NULL);
+
+    double *inputs = benchmark_loader_inputs(slot);
+    double *labels = benchmark_loader_labels(slot);
+    for (int i = 0; i < n_cases; i++) {
+        unsigned char *case_bytes = source->bytes + (size_t)i * (LOADER_INPUT_SIZE + 1);
+        for (int j = 0; j < LOADER_INPUT_SIZE; j++)
+            inputs[i*LOADER_INPUT_SIZE + j] = case_bytes[j] / 255.0;
+        for (int j = 0; j < LOADER_OUTPUT_SIZE; j++)
+            labels[i*LOADER_OUTPUT_SIZE + j] = j == case_bytes[LOADER_INPUT_SIZE];
+    }
+    return n_cases;
+}
+
+double *benchmark_loader_inputs(void *slot) {
+    return (double *)slot;
+}
+
+double *benchmark_loader_labels(void *slot) {
+    return (double *)slot + LOADER_BATCH_SIZE * LOADER_INPUT_SIZE;
+}
+
+void benchmark_loader_reset(benchmark_loader_source_t *source) {
+    source->index = 0;
+    fseek(source->file, 0, SEEK_SET);
+}
+
+void benchmark_loader_report(const char *name, double seconds, double stall_seconds, double baseline_seconds) {
+    printf("%-12s %16.4f %14.4f %9.2fx\n", name, seconds, stall_seconds, baseline_seconds / seconds);
+}
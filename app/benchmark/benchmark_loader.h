@@ -0,0 +1,10 @@
+//
+// 'benchmark_loader.h' definitions
+//
+
+/**
+ * Train a network on batches read from a file of bytes, normalized and delayed by a simulated device latency,
+ * once loading each batch on the training thread and once through a background data loader,
+ * reporting the time per epoch and the time the training thread spent waiting on data.
+*/
+void benchmark_loader();
@@ -0,0 +1,101 @@
+#include "benchmark.h"
+#include "benchmark_loss.h"
+#include "../../src/neural_network.h"
+#include "../../src/neural_network_train.h"
+#include "../../src/loss.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// 'benchmark_loss.c' definitions
+//
+
+#define LOSS_INPUT_SIZE 64
+#define LOSS_HIDDEN_SIZE 32
+#define LOSS_OUTPUT_SIZE 10
+#define LOSS_CASES 4096
+#define LOSS_BATCH_SIZE 32
+#define LOSS_NOISE 3.0
+#define LOSS_EPOCHS 20
+#define LOSS_TARGET_ACCURACY 0.85
+
+#define LOSS_HEAD_COUNT 3
+#define LOSS_PARAMETER_COUNT 4
+
+/**
+ * An output layer and the loss it is trained on, 'by_class' training on class indices rather than one-hot labels.
+*/
+typedef struct {
+    const char *name;
+    char *activation_function;
+    loss_t loss;
+    int by_class;
+} benchmark_loss_head_t;
+
+//
+// 'benchmark_loss.h' implementations
+//
+
+void benchmark_loss() {
+    benchmark_loss_head_t heads[LOSS_HEAD_COUNT] = {
+        { "sigmoid/mse", "sigmoid", LOSS_SQUARED_ERROR, 0 },
+        { "sigmoid/ce", "sigmoid", LOSS_CROSS_ENTROPY, 0 },
+        { "softmax/ce", "softmax", LOSS_CROSS_ENTROPY, 1 }
+    };
+    // The heads' gradients differ in scale, the squared error's shrunk by the sigmoid's derivative, so each is run at several training parameters.
+    double parameters[LOSS_PARAMETER_COUNT] = { 0.25, 0.5, 1.0, 4.0 };
+
+    benchmark_dataset_t dataset;
+    benchmark_dataset_create(&dataset, LOSS_CASES, LOSS_INPUT_SIZE, LOSS_OUTPUT_SIZE, LOSS_NOISE);
+    int *classes = (int *)malloc(LOSS_CASES * sizeof(int));
+    for (int i = 0; i < LOSS_CASES; i++)
+        classes[i] = dataset.classes[i];
+    int hidden_layer_sizes[1] = { LOSS_HIDDEN_SIZE };
+    char *initial_activation_function_names[2] = { "sigmoid", "sigmoid" };
+    neural_network_t *nn_initial = neural_network_create(LOSS_INPUT_SIZE, LOSS_OUTPUT_SIZE, 1, hidden_layer_sizes, initial_activation_function_names);
+    neural_network_layers_randomize(nn_initial);
+
+    // Every head starts from the same weights.
+    printf("SGD, batch %d, at most %d epochs\n", LOSS_BATCH_SIZE, LOSS_EPOCHS);
+    printf("%-12s %10s %16s %14s %10s\n", "Head", "Parameter", "Epochs to 85%", "Train seconds", "Accuracy");
+    for (int h = 0; h < LOSS_HEAD_COUNT; h++) {
+        char *activation_function_names[2] = { "sigmoid", heads[h].activation_function };
+        neural_network_t *nn = neural_network_create(LOSS_INPUT_SIZE, LOSS_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+        neural_network_trainer_t trainer;
+        neural_network_trainer_initialize(nn, &trainer, LOSS_BATCH_SIZE);
+        neural_network_trainer_set_loss(&trainer, heads[h].loss);
+        for (int k = 0; k < LOSS_PARAMETER_COUNT; k++) {
+            benchmark_copy_network(nn_initial, nn);
+            double seconds = 0;
+            double accuracy = 0;
+            int target_epoch = 0;
+            for (int epoch = 1; epoch <= LOSS_EPOCHS; epoch++) {
+                double start = timer_seconds();
+                for (int i = 0; i < LOSS_CASES; i += LOSS_BATCH_SIZE) {
+                    int n = LOSS_CASES - i < LOSS_BATCH_SIZE ? LOSS_CASES - i : LOSS_BATCH_SIZE;
+                    if (heads[h].by_class)
+                        neural_network_trainer_train_batch_classes(&trainer, dataset.inputs + i, classes + i, n, parameters[k]);
+                    else
+                        neural_network_trainer_train_batch(&trainer, dataset.inputs + i, dataset.labels + i, n, parameters[k]);
+                }
+                seconds += timer_seconds() - start;
+                accuracy = benchmark_dataset_accuracy(nn, &dataset);
+                if (accuracy >= LOSS_TARGET_ACCURACY) {
+                    target_epoch = epoch;
+                    break;
+                }
+            }
+            if (target_epoch)
+                printf("%-12s %10g %16d %14.3f %9.1f%%\n", heads[h].name, parameters[k], target_epoch, seconds, 100 * accuracy);
+            else
+                printf("%-12s %10g %16s %14.3f %9.1f%%\n", heads[h].name, parameters[k], "-", seconds, 100 * accuracy);
+        }
+        neural_network_trainer_delete(&trainer);
+        neural_network_delete(nn);
+    }
+
+    free(classes);
+    neural_network_delete(nn_initial);
+    benchmark_dataset_delete(&dataset);
+}
@@ -0,0 +1,9 @@
+//
+// 'benchmark_loss.h' definitions
+//
+
+/**
+ * Train networks on a synthetic dataset with a sigmoid output layer on the squared error and on the cross-entropy,
+ * and with a softmax output layer on the cross-entropy by class index, reporting the epochs taken to reach a target accuracy.
+*/
+void benchmark_loss();
@@ -0,0 +1,130 @@
+#include "benchmark.h"
+#include "benchmark_mixed.h"
+#include "../../src/neural_network.h"
+#include "../../src/neural_network_f32.h"
+#include "../../src/neural_network_mixed.h"
+#include "../../src/neural_network_train.h"
+#include "../../src/neural_network_train_f32.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// 'benchmark_mixed.c' definitions
+//
+
+// A network wide enough that training is bound by its matrix multiplications.
+#define MIXED_INPUT_SIZE 256
+#define MIXED_HIDDEN_SIZE 256
+#define MIXED_OUTPUT_SIZE 10
+#define MIXED_CASES 4096
+#define MIXED_BATCH_SIZE 64
+#define MIXED_NOISE 2.0
+#define MIXED_EPOCHS 10
+#define MIXED_PARAMETER 8.0
+
+void benchmark_mixed_copy_to_f32(neural_network_t *nn, neural_network_f32_t *nn_f32);
+void benchmark_mixed_copy_from_f32(neural_network_f32_t *nn_f32, neural_network_t *nn);
+void benchmark_mixed_report(const char *name, double seconds, double accuracy, double baseline_seconds);
+
+//
+// 'benchmark_mixed.h' implementations
+//
+
+void benchmark_mixed() {
+    benchmark_dataset_t dataset;
+    benchmark_dataset_create(&dataset, MIXED_CASES, MIXED_INPUT_SIZE, MIXED_OUTPUT_SIZE, MIXED_NOISE);
+    float *input_data_f32 = (float *)malloc((size_t)MIXED_CASES * MIXED_INPUT_SIZE * sizeof(float));
+    float *label_data_f32 = (float *)malloc((size_t)MIXED_CASES * MIXED_OUTPUT_SIZE * sizeof(float));
+    matrix_f32_t *inputs_f32 = (matrix_f32_t *)malloc(MIXED_CASES * sizeof(matrix_f32_t));
+    matrix_f32_t *labels_f32 = (matrix_f32_t *)malloc(MIXED_CASES * sizeof(matrix_f32_t));
+    for (size_t i = 0; i < (size_t)MIXED_CASES * MIXED_INPUT_SIZE; i++)
+        input_data_f32[i] = (float)dataset.input_data[i];
+    for (size_t i = 0; i < (size_t)MIXED_CASES * MIXED_OUTPUT_SIZE; i++)
+        label_data_f32[i] = (float)dataset.label_data[i];
+    matrix_f32_initialize_multiple_from_array(inputs_f32, MIXED_CASES, 1, MIXED_INPUT_SIZE, input_data_f32);
+    matrix_f32_initialize_multiple_from_array(labels_f32, MIXED_CASES, 1, MIXED_OUTPUT_SIZE, label_data_f32);
+
+    int hidden_layer_sizes[1] = { MIXED_HIDDEN_SIZE };
+    char *activation_function_names[2] = { "sigmoid", "sigmoid" };
+    neural_network_t *nn_initial = neural_network_create(MIXED_INPUT_SIZE, MIXED_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_t *nn = neural_network_create(MIXED_INPUT_SIZE, MIXED_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_f32_t *nn_f32 = neural_network_f32_create(MIXED_INPUT_SIZE, MIXED_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_layers_randomize(nn_initial);
+
+    // Every precision starts from the same weights, and is scored in double precision.
+    printf("SGD at %g, batch %d, %d epochs of %d cases, %d-%d-%d network\n", MIXED_PARAMETER, MIXED_BATCH_SIZE, MIXED_EPOCHS, MIXED_CASES, MIXED_INPUT_SIZE, MIXED_HIDDEN_SIZE, MIXED_OUTPUT_SIZE);
+    printf("%-8s %16s %10s %10s\n", "Mode", "Seconds/epoch", "Speedup", "Accuracy");
+
+    benchmark_copy_network(nn_initial, nn);
+    neural_network_trainer_t trainer;
+    neural_network_trainer_initialize(nn, &trainer, MIXED_BATCH_SIZE);
+    double start = timer_seconds();
+    for (int epoch = 0; epoch < MIXED_EPOCHS; epoch++) {
+        for (int i = 0; i < MIXED_CASES; i += MIXED_BATCH_SIZE)
+            neural_network_trainer_train_batch(&trainer, dataset.inputs + i, dataset.labels + i, MIXED_BATCH_SIZE, MIXED_PARAMETER);
+    }
+    double double_seconds = (timer_seconds() - start) / MIXED_EPOCHS;
+    benchmark_mixed_report("double", double_seconds, benchmark_dataset_accuracy(nn, &dataset), double_seconds);
+    neural_network_trainer_delete(&trainer);
+
+    benchmark_mixed_copy_to_f32(nn_initial, nn_f32);
+    neural_network_trainer_f32_t trainer_f32;
+    neural_network_f32_trainer_initialize(nn_f32, &trainer_f32, MIXED_BATCH_SIZE);
+    start = timer_seconds();
+    for (int epoch = 0; epoch < MIXED_EPOCHS; epoch++) {
+        for (int i = 0; i < MIXED_CASES; i += MIXED_BATCH_SIZE)
+            neural_network_f32_trainer_train_batch(&trainer_f32, inputs_f32 + i, labels_f32 + i, MIXED_BATCH_SIZE, (float)MIXED_PARAMETER);
+    }
+    double seconds = (timer_seconds() - start) / MIXED_EPOCHS;
+    benchmark_mixed_copy_from_f32(nn_f32, nn);
+    benchmark_mixed_report("float", seconds, benchmark_dataset_accuracy(nn, &dataset), double_seconds);
+    neural_network_f32_trainer_delete(&trainer_f32);
+
+    benchmark_copy_network(nn_initial, nn);
+    neural_network_mixed_trainer_t mixed_trainer;
+    neural_network_mixed_trainer_initialize(nn, &mixed_trainer, MIXED_BATCH_SIZE);
+    start = timer_seconds();
+    for (int epoch = 0; epoch < MIXED_EPOCHS; epoch++) {
+        for (int i = 0; i < MIXED_CASES; i += MIXED_BATCH_SIZE)
+            neural_network_mixed_trainer_train_batch(&mixed_trainer, inputs_f32 + i, labels_f32 + i, MIXED_BATCH_SIZE, MIXED_PARAMETER);
+    }
+    seconds = (timer_seconds() - start) / MIXED_EPOCHS;
+    benchmark_mixed_report("mixed", seconds, benchmark_dataset_accuracy(nn, &dataset), double_seconds);
+    neural_network_mixed_trainer_delete(&mixed_trainer);
+
+    neural_network_delete(nn_initial);
+    neural_network_delete(nn);
+    neural_network_f32_delete(nn_f32);
+    free(input_data_f32);
+    free(label_data_f32);
+    free(inputs_f32);
+    free(labels_f32);
+    benchmark_dataset_delete(&dataset);
+}
+
+//
+// 'benchmark_mixed.c' implementations
+//
+
+void benchmark_mixed_copy_to_f32(neural_network_t *nn, neural_network_f32_t *nn_f32) {
+    for (int k = 0; k < nn->hidden_layer_count + 1; k++) {
+        for (int j = 0; j < nn->layers[k].weights.cols * nn->layers[k].weights.rows; j++)
+            nn_f32->layers[k].weights.data[j] = (float)nn->layers[k].weights.data[j];
+        for (int j = 0; j < nn->layers[k].biases.rows; j++)
+            nn_f32->layers[k].biases.data[j] = (float)nn->layers[k].biases.data[j];
+    }
+}
+
+void benchmark_mixed_copy_from_f32(neural_network_f32_t *nn_f32, neural_network_t *nn) {
+    for (int k = 0; k < nn->hidden_layer_count + 1; k++) {
+        for (int j = 0; j < nn->layers[k].weights.cols * nn->layers[k].weights.rows; j++)
+            nn->layers[k].weights.data[j] = nn_f32->layers[k].weights.data[j];
+        for (int j = 0; j < nn->layers[k].biases.rows; j++)
+            nn->layers[k].biases.data[j] = nn_f32->layers[k].biases.data[j];
+    }
+}
+
+void benchmark_mixed_report(const char *name, double seconds, double accuracy, double baseline_seconds) {
+    printf("%-8s %16.4f %9.2fx %9.1f%%\n", name, seconds, baseline_seconds / seconds, 100 * accuracy);
+}
@@ -0,0 +1,9 @@
+//
+// 'benchmark_mixed.h' definitions
+//
+
+/**
+ * Train a network on a synthetic dataset in double precision, in single precision and with mixed precision,
+ * reporting the training time per epoch and the final accuracy of each.
+*/
+void benchmark_mixed();
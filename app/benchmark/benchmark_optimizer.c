@@ -0,0 +1,201 @@
+#include "benchmark.h"
+#include "benchmark_optimizer.h"
+#include "../../src/matrix_kernels.h"
+#include "../../src/neural_network.h"
+#include "../../src/neural_network_train.h"
+#include "../../src/optimizer.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// 'benchmark_optimizer.c' definitions
+//
+
+// Large enough that the parameters, gradient and state spill out of cache, so the updates are bound by memory traffic.
+#define OPTIMIZER_PARAMETERS (1 << 20)
+
+#define OPTIMIZER_INPUT_SIZE 64
+#define OPTIMIZER_HIDDEN_SIZE 32
+#define OPTIMIZER_OUTPUT_SIZE 10
+#define OPTIMIZER_CASES 4096
+#define OPTIMIZER_BATCH_SIZE 32
+#define OPTIMIZER_NOISE 2.0
+#define OPTIMIZER_TARGET_ACCURACY 0.9
+#define OPTIMIZER_MAX_EPOCHS 50
+
+#define OPTIMIZER_COUNT 5
+
+typedef struct {
+    const matrix_kernels_t *kernels;
+    optimizer_config_t config;
+    double *w;
+    double *s1;
+    double *s2;
+    double *g;
+    // Scratch for the separate passes.
+    double *t;
+} optimizer_operands_t;
+
+void optimizer_fused(void *operands);
+void optimizer_unfused(void *operands);
+
+//
+// 'benchmark_optimizer.h' implementations
+//
+
+void benchmark_optimizer() {
+    const char *names[OPTIMIZER_COUNT] = { "sgd", "momentum", "nesterov", "rmsprop", "adam" };
+    // Learning rates of similar step size, see 'mnist_optimizer_learning_rate'.
+    double learning_rates[OPTIMIZER_COUNT] = { 0.5, 0.05, 0.05, 0.005, 0.005 };
+
+    double *arrays[5];
+    for (int i = 0; i < 5; i++) {
+        arrays[i] = (double *)malloc(OPTIMIZER_PARAMETERS * sizeof(double));
+        benchmark_fill_random(arrays[i], OPTIMIZER_PARAMETERS);
+    }
+    // Mean squares are positive.
+    for (int i = 0; i < OPTIMIZER_PARAMETERS; i++)
+        arrays[2][i] = fabs(arrays[2][i]);
+
+    printf("Update of %d parameters, kernels: %s\n", OPTIMIZER_PARAMETERS, matrix_kernels()->name);
+    printf("%-10s %14s %14s %10s\n", "Optimizer", "Fused par/ns", "Passes par/ns", "Speedup");
+    for (int k = 0; k < OPTIMIZER_COUNT; k++) {
+        optimizer_operands_t operands = { matrix_kernels(), optimizer_config_get(names[k]), arrays[0], arrays[1], arrays[2], arrays[3], arrays[4] };
+        double fused = benchmark_repeat(optimizer_fused, &operands, BENCHMARK_MIN_SECONDS);
+        double unfused = benchmark_repeat(optimizer_unfused, &operands, BENCHMARK_MIN_SECONDS);
+        printf("%-10s %14.3f %14.3f %9.2fx\n", names[k], OPTIMIZER_PARAMETERS / fused * 1e-9, OPTIMIZER_PARAMETERS / unfused * 1e-9, unfused / fused);
+    }
+    for (int i = 0; i < 5; i++)
+        free(arrays[i]);
+
+    benchmark_dataset_t dataset;
+    benchmark_dataset_create(&dataset, OPTIMIZER_CASES, OPTIMIZER_INPUT_SIZE, OPTIMIZER_OUTPUT_SIZE, OPTIMIZER_NOISE);
+    int hidden_layer_sizes[1] = { OPTIMIZER_HIDDEN_SIZE };
+    char *activation_function_names[2] = { "sigmoid", "sigmoid" };
+    neural_network_t *nn_initial = neural_network_create(OPTIMIZER_INPUT_SIZE, OPTIMIZER_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_t *nn = neural_network_create(OPTIMIZER_INPUT_SIZE, OPTIMIZER_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_layers_randomize(nn_initial);
+
+    // Every optimizer starts from the same weights, and is timed until the training accuracy first reaches the target.
+    printf("\nTraining to %.0f%% accuracy, batch %d\n", 100 * OPTIMIZER_TARGET_ACCURACY, OPTIMIZER_BATCH_SIZE);
+    printf("%-10s %8s %8s %14s %10s\n", "Optimizer", "Rate", "Epochs", "Train seconds", "Accuracy");
+    for (int k = 0; k < OPTIMIZER_COUNT; k++) {
+        benchmark_copy_network(nn_initial, nn);
+        neural_network_trainer_t trainer;
+        neural_network_optimizer_t optimizer;
+        neural_network_trainer_initialize(nn, &trainer, OPTIMIZER_BATCH_SIZE);
+        neural_network_optimizer_initialize(nn, &optimizer, optimizer_config_get(names[k]));
+        neural_network_trainer_set_optimizer(&trainer, &optimizer);
+
+        double seconds = 0;
+        double accuracy = 0;
+        int epoch = 0;
+        while (epoch < OPTIMIZER_MAX_EPOCHS && accuracy < OPTIMIZER_TARGET_ACCURACY) {
+            double start = timer_seconds();
+            for (int i = 0; i < OPTIMIZER_CASES; i += OPTIMIZER_BATCH_SIZE) {
+                int n = OPTIMIZER_CASES - i < OPTIMIZER_BATCH_SIZE ? OPTIMIZER_CASES - i : OPTIMIZER_BATCH_SIZE;
+                neural_network_trainer_train_batch(&trainer, dataset.inputs + i, dataset.labels + i, n, learning_rates[k]);
+            }
+            seconds += timer_seconds() - start;
+            accuracy = benchmark_dataset_accuracy(nn, &dataset);
+            epoch++;
+        }
+        if (accuracy >= OPTIMIZER_TARGET_ACCURACY)
+            printf("%-10s %8g %8d %14.3f %9.1f%%\n", names[k], learning_rates[k], epoch, seconds, 100 * accuracy);
+        else
+            printf("%-10s %8g %8s %14s %9.1f%%\n", names[k], learning_rates[k], "-", "-", 100 * accuracy);
+
+        neural_network_optimizer_delete(&optimizer);
+        neural_network_trainer_delete(&trainer);
+    }
+
+    neural_network_delete(nn_initial);
+    neural_network_delete(nn);
+    benchmark_dataset_delete(&dataset);
+}
+
+//
+// 'benchmark_optimizer.c' implementations
+//
+
+/**
+ * A single fused pass. The learning rate is tiny, so repeated updates leave the operands about where they started.
+*/
+void optimizer_fused(void *operands) {
+    optimizer_operands_t *op = (optimizer_operands_t *)operands;
+    optimizer_config_t *c = &op->config;
+    int n = OPTIMIZER_PARAMETERS;
+    switch (c->kind) {
+        case OPTIMIZER_SGD:
+            op->kernels->axpy(op->w, -1e-9, op->g, n);
+            break;
+        case OPTIMIZER_MOMENTUM:
+            op->kernels->momentum(op->w, op->s1, op->g, 1e-9, c->momentum, n);
+            break;
+        case OPTIMIZER_NESTEROV:
+            op->kernels->nesterov(op->w, op->s1, op->g, 1e-9, c->momentum, n);
+            break;
+        case OPTIMIZER_RMSPROP:
+            op->kernels->rmsprop(op->w, op->s2, op->g, 1e-9, c->decay, c->epsilon, n);
+            break;
+        case OPTIMIZER_ADAM:
+            op->kernels->adam(op->w, op->s1, op->s2, op->g, 1e-9, c->beta1, c->beta2, c->epsilon, n);
+            break;
+    }
+}
+
+/**
+ * The same update as a pass per step of its rule, with the vectorized element-wise kernels where there is one, as it would be written without fusion.
+*/
+void optimizer_unfused(void *operands) {
+    optimizer_operands_t *op = (optimizer_operands_t *)operands;
+    optimizer_config_t *c = &op->config;
+    const matrix_kernels_t *kernels = op->kernels;
+    int n = OPTIMIZER_PARAMETERS;
+    switch (c->kind) {
+        case OPTIMIZER_SGD:
+            kernels->copy(op->t, op->g, n);
+            for (int i = 0; i < n; i++)
+                op->t[i] *= -1e-9;
+            kernels->add(op->w, op->t, n);
+            break;
+        case OPTIMIZER_MOMENTUM:
+        case OPTIMIZER_NESTEROV:
+            for (int i = 0; i < n; i++)
+                op->s1[i] *= c->momentum;
+            kernels->add(op->s1, op->g, n);
+            if (c->kind == OPTIMIZER_NESTEROV) {
+                kernels->copy(op->t, op->g, n);
+                kernels->axpy(op->t, c->momentum, op->s1, n);
+                kernels->axpy(op->w, -1e-9, op->t, n);
+            }
+            else
+                kernels->axpy(op->w, -1e-9, op->s1, n);
+            break;
+        case OPTIMIZER_RMSPROP:
+            kernels->copy(op->t, op->g, n);
+            kernels->multiply(op->t, op->g, n);
+            for (int i = 0; i < n; i++)
+                op->s2[i] *= c->decay;
+            kernels->axpy(op->s2, 1 - c->decay, op->t, n);
+            for (int i = 0; i < n; i++)
+                op->t[i] = op->g[i] / (sqrt(op->s2[i]) + c->epsilon);
+            kernels->axpy(op->w, -1e-9, op->t, n);
+            break;
+        case OPTIMIZER_ADAM:
+            for (int i = 0; i < n; i++)
+                op->s1[i] *= c->beta1;
+            kernels->axpy(op->s1, 1 - c->beta1, op->g, n);
+            kernels->copy(op->t, op->g, n);
+            kernels->multiply(op->t, op->g, n);
+            for (int i = 0; i < n; i++)
+                op->s2[i] *= c->beta2;
+            kernels->axpy(op->s2, 1 - c->beta2, op->t, n);
+            for (int i = 0; i < n; i++)
+                op->t[i] = op->s1[i] / (sqrt(op->s2[i]) + c->epsilon);
+            kernels->axpy(op->w, -1e-9, op->t, n);
+            break;
+    }
+}
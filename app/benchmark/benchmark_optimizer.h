@@ -0,0 +1,9 @@
+//
+// 'benchmark_optimizer.h' definitions
+//
+
+/**
+ * Time each optimizer's fused update against the same update as separate passes, over about a million parameters,
+ * then time each optimizer training a network to a target accuracy on a synthetic dataset.
+*/
+void benchmark_optimizer();
@@ -0,0 +1,106 @@
+#include "benchmark.h"
+#include "benchmark_pipeline.h"
+#include "../../src/matrix.h"
+#include "../../src/neural_network.h"
+#include "../../src/neural_network_train.h"
+#include "../../src/pipeline.h"
+#include "../../src/thread_pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// 'benchmark_pipeline.c' definitions
+//
+
+#define PIPELINE_INPUT_SIZE 128
+#define PIPELINE_HIDDEN_SIZE 128
+#define PIPELINE_HIDDEN_LAYER_COUNT 5
+#define PIPELINE_OUTPUT_SIZE 10
+#define PIPELINE_CASES 2048
+#define PIPELINE_NOISE 2.0
+#define PIPELINE_BATCH_SIZE 64
+#define PIPELINE_MICRO_BATCH_SIZE 8
+#define PIPELINE_PARAMETER (0.002 * PIPELINE_BATCH_SIZE)
+
+typedef enum {
+    PIPELINE_MODE_GPIPE,
+    PIPELINE_MODE_1F1B,
+    PIPELINE_MODE_DATA_PARALLEL
+} pipeline_mode_t;
+
+typedef struct {
+    pipeline_mode_t mode;
+    int n_threads;
+} pipeline_run_t;
+
+//
+// 'benchmark_pipeline.h' implementations
+//
+
+void benchmark_pipeline() {
+    benchmark_dataset_t dataset;
+    benchmark_dataset_create(&dataset, PIPELINE_CASES, PIPELINE_INPUT_SIZE, PIPELINE_OUTPUT_SIZE, PIPELINE_NOISE);
+    int hidden_layer_sizes[PIPELINE_HIDDEN_LAYER_COUNT];
+    char *activation_function_names[PIPELINE_HIDDEN_LAYER_COUNT + 1];
+    for (int i = 0; i < PIPELINE_HIDDEN_LAYER_COUNT + 1; i++) {
+        if (i < PIPELINE_HIDDEN_LAYER_COUNT)
+            hidden_layer_sizes[i] = PIPELINE_HIDDEN_SIZE;
+        activation_function_names[i] = i < PIPELINE_HIDDEN_LAYER_COUNT ? "relu" : "sigmoid";
+    }
+    neural_network_t *nn_initial = neural_network_create(PIPELINE_INPUT_SIZE, PIPELINE_OUTPUT_SIZE, PIPELINE_HIDDEN_LAYER_COUNT, hidden_layer_sizes, activation_function_names);
+    neural_network_t *nn = neural_network_create(PIPELINE_INPUT_SIZE, PIPELINE_OUTPUT_SIZE, PIPELINE_HIDDEN_LAYER_COUNT, hidden_layer_sizes, activation_function_names);
+    neural_network_layers_randomize(nn_initial);
+
+    // Every run starts from the same weights, and trains an epoch in batches of the same size.
+    pipeline_run_t runs[9] = {
+        { PIPELINE_MODE_GPIPE, 1 }, { PIPELINE_MODE_GPIPE, 2 }, { PIPELINE_MODE_GPIPE, 4 },
+        { PIPELINE_MODE_1F1B, 1 }, { PIPELINE_MODE_1F1B, 2 }, { PIPELINE_MODE_1F1B, 4 },
+        { PIPELINE_MODE_DATA_PARALLEL, 1 }, { PIPELINE_MODE_DATA_PARALLEL, 2 }, { PIPELINE_MODE_DATA_PARALLEL, 4 }
+    };
+    const char *mode_names[3] = { "gpipe", "1f1b", "data-parallel" };
+    int n_micro_batches = PIPELINE_BATCH_SIZE / PIPELINE_MICRO_BATCH_SIZE;
+    printf("Online CPUs: %d\n", thread_pool_cpu_count());
+    printf("Layers: %d, batch: %d, micro-batch: %d\n", PIPELINE_HIDDEN_LAYER_COUNT + 1, PIPELINE_BATCH_SIZE, PIPELINE_MICRO_BATCH_SIZE);
+    // Every mode applies the same update to the same weights, only the throughput differs.
+    printf("%-18s %14s %12s %9s\n", "Mode", "Train seconds", "Cases / s", "Bubble");
+    for (int run = 0; run < 9; run++) {
+        int n_threads = runs[run].n_threads;
+        benchmark_copy_network(nn_initial, nn);
+        char mode[24];
+        sprintf(mode, "%s x%d", mode_names[runs[run].mode], n_threads);
+
+        double seconds;
+        char bubble[16] = "-";
+        if (runs[run].mode == PIPELINE_MODE_DATA_PARALLEL) {
+            neural_network_trainer_t *trainers = (neural_network_trainer_t *)malloc(n_threads * sizeof(neural_network_trainer_t));
+            for (int i = 0; i < n_threads; i++)
+                neural_network_trainer_initialize(nn, &trainers[i], (PIPELINE_BATCH_SIZE + n_threads - 1) / n_threads);
+            thread_pool_t *pool = thread_pool_create(n_threads);
+            double start = timer_seconds();
+            for (int i = 0; i < PIPELINE_CASES; i += PIPELINE_BATCH_SIZE)
+                neural_network_train_data_parallel(trainers, n_threads, dataset.inputs + i, dataset.labels + i, PIPELINE_BATCH_SIZE, PIPELINE_PARAMETER, pool);
+            seconds = timer_seconds() - start;
+            thread_pool_delete(pool);
+            for (int i = 0; i < n_threads; i++)
+                neural_network_trainer_delete(&trainers[i]);
+            free(trainers);
+        }
+        else {
+            pipeline_schedule_t schedule = runs[run].mode == PIPELINE_MODE_GPIPE ? PIPELINE_SCHEDULE_GPIPE : PIPELINE_SCHEDULE_1F1B;
+            neural_network_pipeline_t pipeline;
+            neural_network_pipeline_initialize(nn, &pipeline, n_threads, PIPELINE_MICRO_BATCH_SIZE, n_micro_batches, schedule);
+            double start = timer_seconds();
+            for (int i = 0; i < PIPELINE_CASES; i += PIPELINE_BATCH_SIZE)
+                neural_network_train_pipeline(&pipeline, dataset.inputs + i, dataset.labels + i, PIPELINE_BATCH_SIZE, PIPELINE_PARAMETER);
+            seconds = timer_seconds() - start;
+            sprintf(bubble, "%.1f%%", 100 * pipeline_bubble_fraction(pipeline.pipeline));
+            neural_network_pipeline_delete(&pipeline);
+        }
+        printf("%-18s %14.3f %12.0f %9s\n", mode, seconds, PIPELINE_CASES / seconds, bubble);
+    }
+
+    neural_network_delete(nn_initial);
+    neural_network_delete(nn);
+    benchmark_dataset_delete(&dataset);
+}
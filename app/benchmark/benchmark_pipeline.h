@@ -0,0 +1,9 @@
+//
+// 'benchmark_pipeline.h' definitions
+//
+
+/**
+ * Train a deep stack of dense layers on a synthetic classification dataset with its layers pipelined across threads, with both schedules,
+ * and with data-parallel workers, reporting the throughput of each and the pipeline's bubble, the proportion of its stages' time spent idle.
+*/
+void benchmark_pipeline();
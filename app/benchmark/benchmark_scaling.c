@@ -0,0 +1,118 @@
+#include "benchmark.h"
+#include "benchmark_scaling.h"
+#include "../../src/matrix.h"
+#include "../../src/matrix_gemm.h"
+#include "../../src/neural_network.h"
+#include "../../src/thread_pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// 'benchmark_scaling.c' definitions
+//
+
+#define SCALING_SQUARE 4096
+#define SCALING_INPUT_SIZE 784
+#define SCALING_OUTPUT_SIZE 10
+#define SCALING_BATCH 1024
+
+typedef struct {
+    matrix_t *mat_A;
+    matrix_t *mat_B;
+    matrix_t *mat_O;
+    neural_network_t *nn;
+    neural_network_inference_ctx_t ctx;
+    matrix_t inputs;
+    double *input_data;
+} scaling_operands_t;
+
+int scaling_next_threads(int threads, int max_threads);
+double scaling_time_once(benchmark_function_t function, void *operands);
+void scaling_square_call(void *operands);
+void scaling_forward_call(void *operands);
+
+//
+// 'benchmark_scaling.h' implementations
+//
+
+void benchmark_scaling() {
+    scaling_operands_t operands;
+    operands.mat_A = matrix_create(SCALING_SQUARE, SCALING_SQUARE);
+    operands.mat_B = matrix_create(SCALING_SQUARE, SCALING_SQUARE);
+    operands.mat_O = matrix_create(SCALING_SQUARE, SCALING_SQUARE);
+    benchmark_fill_random(operands.mat_A->data, SCALING_SQUARE * SCALING_SQUARE);
+    benchmark_fill_random(operands.mat_B->data, SCALING_SQUARE * SCALING_SQUARE);
+
+    // A batch of MNIST sized inputs through a network wide enough for every layer to be threaded.
+    int hidden_layer_sizes[2] = { 256, 128 };
+    char *activation_function_names[3] = { "sigmoid", "sigmoid", "sigmoid" };
+    operands.nn = neural_network_create(SCALING_INPUT_SIZE, SCALING_OUTPUT_SIZE, 2, hidden_layer_sizes, activation_function_names);
+    neural_network_layers_randomize(operands.nn);
+    neural_network_inference_ctx_initialize(operands.nn, &operands.ctx, SCALING_BATCH);
+    operands.input_data = (double *)malloc(SCALING_BATCH * SCALING_INPUT_SIZE * sizeof(double));
+    benchmark_fill_random(operands.input_data, SCALING_BATCH * SCALING_INPUT_SIZE);
+    matrix_t input_rows;
+    int offset = 0;
+    matrix_initialize_from_array(&input_rows, SCALING_INPUT_SIZE, SCALING_BATCH, operands.input_data, &offset);
+    operands.inputs = matrix_transpose_view(&input_rows);
+
+    double square_flops = 2.0 * SCALING_SQUARE * SCALING_SQUARE * SCALING_SQUARE;
+    double square_one = 0;
+    double forward_one = 0;
+    int max_threads = thread_pool_cpu_count();
+    printf("Online CPUs: %d\n", max_threads);
+    printf("%-8s %14s %9s %22s %9s\n", "Threads", "4096 GFLOP/s", "Speedup", "784-256-128-10 case/s", "Speedup");
+    for (int threads = 1; threads <= max_threads; threads = scaling_next_threads(threads, max_threads)) {
+        thread_pool_t *pool = thread_pool_create(threads);
+        matrix_gemm_set_thread_pool(pool);
+        double square_seconds = scaling_time_once(scaling_square_call, &operands);
+        double forward_seconds = benchmark_repeat(scaling_forward_call, &operands, BENCHMARK_MIN_SECONDS);
+        if (threads == 1) {
+            square_one = square_seconds;
+            forward_one = forward_seconds;
+        }
+        printf("%-8d %14.3f %8.2fx %22.0f %8.2fx\n", threads, square_flops / square_seconds * 1e-9, square_one / square_seconds, SCALING_BATCH / forward_seconds, forward_one / forward_seconds);
+        matrix_gemm_set_thread_pool(NULL);
+        thread_pool_delete(pool);
+    }
+
+    matrix_delete(operands.mat_A);
+    matrix_delete(operands.mat_B);
+    matrix_delete(operands.mat_O);
+    neural_network_inference_ctx_delete(&operands.ctx);
+    neural_network_delete(operands.nn);
+    free(operands.input_data);
+}
+
+//
+// 'benchmark_scaling.c' implementations
+//
+
+/**
+ * Double the thread count, finishing on the CPU count itself when it is not a power of two.
+*/
+int scaling_next_threads(int threads, int max_threads) {
+    if (threads == max_threads)
+        return max_threads + 1;
+    return threads * 2 < max_threads ? threads * 2 : max_threads;
+}
+
+/**
+ * Time a single call, for work too long to repeat.
+*/
+double scaling_time_once(benchmark_function_t function, void *operands) {
+    double start = timer_seconds();
+    function(operands);
+    return timer_seconds() - start;
+}
+
+void scaling_square_call(void *operands) {
+    scaling_operands_t *op = (scaling_operands_t *)operands;
+    matrix_multiply_o(op->mat_A, op->mat_B, op->mat_O);
+}
+
+void scaling_forward_call(void *operands) {
+    scaling_operands_t *op = (scaling_operands_t *)operands;
+    neural_network_inference_evaluate(op->nn, &op->ctx, &op->inputs);
+}
@@ -0,0 +1,8 @@
+//
+// 'benchmark_scaling.h' definitions
+//
+
+/**
+ * Time a 4096x4096 matrix multiplication and a batched MNIST forward pass on thread pools of 1 up to the number of online CPUs, reporting the speedup over one thread.
+*/
+void benchmark_scaling();
@@ -0,0 +1,79 @@
+#include "benchmark.h"
+#include "benchmark_schedule.h"
+#include "../../src/neural_network.h"
+#include "../../src/neural_network_train.h"
+#include "../../src/schedule.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// 'benchmark_schedule.c' definitions
+//
+
+#define SCHEDULE_INPUT_SIZE 64
+#define SCHEDULE_HIDDEN_SIZE 32
+#define SCHEDULE_OUTPUT_SIZE 10
+#define SCHEDULE_CASES 4096
+#define SCHEDULE_BATCH_SIZE 32
+#define SCHEDULE_NOISE 3.0
+// Every schedule spans this many epochs, the most any run trains for.
+#define SCHEDULE_EPOCHS 20
+#define SCHEDULE_PARAMETER 4.0
+#define SCHEDULE_TARGET_ACCURACY 0.85
+
+#define SCHEDULE_COUNT 7
+
+//
+// 'benchmark_schedule.h' implementations
+//
+
+void benchmark_schedule() {
+    const char *names[SCHEDULE_COUNT] = { "constant", "step", "exponential", "cosine", "warmup", "one-cycle", "plateau" };
+
+    benchmark_dataset_t dataset;
+    benchmark_dataset_create(&dataset, SCHEDULE_CASES, SCHEDULE_INPUT_SIZE, SCHEDULE_OUTPUT_SIZE, SCHEDULE_NOISE);
+    int hidden_layer_sizes[1] = { SCHEDULE_HIDDEN_SIZE };
+    char *activation_function_names[2] = { "sigmoid", "sigmoid" };
+    neural_network_t *nn_initial = neural_network_create(SCHEDULE_INPUT_SIZE, SCHEDULE_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_t *nn = neural_network_create(SCHEDULE_INPUT_SIZE, SCHEDULE_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_layers_randomize(nn_initial);
+    long long steps_per_epoch = (SCHEDULE_CASES + SCHEDULE_BATCH_SIZE - 1) / SCHEDULE_BATCH_SIZE;
+
+    // Every schedule starts from the same weights, at the same peak training parameter, and the plateau schedule observes each epoch's accuracy.
+    printf("SGD at %g, batch %d, schedules over %d epochs\n", SCHEDULE_PARAMETER, SCHEDULE_BATCH_SIZE, SCHEDULE_EPOCHS);
+    printf("%-12s %16s %14s %10s\n", "Schedule", "Epochs to 85%", "Train seconds", "Accuracy");
+    for (int k = 0; k < SCHEDULE_COUNT; k++) {
+        benchmark_copy_network(nn_initial, nn);
+        schedule_t schedule;
+        schedule_initialize(&schedule, names[k], SCHEDULE_EPOCHS * steps_per_epoch);
+        neural_network_trainer_t trainer;
+        neural_network_trainer_initialize(nn, &trainer, SCHEDULE_BATCH_SIZE);
+        neural_network_trainer_set_schedule(&trainer, &schedule);
+
+        double seconds = 0;
+        double accuracy = 0;
+        int target_epoch = 0;
+        for (int epoch = 1; epoch <= SCHEDULE_EPOCHS; epoch++) {
+            double start = timer_seconds();
+            for (int i = 0; i < SCHEDULE_CASES; i += SCHEDULE_BATCH_SIZE) {
+                int n = SCHEDULE_CASES - i < SCHEDULE_BATCH_SIZE ? SCHEDULE_CASES - i : SCHEDULE_BATCH_SIZE;
+                neural_network_trainer_train_batch(&trainer, dataset.inputs + i, dataset.labels + i, n, SCHEDULE_PARAMETER);
+            }
+            seconds += timer_seconds() - start;
+            accuracy = benchmark_dataset_accuracy(nn, &dataset);
+            schedule_observe(&schedule, accuracy);
+            if (!target_epoch && accuracy >= SCHEDULE_TARGET_ACCURACY)
+                target_epoch = epoch;
+        }
+        if (target_epoch)
+            printf("%-12s %16d %14.3f %9.1f%%\n", names[k], target_epoch, seconds, 100 * accuracy);
+        else
+            printf("%-12s %16s %14.3f %9.1f%%\n", names[k], "-", seconds, 100 * accuracy);
+        neural_network_trainer_delete(&trainer);
+    }
+
+    neural_network_delete(nn_initial);
+    neural_network_delete(nn);
+    benchmark_dataset_delete(&dataset);
+}
@@ -0,0 +1,8 @@
+//
+// 'benchmark_schedule.h' definitions
+//
+
+/**
+ * Train a network on a synthetic dataset with each learning rate schedule, reporting the epochs taken to reach a target accuracy.
+*/
+void benchmark_schedule();
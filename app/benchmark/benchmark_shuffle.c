@@ -0,0 +1,217 @@
+#include "benchmark.h"
+#include "benchmark_shuffle.h"
+#include "../../src/data_loader.h"
+#include "../../src/neural_network.h"
+#include "../../src/neural_network_train.h"
+#include "../../src/random.h"
+#include "../../src/error.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// 'benchmark_shuffle.c' definitions
+//
+
+#define SHUFFLE_INPUT_SIZE 256
+#define SHUFFLE_HIDDEN_SIZE 64
+#define SHUFFLE_OUTPUT_SIZE 10
+#define SHUFFLE_CASES 8192
+#define SHUFFLE_BATCH_SIZE 64
+#define SHUFFLE_SLOTS 4
+#define SHUFFLE_NOISE 1.0
+#define SHUFFLE_EPOCHS 5
+#define SHUFFLE_PARAMETER 1.0
+#define SHUFFLE_SEED 7
+
+typedef struct {
+    // The cases' inputs, a byte each, and classes, stored grouped by class.
+    const unsigned char *bytes;
+    const unsigned char *classes;
+    // The order the cases are gathered in, NULL for the stored order.
+    const int32_t *permutation;
+    int index;
+} benchmark_shuffle_source_t;
+
+typedef struct {
+    neural_network_trainer_t *trainer;
+    benchmark_shuffle_source_t *source;
+    int32_t *permutation;
+    random_state_t *state;
+    data_loader_t *loader;
+    matrix_t *inputs;
+    matrix_t *labels;
+    // The time the training thread spent gathering or waiting on batches.
+    double wait_seconds;
+} benchmark_shuffle_run_t;
+
+int benchmark_shuffle_fill(void *source_ptr, void *slot);
+double *benchmark_shuffle_inputs(void *slot);
+double *benchmark_shuffle_labels(void *slot);
+void benchmark_shuffle_epoch(benchmark_shuffle_run_t *run);
+void benchmark_shuffle_report(const char *name, double seconds, double wait_seconds, double accuracy);
+
+//
+// 'benchmark_shuffle.h' implementations
+//
+
+void benchmark_shuffle() {
+    // The dataset's inputs scaled to bytes, and its cases sorted by class, the worst order for training in the stored order.
+    benchmark_dataset_t dataset;
+    benchmark_dataset_create(&dataset, SHUFFLE_CASES, SHUFFLE_INPUT_SIZE, SHUFFLE_OUTPUT_SIZE, SHUFFLE_NOISE);
+    unsigned char *bytes = (unsigned char *)malloc((size_t)SHUFFLE_CASES * SHUFFLE_INPUT_SIZE);
+    unsigned char *classes = (unsigned char *)malloc(SHUFFLE_CASES);
+    double *sorted_input_data = (double *)malloc((size_t)SHUFFLE_CASES * SHUFFLE_INPUT_SIZE * sizeof(double));
+    int n_sorted = 0;
+    for (int class = 0; class < SHUFFLE_OUTPUT_SIZE; class++) {
+        for (int i = 0; i < SHUFFLE_CASES; i++) {
+            if (dataset.classes[i] != class)
+                continue;
+            for (int j = 0; j < SHUFFLE_INPUT_SIZE; j++) {
+                double x = (dataset.input_data[(size_t)i * SHUFFLE_INPUT_SIZE + j] + 1 + SHUFFLE_NOISE) / (2 + 2 * SHUFFLE_NOISE);
+                bytes[(size_t)n_sorted * SHUFFLE_INPUT_SIZE + j] = (unsigned char)(x * 255 + 0.5);
+            }
+            classes[n_sorted++] = class;
+        }
+    }
+    // The accuracy is measured on the cases as training sees them.
+    for (size_t i = 0; i < (size_t)SHUFFLE_CASES * SHUFFLE_INPUT_SIZE; i++)
+        sorted_input_data[i] = bytes[i] / 255.0;
+    for (int i = 0; i < SHUFFLE_CASES; i++)
+        dataset.classes[i] = classes[i];
+    free(dataset.input_data);
+    dataset.input_data = sorted_input_data;
+
+    int hidden_layer_sizes[1] = { SHUFFLE_HIDDEN_SIZE };
+    char *activation_function_names[2] = { "sigmoid", "sigmoid" };
+    neural_network_t *nn_initial = neural_network_create(SHUFFLE_INPUT_SIZE, SHUFFLE_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_t *nn = neural_network_create(SHUFFLE_INPUT_SIZE, SHUFFLE_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_layers_randomize(nn_initial);
+    neural_network_trainer_t trainer;
+    neural_network_trainer_initialize(nn, &trainer, SHUFFLE_BATCH_SIZE);
+
+    size_t slot_size = (size_t)SHUFFLE_BATCH_SIZE * (SHUFFLE_INPUT_SIZE + SHUFFLE_OUTPUT_SIZE) * sizeof(double);
+    void *slot = aligned_alloc(64, (slot_size + 63) / 64 * 64);
+    matrix_t inputs[SHUFFLE_BATCH_SIZE];
+    matrix_t labels[SHUFFLE_BATCH_SIZE];
+    matrix_initialize_multiple_from_array(inputs, SHUFFLE_BATCH_SIZE, 1, SHUFFLE_INPUT_SIZE, benchmark_shuffle_inputs(slot));
+    matrix_initialize_multiple_from_array(labels, SHUFFLE_BATCH_SIZE, 1, SHUFFLE_OUTPUT_SIZE, benchmark_shuffle_labels(slot));
+    int32_t *permutation = (int32_t *)malloc(SHUFFLE_CASES * sizeof(int32_t));
+    random_state_t state;
+    benchmark_shuffle_source_t source = { bytes, classes, NULL, 0 };
+    data_loader_t *loader = data_loader_create(SHUFFLE_SLOTS, slot_size, benchmark_shuffle_fill, &source);
+    matrix_t slot_inputs[SHUFFLE_SLOTS * SHUFFLE_BATCH_SIZE];
+    matrix_t slot_labels[SHUFFLE_SLOTS * SHUFFLE_BATCH_SIZE];
+    for (int i = 0; i < SHUFFLE_SLOTS; i++) {
+        matrix_initialize_multiple_from_array(slot_inputs + i*SHUFFLE_BATCH_SIZE, SHUFFLE_BATCH_SIZE, 1, SHUFFLE_INPUT_SIZE, benchmark_shuffle_inputs(data_loader_slot(loader, i)));
+        matrix_initialize_multiple_from_array(slot_labels + i*SHUFFLE_BATCH_SIZE, SHUFFLE_BATCH_SIZE, 1, SHUFFLE_OUTPUT_SIZE, benchmark_shuffle_labels(data_loader_slot(loader, i)));
+    }
+
+    printf("SGD at %g, batch %d, %d epochs of %d cases stored by class, %d-%d-%d network\n", SHUFFLE_PARAMETER, SHUFFLE_BATCH_SIZE, SHUFFLE_EPOCHS, SHUFFLE_CASES, SHUFFLE_INPUT_SIZE, SHUFFLE_HIDDEN_SIZE, SHUFFLE_OUTPUT_SIZE);
+    // The epoch times differ with how training fares on the order, the gather's cost is the time waited on batches.
+    printf("%-12s %16s %14s %10s\n", "Order", "Seconds/epoch", "Waiting/epoch", "Accuracy");
+    const char *names[3] = { "stored", "shuffled", "background" };
+    for (int mode = 0; mode < 3; mode++) {
+        // Every order starts from the same weights, and shuffles with the same seed.
+        benchmark_copy_network(nn_initial, nn);
+        random_state_seed(&state, SHUFFLE_SEED);
+        benchmark_shuffle_run_t run = {
+            .trainer=&trainer,
+            .source=&source,
+            .permutation=mode ? permutation : NULL,
+            .state=&state,
+            .loader=mode == 2 ? loader : NULL,
+            .inputs=mode == 2 ? slot_inputs : inputs,
+            .labels=mode == 2 ? slot_labels : labels,
+            .wait_seconds=0,
+        };
+        if (run.loader)
+            data_loader_reset_statistics(run.loader);
+        double start = timer_seconds();
+        for (int epoch = 0; epoch < SHUFFLE_EPOCHS; epoch++)
+            benchmark_shuffle_epoch(&run);
+        double seconds = (timer_seconds() - start) / SHUFFLE_EPOCHS;
+        if (run.loader)
+            run.wait_seconds = data_loader_stall_seconds(run.loader);
+        benchmark_shuffle_report(names[mode], seconds, run.wait_seconds / SHUFFLE_EPOCHS, benchmark_dataset_accuracy(nn, &dataset));
+    }
+
+    data_loader_delete(loader);
+    neural_network_trainer_delete(&trainer);
+    neural_network_delete(nn_initial);
+    neural_network_delete(nn);
+    free(slot);
+    free(permutation);
+    free(bytes);
+    free(classes);
+    benchmark_dataset_delete(&dataset);
+}
+
+//
+// 'benchmark_shuffle.c' implementations
+//
+
+/**
+ * Gather the next batch's cases by index, normalizing their inputs and expanding their classes to one-hot labels into the slot.
+ * @param source_ptr Intended to be passed a 'benchmark_shuffle_source_t *'.
+*/
+int benchmark_shuffle_fill(void *source_ptr, void *slot) {
+    benchmark_shuffle_source_t *source = (benchmark_shuffle_source_t *)source_ptr;
+    int n_cases = SHUFFLE_CASES - source->index < SHUFFLE_BATCH_SIZE ? SHUFFLE_CASES - source->index : SHUFFLE_BATCH_SIZE;
+    double *inputs = benchmark_shuffle_inputs(slot);
+    double *labels = benchmark_shuffle_labels(slot);
+    for (int i = 0; i < n_cases; i++) {
+        int32_t index = source->permutation ? source->permutation[source->index + i] : source->index + i;
+        const unsigned char *case_bytes = source->bytes + (size_t)index * SHUFFLE_INPUT_SIZE;
+        for (int j = 0; j < SHUFFLE_INPUT_SIZE; j++)
+            inputs[i*SHUFFLE_INPUT_SIZE + j] = case_bytes[j] / 255.0;
+        for (int j = 0; j < SHUFFLE_OUTPUT_SIZE; j++)
+            labels[i*SHUFFLE_OUTPUT_SIZE + j] = j == source->classes[index];
+    }
+    source->index += n_cases;
+    return n_cases;
+}
+
+double *benchmark_shuffle_inputs(void *slot) {
+    return (double *)slot;
+}
+
+double *benchmark_shuffle_labels(void *slot) {
+    return (double *)slot + SHUFFLE_BATCH_SIZE * SHUFFLE_INPUT_SIZE;
+}
+
+/**
+ * Train an epoch, shuffling first when the run has a permutation, and gathering through its loader when it has one.
+*/
+void benchmark_shuffle_epoch(benchmark_shuffle_run_t *run) {
+    run->source->index = 0;
+    run->source->permutation = run->permutation;
+    if (run->permutation) {
+        for (int32_t i = 0; i < SHUFFLE_CASES; i++)
+            run->permutation[i] = i;
+        random_state_shuffle(run->state, run->permutation, SHUFFLE_CASES);
+    }
+    int n_cases;
+    if (run->loader) {
+        data_loader_start_epoch(run->loader);
+        int slot;
+        while ((slot = data_loader_acquire(run->loader, &n_cases)) >= 0) {
+            neural_network_trainer_train_batch(run->trainer, run->inputs + slot*SHUFFLE_BATCH_SIZE, run->labels + slot*SHUFFLE_BATCH_SIZE, n_cases, SHUFFLE_PARAMETER);
+            data_loader_release(run->loader, slot);
+        }
+        return;
+    }
+    // Without a loader, the run's only slot is the buffer its inputs and labels view.
+    while (1) {
+        double start = timer_seconds();
+        n_cases = benchmark_shuffle_fill(run->source, benchmark_shuffle_inputs(run->inputs[0].data));
+        run->wait_seconds += timer_seconds() - start;
+        if (!n_cases)
+            return;
+        neural_network_trainer_train_batch(run->trainer, run->inputs, run->labels, n_cases, SHUFFLE_PARAMETER);
+    }
+}
+
+void benchmark_shuffle_report(const char *name, double seconds, double wait_seconds, double accuracy) {
+    printf("%-12s %16.4f %14.4f %9.1f%%\n", name, seconds, wait_seconds, 100 * accuracy);
+}
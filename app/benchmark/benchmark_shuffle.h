@@ -0,0 +1,10 @@
+//
+// 'benchmark_shuffle.h' definitions
+//
+
+/**
+ * Train a network on a dataset of bytes stored grouped by class, in the stored order, shuffled every epoch with the batches gathered
+ * on the training thread, and shuffled with the batches gathered by a background data loader,
+ * reporting the training time per epoch, the time the training thread waited on batches, and the final accuracy of each.
+*/
+void benchmark_shuffle();
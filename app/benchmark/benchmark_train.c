@@ -0,0 +1,119 @@
+#include "benchmark.h"
+#include "benchmark_train.h"
+#include "../../src/matrix.h"
+#include "../../src/neural_network.h"
+#include "../../src/neural_network_train.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// 'benchmark_train.c' definitions
+//
+
+#define TRAIN_INPUT_SIZE 784
+#define TRAIN_HIDDEN_SIZE 32
+#define TRAIN_OUTPUT_SIZE 10
+#define TRAIN_CASES 64
+#define TRAIN_PARAMETER 0.01
+#define TRAIN_BATCH_SIZE 16
+
+typedef struct {
+    neural_network_t *nn;
+    neural_network_evaluation_t eval;
+    neural_network_train_ctx_t train_ctx;
+    neural_network_trainer_t trainer;
+    matrix_t inputs[TRAIN_CASES];
+    matrix_t outputs[TRAIN_CASES];
+} train_operands_t;
+
+void train_case_call(void *operands);
+void train_evaluation_call(void *operands);
+void train_batch_call(void *operands);
+void trainer_case_call(void *operands);
+void trainer_batch_call(void *operands);
+
+//
+// 'benchmark_train.h' implementations
+//
+
+void benchmark_train() {
+    int hidden_layer_sizes[1] = { TRAIN_HIDDEN_SIZE };
+    char *activation_function_names[2] = { "sigmoid", "sigmoid" };
+    train_operands_t operands;
+    operands.nn = neural_network_create(TRAIN_INPUT_SIZE, TRAIN_OUTPUT_SIZE, 1, hidden_layer_sizes, activation_function_names);
+    neural_network_layers_randomize(operands.nn);
+    neural_network_evaluation_initialize(operands.nn, &operands.eval);
+    neural_network_train_ctx_initialize(operands.nn, &operands.train_ctx, TRAIN_BATCH_SIZE);
+    neural_network_trainer_initialize(operands.nn, &operands.trainer, TRAIN_BATCH_SIZE);
+
+    double *input_data = (double *)malloc(TRAIN_CASES * TRAIN_INPUT_SIZE * sizeof(double));
+    double *output_data = (double *)calloc(TRAIN_CASES * TRAIN_OUTPUT_SIZE, sizeof(double));
+    benchmark_fill_random(input_data, TRAIN_CASES * TRAIN_INPUT_SIZE);
+    for (int i = 0; i < TRAIN_CASES; i++)
+        output_data[i * TRAIN_OUTPUT_SIZE + i % TRAIN_OUTPUT_SIZE] = 1;
+    matrix_initialize_multiple_from_array(operands.inputs, TRAIN_CASES, 1, TRAIN_INPUT_SIZE, input_data);
+    matrix_initialize_multiple_from_array(operands.outputs, TRAIN_CASES, 1, TRAIN_OUTPUT_SIZE, output_data);
+
+    double case_seconds = benchmark_repeat(train_case_call, &operands, BENCHMARK_MIN_SECONDS) / TRAIN_CASES;
+    double evaluation_seconds = benchmark_repeat(train_evaluation_call, &operands, BENCHMARK_MIN_SECONDS) / TRAIN_CASES;
+    double batch_seconds = benchmark_repeat(train_batch_call, &operands, BENCHMARK_MIN_SECONDS) / TRAIN_CASES;
+    double trainer_case_seconds = benchmark_repeat(trainer_case_call, &operands, BENCHMARK_MIN_SECONDS) / TRAIN_CASES;
+    double trainer_batch_seconds = benchmark_repeat(trainer_batch_call, &operands, BENCHMARK_MIN_SECONDS) / TRAIN_CASES;
+    printf("%-36s %14s\n", "Path", "Cases/s");
+    printf("%-36s %14.0f\n", "neural_network_train_case", 1 / case_seconds);
+    printf("%-36s %14.0f\n", "evaluation outputs/errors/apply", 1 / evaluation_seconds);
+    printf("%-36s %14.0f\n", "neural_network_train_batch (16)", 1 / batch_seconds);
+    printf("%-36s %14.0f\n", "trainer_train_case", 1 / trainer_case_seconds);
+    printf("%-36s %14.0f\n", "trainer_train_batch (16)", 1 / trainer_batch_seconds);
+
+    neural_network_evaluation_delete(operands.eval);
+    neural_network_train_ctx_delete(&operands.train_ctx);
+    neural_network_trainer_delete(&operands.trainer);
+    neural_network_delete(operands.nn);
+    free(input_data);
+    free(output_data);
+}
+
+//
+// 'benchmark_train.c' implementations
+//
+
+void train_case_call(void *operands) {
+    train_operands_t *op = (train_operands_t *)operands;
+    for (int i = 0; i < TRAIN_CASES; i++)
+        neural_network_train_case(op->nn, op->inputs + i, op->outputs + i, TRAIN_PARAMETER);
+}
+
+/**
+ * The training loop of the MNIST app, which reuses one evaluation struct between cases.
+*/
+void train_evaluation_call(void *operands) {
+    train_operands_t *op = (train_operands_t *)operands;
+    for (int i = 0; i < TRAIN_CASES; i++) {
+        neural_network_evaluation_outputs(op->nn, op->inputs + i, op->eval);
+        neural_network_evaluation_errors(op->nn, op->outputs + i, op->eval);
+        neural_network_evaluation_apply(op->nn, op->inputs + i, op->eval, TRAIN_PARAMETER);
+    }
+}
+
+/**
+ * The training loop of the MNIST apps, which updates the network once per batch.
+*/
+void train_batch_call(void *operands) {
+    train_operands_t *op = (train_operands_t *)operands;
+    for (int i = 0; i < TRAIN_CASES; i += TRAIN_BATCH_SIZE)
+        neural_network_train_batch(op->nn, op->inputs + i, op->outputs + i, TRAIN_BATCH_SIZE, TRAIN_PARAMETER * TRAIN_BATCH_SIZE, &op->train_ctx);
+}
+
+void trainer_case_call(void *operands) {
+    train_operands_t *op = (train_operands_t *)operands;
+    for (int i = 0; i < TRAIN_CASES; i++)
+        neural_network_trainer_train_case(&op->trainer, op->inputs + i, op->outputs + i, TRAIN_PARAMETER);
+}
+
+void trainer_batch_call(void *operands) {
+    train_operands_t *op = (train_operands_t *)operands;
+    for (int i = 0; i < TRAIN_CASES; i += TRAIN_BATCH_SIZE)
+        neural_network_trainer_train_batch(&op->trainer, op->inputs + i, op->outputs + i, TRAIN_BATCH_SIZE, TRAIN_PARAMETER * TRAIN_BATCH_SIZE);
+}
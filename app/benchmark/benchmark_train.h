@@ -0,0 +1,8 @@
+//
+// 'benchmark_train.h' definitions
+//
+
+/**
+ * Time single case training of an MNIST sized network, 784-32-10 with sigmoid layers, on random inputs, reporting cases per second.
+*/
+void benchmark_train();
@@ -0,0 +1,68 @@
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "benchmark_cache.h"
+#include "benchmark_distributed.h"
+#include "benchmark_gemm.h"
+#include "benchmark_hogwild.h"
+#include "benchmark_inference.h"
+#include "benchmark_kernels.h"
+#include "benchmark_layer.h"
+#include "benchmark_loader.h"
+#include "benchmark_loss.h"
+#include "benchmark_mixed.h"
+#include "benchmark_optimizer.h"
+#include "benchmark_pipeline.h"
+#include "benchmark_scaling.h"
+#include "benchmark_schedule.h"
+#include "benchmark_shuffle.h"
+#include "benchmark_train.h"
+#include "../../src/random.h"
+
+typedef struct {
+    const char *name;
+    void (*run)();
+} benchmark_entry_t;
+
+int main(int argc, char *argv[]) {
+    benchmark_entry_t benchmarks[] = {
+        { "cache", benchmark_cache },
+        { "distributed", benchmark_distributed },
+        { "gemm", benchmark_gemm },
+        { "hogwild", benchmark_hogwild },
+        { "inference", benchmark_inference },
+        { "kernels", benchmark_kernels },
+        { "layer", benchmark_layer },
+        { "loader", benchmark_loader },
+        { "loss", benchmark_loss },
+        { "mixed", benchmark_mixed },
+        { "optimizer", benchmark_optimizer },
+        { "pipeline", benchmark_pipeline },
+        { "scaling", benchmark_scaling },
+        { "schedule", benchmark_schedule },
+        { "shuffle", benchmark_shuffle },
+        { "train", benchmark_train },
+    };
+    int n_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    if (argc > 1 && (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0)) {
+        printf("Usage: benchmark [name ...]\nRuns every benchmark when no names are given. Available benchmarks:");
+        for (int i = 0; i < n_benchmarks; i++)
+            printf(" '%s'", benchmarks[i].name);
+        printf("\n");
+        return 0;
+    }
+
+    random_init_seeded(0);
+    for (int i = 0; i < n_benchmarks; i++) {
+        int selected = argc == 1;
+        for (int j = 1; j < argc; j++)
+            selected |= strcmp(argv[j], benchmarks[i].name) == 0;
+        if (!selected)
+            continue;
+        printf("-- %s --\n", benchmarks[i].name);
+        benchmarks[i].run();
+        printf("\n");
+    }
+    return 0;
+}
@@ -1,10 +1,12 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include "mnist.h"
 #include "mnist_train.h"
 #include "mnist_test.h"
 #include "mnist_full.h"
 #include "../../src/random.h"
+#include "../../src/schedule.h"
 #include "../../src/error.h"
 
 #define MODE_TRAIN 1
@@ -16,6 +18,14 @@ typedef struct {
     const char *model_filename;
     int epochs;
     int do_overwrite;
+    int train_mode;
+    const char *optimizer_name;
+    const char *schedule_name;
+    const char *loss_name;
+    int use_cache;
+    const char *ring_address;
+    int rank;
+    int ranks;
 } cmd_args_t;
 
 void read_args(cmd_args_t *cmd_args, int argc, char *argv[], int *argi);
@@ -24,7 +34,8 @@ int arg_matches(const char *arg, const char *arg1, const char *arg2);
 
 int main(int argc, char *argv[]) {
     cmd_args_t cmd_args = { 0 };
-    cmd_args.epochs = 1;
+    cmd_args.optimizer_name = MNIST_DEFAULT_OPTIMIZER;
+    cmd_args.loss_name = MNIST_DEFAULT_LOSS;
     int argi = 1;
     while (argi < argc) {
         read_args(&cmd_args, argc, argv, &argi);
@@ -35,7 +46,8 @@ int main(int argc, char *argv[]) {
 
     switch (cmd_args.mode) {
         case MODE_TRAIN: {
-            mnist_train(cmd_args.model_filename, cmd_args.epochs, cmd_args.do_overwrite);
+            // Mode 'train' defaults to a single epoch, with a constant learning rate.
+            mnist_train(cmd_args.model_filename, cmd_args.epochs ? cmd_args.epochs : 1, cmd_args.do_overwrite, cmd_args.optimizer_name, cmd_args.schedule_name ? cmd_args.schedule_name : "constant", cmd_args.loss_name, cmd_args.use_cache);
             return 0;
         }
         case MODE_TEST: {
@@ -44,7 +56,7 @@ int main(int argc, char *argv[]) {
             return 0;
         }
         case MODE_FULL: {
-            mnist_full();
+            mnist_full(cmd_args.train_mode, cmd_args.epochs, cmd_args.optimizer_name, cmd_args.schedule_name, cmd_args.loss_name, cmd_args.use_cache, cmd_args.ring_address, cmd_args.rank, cmd_args.ranks);
             return 0;
         }
     }
@@ -54,7 +66,7 @@ void read_args(cmd_args_t *cmd_args, int argc, char *argv[], int *argi) {
     const char *arg = argv[*argi];
     *argi += 1;
     if (arg_matches(arg, "--help", "-h")) {
-        printf("Available commands:\n--help | -h : Display all valid commands, or help information on used commands.\n--mode | -m : Always required. Set the mode to either 'train', 'test' or 'full'.\n--load-file | -l : Required for mode 'test'. Load a neural network from a dynamic model file.\n--epochs | -i : The number of times all test cases are iterated over in training. Default value is 1.\n--overwrite | -o : During training, saving the neural network after each iteration overwrites the previous save.\n");
+        printf("Available commands:\n--help | -h : Display all valid commands, or help information on used commands.\n--mode | -m : Always required. Set the mode to either 'train', 'test' or 'full'.\n--load-file | -l : Required for mode 'test'. Load a neural network from a dynamic model file.\n--epochs | -i : The number of times all test cases are iterated over in training. Default value is 1 in mode 'train', and in mode 'full' until the network stops improving.\n--overwrite | -o : During training, saving the neural network after each iteration overwrites the previous save.\n--optimizer | -z : In modes 'train' and 'full', the update rule gradients are applied with. Default value is 'sgd'.\n--schedule | -s : In modes 'train' and 'full', the learning rate schedule over the epochs. Mode 'train' defaults to a constant rate, mode 'full' to lowering the rate as accuracy rises.\n--loss | -c : In modes 'train' and 'full', the loss trained on, 'squared_error' or 'cross_entropy' with a softmax output layer. Default value is 'squared_error'.\n--cache | -k : In modes 'train' and 'full', read the images from a cache of them normalized, written beside each images file on first use and whenever it changes, rather than normalizing them every epoch.\n--hogwild | -w : In mode 'full', train with several threads updating the network's weights without locks.\n--data-parallel | -d : In mode 'full', train with several threads each computing the gradient of a share of every batch, summed in a fixed order.\n--mixed-precision | -x : In mode 'full', train on a single thread in single precision, applying the gradients to double precision weights.\n--distributed | -a : In mode 'full', train as one of a ring of processes connected at the inputted address, each training on a shard of the dataset.\n--rank | -r : With '--distributed', this process's position in the ring, from 0.\n--ranks | -n : With '--distributed', the number of processes in the ring.\n");
         exit(EXIT_SUCCESS);
         return;
     }
@@ -110,12 +122,102 @@ void read_args(cmd_args_t *cmd_args, int argc, char *argv[], int *argi) {
         cmd_args->do_overwrite = 1;
         return;
     }
+    if (arg_matches(arg, "--optimizer", "-z")) {
+        cnd_make_error(*argi == argc, "Expected another argument. Use '--optimizer --help' to find out more.\n");
+        arg = argv[*argi];
+        *argi += 1;
+        if (arg_matches(arg, "--help", "-h")) {
+            printf("Available optimizers: 'sgd', 'momentum', 'nesterov', 'rmsprop', 'adam'.\nExample usage: --mode full --optimizer adam\n");
+            exit(EXIT_SUCCESS);
+            return;
+        }
+        optimizer_config_get(arg);
+        cmd_args->optimizer_name = arg;
+        return;
+    }
+    if (arg_matches(arg, "--schedule", "-s")) {
+        cnd_make_error(*argi == argc, "Expected another argument. Use '--schedule --help' to find out more.\n");
+        arg = argv[*argi];
+        *argi += 1;
+        if (arg_matches(arg, "--help", "-h")) {
+            printf("Available schedules: 'constant', 'step', 'exponential', 'cosine', 'warmup', 'one-cycle', 'plateau'.\nThe schedule spans the number of epochs, in mode 'full' 10 unless '--epochs' is given. 'plateau' lowers the rate when an epoch's testing accuracy fails to improve, so only changes in mode 'full'.\nExample usage: --mode full --schedule one-cycle --epochs 5\n");
+            exit(EXIT_SUCCESS);
+            return;
+        }
+        schedule_t schedule;
+        schedule_initialize(&schedule, arg, 1);
+        cmd_args->schedule_name = arg;
+        return;
+    }
+    if (arg_matches(arg, "--loss", "-c")) {
+        cnd_make_error(*argi == argc, "Expected another argument. Use '--loss --help' to find out more.\n");
+        arg = argv[*argi];
+        *argi += 1;
+        if (arg_matches(arg, "--help", "-h")) {
+            printf("Available losses: 'squared_error', 'cross_entropy'.\nNew networks trained on the cross-entropy have a softmax output layer.\nExample usage: --mode full --loss cross_entropy\n");
+            exit(EXIT_SUCCESS);
+            return;
+        }
+        loss_get(arg);
+        cmd_args->loss_name = arg;
+        return;
+    }
+    if (arg_matches(arg, "--cache", "-k")) {
+        cmd_args->use_cache = 1;
+        return;
+    }
+    if (arg_matches(arg, "--hogwild", "-w")) {
+        cnd_make_error(cmd_args->train_mode, "Training mode already chosen.\n");
+        cmd_args->train_mode = MNIST_TRAIN_HOGWILD;
+        return;
+    }
+    if (arg_matches(arg, "--data-parallel", "-d")) {
+        cnd_make_error(cmd_args->train_mode, "Training mode already chosen.\n");
+        cmd_args->train_mode = MNIST_TRAIN_DATA_PARALLEL;
+        return;
+    }
+    if (arg_matches(arg, "--mixed-precision", "-x")) {
+        cnd_make_error(cmd_args->train_mode, "Training mode already chosen.\n");
+        cmd_args->train_mode = MNIST_TRAIN_MIXED;
+        return;
+    }
+    if (arg_matches(arg, "--distributed", "-a")) {
+        cnd_make_error(cmd_args->train_mode, "Training mode already chosen.\n");
+        cnd_make_error(*argi == argc, "Expected another argument. Use '--distributed --help' to find out more.\n");
+        arg = argv[*argi];
+        *argi += 1;
+        if (arg_matches(arg, "--help", "-h")) {
+            printf("The address every process of the ring is started with, 'unix:<path>' for processes on this machine or 'tcp:<host>:<port>'.\nRank r listens on '<path>.r' or on port '<port>+r'. A comma separated list of 'tcp:<host>:<port>' gives each rank's address.\nExample usage: --mode full --distributed unix:/tmp/mnist --rank 0 --ranks 4\n");
+            exit(EXIT_SUCCESS);
+            return;
+        }
+        cmd_args->train_mode = MNIST_TRAIN_DISTRIBUTED;
+        cmd_args->ring_address = arg;
+        return;
+    }
+    if (arg_matches(arg, "--rank", "-r")) {
+        cnd_make_error(*argi == argc, "Expected another argument. Use '--help' to find out more.\n");
+        cmd_args->rank = atoi(argv[*argi]);
+        *argi += 1;
+        return;
+    }
+    if (arg_matches(arg, "--ranks", "-n")) {
+        cnd_make_error(*argi == argc, "Expected another argument. Use '--help' to find out more.\n");
+        cmd_args->ranks = atoi(argv[*argi]);
+        *argi += 1;
+        cnd_make_error(cmd_args->ranks <= 0, "Inputted string for ranks is not a valid number.\n");
+        return;
+    }
     printf("Argument not recognized: '%s'.\nUse '--help' for a list of all valid arguments.\n", arg);
     exit(EXIT_FAILURE);
 }
 
 void check_args(cmd_args_t cmd_args) {
     cnd_make_error(cmd_args.mode == 0, "Mode not selected. Use '--help' to print a list of all valid arguments.\n");
+    if (cmd_args.train_mode == MNIST_TRAIN_DISTRIBUTED) {
+        cnd_make_error(cmd_args.ranks == 0, "Distributed training requires '--ranks'.\n");
+        cnd_make_error(cmd_args.rank < 0 || cmd_args.rank >= cmd_args.ranks, "The rank must be between 0 and the number of ranks.\n");
+    }
 }
 
 int arg_matches(const char *arg, const char *arg1, const char *arg2) {
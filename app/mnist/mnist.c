@@ -5,8 +5,9 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
-#include "../../src/file_load.h"
+#include "../../src/error.h"
 #include "../../src/matrix.h"
 #include "../../src/neural_network.h"
 #include "mnist.h"
@@ -15,112 +16,186 @@
 // 'mnist.c' definitions
 //
 
-#define MAGIC_NUMBER_1 2049
-#define MAGIC_NUMBER_2 2051
 #define PIXEL_MAX 255.0
-
-// magic number - 4 bytes, data count - 4 bytes
-#define FILE_LABEL_HEADER_SIZE 8
-// magic number - 4 bytes, data count - 4 bytes, image width - 4 bytes, image width - 4 bytes
-#define FILE_IMAGE_HEADER_SIZE 16
-
-int32_t flip_endianness(int32_t value);
-
-//
-// 'mnist.c' implementations
-//
-
-int32_t flip_endianness(int32_t value)
-{
-    return ((value & 0x000000FF) << 24) | ((value & 0x0000FF00) << 8) | ((value & 0x00FF0000) >> 8) | ((value & 0xFF000000) >> 24); 
-} 
+// A loaded batch starts with a pointer to its inputs, padded so the batch's own inputs start on a cache line.
+#define MNIST_BATCH_HEADER_BYTES 64
+// RMSProp and Adam step by about the learning rate whatever the size of the gradient, so need far smaller rates than SGD.
+#define ADAPTIVE_LEARNING_RATE_RATIO 0.01
 
 //
 // 'mnist.h' implementations
 //
 
-mnist_handle_t mnist_handle_init(int32_t num_cases, int batch_size, unsigned char *input_data_buffer) {
+mnist_handle_t mnist_handle_init(int32_t num_cases, int batch_size) {
     mnist_handle_t handle = { 0 };
     handle.num_cases = num_cases;
-    handle.input_data_buffer = input_data_buffer;
+    handle.shard_end = num_cases;
     handle.batch_size = batch_size;
     return handle;
 }
 
 void mnist_handle_close(mnist_handle_t *handle) {
-    fclose(handle->inputs_file);
-    fclose(handle->outputs_file);
-    handle->inputs_file = NULL;
-    handle->outputs_file = NULL;
+    idx_dataset_close(&handle->dataset);
+    if (handle->cached)
+        idx_cache_close(&handle->cache);
+    handle->cached = 0;
+    free(handle->permutation);
+    handle->permutation = NULL;
 }
 
 void mnist_images_load(const char *filename, mnist_handle_t *handle) {
-    handle->inputs_file = file_load(filename);
+    idx_file_t *images = &handle->dataset.inputs;
+    idx_file_open(images, filename);
 
     // Checks
-    {
-        int32_t file_magic_number;
-        fread(&file_magic_number, sizeof(int32_t), 1, handle->inputs_file);
-        file_magic_number = flip_endianness(file_magic_number);
-        cnd_make_error(file_magic_number != MAGIC_NUMBER_2, "Magic number does not match.\n");
-    }
-    {
-        int32_t file_num_cases;
-        fread(&file_num_cases, sizeof(int32_t), 1, handle->inputs_file);
-        file_num_cases = flip_endianness(file_num_cases);
-        cnd_make_error(file_num_cases != handle->num_cases, "Number of cases does not match.\n");
-    }
-    for (int i = 0; i < 2; i++) {
-        int32_t file_image_width;
-        fread(&file_image_width, sizeof(int32_t), 1, handle->inputs_file);
-        file_image_width = flip_endianness(file_image_width);
-        cnd_make_error(file_image_width != IMAGE_WIDTH, "File's listed image width does not match.\n");
-    }
+    cnd_make_error(images->n_dimensions != 3, "File does not list images.\n");
+    cnd_make_error(images->n_items != handle->num_cases, "Number of cases does not match.\n");
+    for (int i = 1; i < 3; i++)
+        cnd_make_error(images->dimensions[i] != IMAGE_WIDTH, "File's listed image width does not match.\n");
 }
 
 void mnist_labels_load(const char *filename, mnist_handle_t *handle) {
-    handle->outputs_file = file_load(filename);
+    idx_file_t *labels = &handle->dataset.labels;
+    idx_file_open(labels, filename);
 
     // Checks
-    {
-        int32_t file_magic_number;
-        fread(&file_magic_number, sizeof(int32_t), 1, handle->outputs_file);
-        file_magic_number = flip_endianness(file_magic_number);
-        cnd_make_error(file_magic_number != MAGIC_NUMBER_1, "Magic number does not match.\n");
-    }
-    {
-        int32_t file_num_cases;
-        fread(&file_num_cases, sizeof(int32_t), 1, handle->outputs_file);
-        file_num_cases = flip_endianness(file_num_cases);
-        cnd_make_error(file_num_cases != handle->num_cases, "Number of cases does not match.\n");
-    }
+    cnd_make_error(labels->n_dimensions != 1, "File does not list labels.\n");
+    cnd_make_error(labels->n_items != handle->num_cases, "Number of cases does not match.\n");
+}
+
+/**
+ * Map the cache of the handle's images divided by 'PIXEL_MAX', named the images file's name followed by 'MNIST_CACHE_SUFFIX',
+ * writing it first if it does not exist or its images file has changed. Batches are then viewed in the cache, or gathered from it when shuffled, rather than normalized.
+ * @param images_filename The name of the images file, already loaded with 'mnist_images_load'.
+ * @return 1 if an existing cache was mapped, 0 if the cache was written.
+*/
+int mnist_cache_load(const char *images_filename, mnist_handle_t *handle) {
+    char cache_filename[256];
+    int length = snprintf(cache_filename, sizeof(cache_filename), "%s%s", images_filename, MNIST_CACHE_SUFFIX);
+    cnd_make_error(length < 0 || length >= (int)sizeof(cache_filename), "Cache file name is too long.\n");
+    int existed = idx_cache_open(&handle->cache, images_filename, cache_filename, IDX_CACHE_F64, PIXEL_MAX);
+    cnd_make_error(handle->cache.n_items != handle->num_cases || handle->cache.item_size != INPUT_SIZE, "Cache does not match the images.\n");
+    handle->cached = 1;
+    return existed;
 }
 
 /**
  * Returns the number of cases in the loaded batch.
 */
 int mnist_load_batch(mnist_handle_t *handle, double *inputs, unsigned char *outputs) {
+    double *batch_inputs;
+    int num_cases = mnist_view_batch(handle, &batch_inputs, inputs, outputs);
+    if (batch_inputs != inputs)
+        memcpy(inputs, batch_inputs, (size_t)num_cases * INPUT_SIZE * sizeof(double));
+    return num_cases;
+}
+
+/**
+ * Load the next batch, viewing its inputs in place in the handle's cache if it is cached and loaded in order,
+ * otherwise gathering and normalizing them into the buffer.
+ * @param inputs Set to the batch's inputs, the buffer or the cache's, which are read only.
+ * @param buffer The inputs of the batch when they are not viewed in the cache, of at least the handle's batch size times 'INPUT_SIZE'.
+ * @return The number of cases in the loaded batch.
+*/
+int mnist_view_batch(mnist_handle_t *handle, double **inputs, double *buffer, unsigned char *outputs) {
+    *inputs = buffer;
     // How many cases to read.
-    int num_cases = handle->num_cases - handle->index;
+    int num_cases = handle->shard_end - handle->index;
     if (num_cases == 0)
         return 0;
     if (num_cases > handle->batch_size)
         num_cases = handle->batch_size;
+    // The cases are read straight from the files' mappings.
+    if (handle->permutation) {
+        // Shuffled cases are gathered one by one into the batch.
+        for (int i = 0; i < num_cases; i++) {
+            int32_t index = handle->permutation[handle->index + i];
+            if (handle->cached) {
+                memcpy(buffer + i*INPUT_SIZE, idx_cache_item_f64(&handle->cache, index), INPUT_SIZE * sizeof(double));
+            }
+            else {
+                const uint8_t *image = idx_file_item(&handle->dataset.inputs, index);
+                for (int j = 0; j < INPUT_SIZE; j++)
+                    buffer[i*INPUT_SIZE + j] = (double)image[j] / PIXEL_MAX;
+            }
+            outputs[i] = *idx_file_item(&handle->dataset.labels, index);
+        }
+        handle->index += num_cases;
+        return num_cases;
+    }
+    const uint8_t *images = idx_file_item(&handle->dataset.inputs, handle->index);
+    memcpy(outputs, idx_file_item(&handle->dataset.labels, handle->index), num_cases);
+    if (handle->cached) {
+        // Cases in order are contiguous in the cache, so are viewed where they are mapped.
+        *inputs = (double *)idx_cache_item_f64(&handle->cache, handle->index);
+        handle->index += num_cases;
+        return num_cases;
+    }
     handle->index += num_cases;
 
-    fread(handle->input_data_buffer, INPUT_SIZE * sizeof(unsigned char), num_cases, handle->inputs_file);
-    fread(outputs, sizeof(unsigned char), num_cases, handle->outputs_file);
-
     for (int i = 0; i < num_cases * INPUT_SIZE; i++) {
-        inputs[i] = (double)handle->input_data_buffer[i] / PIXEL_MAX;
+        buffer[i] = (double)images[i] / PIXEL_MAX;
     }
     return num_cases;
 }
 
 void mnist_reset(mnist_handle_t *handle) {
-    handle->index = 0;
-    fseek(handle->inputs_file, FILE_IMAGE_HEADER_SIZE, SEEK_SET);
-    fseek(handle->outputs_file, FILE_LABEL_HEADER_SIZE, SEEK_SET);
+    handle->index = handle->shard_start;
+}
+
+/**
+ * Load the cases of the handle's shard in a new random order from the next reset on, until the next shuffle.
+ * @param state The generator drawn from.
+*/
+void mnist_shuffle(mnist_handle_t *handle, random_state_t *state) {
+    if (!handle->permutation) {
+        handle->permutation = (int32_t *)malloc(handle->num_cases * sizeof(int32_t));
+        cnd_make_error(handle->permutation == NULL, "Failed to allocate MNIST permutation.\n");
+        // Every index is valid, even outside the shard, for copies of the handle given a wider range.
+        for (int32_t i = 0; i < handle->num_cases; i++)
+            handle->permutation[i] = i;
+    }
+    for (int32_t i = handle->shard_start; i < handle->shard_end; i++)
+        handle->permutation[i] = i;
+    random_state_shuffle(state, handle->permutation + handle->shard_start, handle->shard_end - handle->shard_start);
+}
+
+/**
+ * @return The number of bytes of a batch of the inputted number of cases loaded by 'mnist_loader_fill'.
+*/
+size_t mnist_batch_bytes(int batch_size) {
+    return MNIST_BATCH_HEADER_BYTES + (size_t)batch_size * (INPUT_SIZE * sizeof(double) + sizeof(unsigned char));
+}
+
+/**
+ * @return The batch's inputs, in the batch's buffer or viewed in its handle's cache, and only to be read.
+*/
+double *mnist_batch_inputs(void *batch) {
+    return *(double **)batch;
+}
+
+unsigned char *mnist_batch_outputs(void *batch, int batch_size) {
+    return (unsigned char *)batch + MNIST_BATCH_HEADER_BYTES + (size_t)batch_size * INPUT_SIZE * sizeof(double);
+}
+
+/**
+ * The fill function of a data loader of MNIST batches, loading the next batch of the handle into the slot, laid out as 'mnist_batch_bytes' describes.
+ * @param source_ptr Intended to be passed a 'mnist_handle_t **', the handle loaded from, which may be changed between the loader's epochs.
+*/
+int mnist_loader_fill(void *source_ptr, void *batch) {
+    mnist_handle_t *handle = *(mnist_handle_t **)source_ptr;
+    double *buffer = (double *)((unsigned char *)batch + MNIST_BATCH_HEADER_BYTES);
+    return mnist_view_batch(handle, (double **)batch, buffer, mnist_batch_outputs(batch, handle->batch_size));
+}
+
+/**
+ * Restrict the cases loaded between resets to the inputted process's contiguous share of the dataset.
+ * @param rank The process's position in its ring, from 0 to size-1.
+ * @param size The number of processes the dataset is split between.
+*/
+void mnist_set_shard(mnist_handle_t *handle, int rank, int size) {
+    handle->shard_start = (int32_t)((int64_t)handle->num_cases * rank / size);
+    handle->shard_end = (int32_t)((int64_t)handle->num_cases * (rank + 1) / size);
 }
 
 void mnist_initialize_output_data(double *data) {
@@ -134,21 +209,28 @@ void mnist_initialize_output_data(double *data) {
 }
 
 void mnist_initialize_outputs(matrix_t *outputs, double *data) {
-    for (int i = 0; i < 10; i++) {
-        outputs[i].cols = 1;
-        outputs[i].rows = 10;
-        outputs[i].data = data + 10 * i;
-    }
+    matrix_initialize_multiple_from_array(outputs, 10, 1, 10, data);
+}
+
+/**
+ * Initialize the single precision map from digit to neural network output, from its data in double precision.
+*/
+void mnist_initialize_outputs_f32(matrix_f32_t *outputs, float *data) {
+    double data_f64[OUTPUT_DATA_SIZE];
+    mnist_initialize_output_data(data_f64);
+    for (int i = 0; i < OUTPUT_DATA_SIZE; i++)
+        data[i] = (float)data_f64[i];
+    matrix_f32_initialize_multiple_from_array(outputs, 10, 1, 10, data);
 }
 
 /**
- * Find the index of the inputted array which has the highest value.
+ * Find the row of the inputted output column which has the highest value.
 */
 unsigned char mnist_output_to_number(matrix_t *output) {
     unsigned char number = 0;
-    double highest_value = output->data[0];
+    double highest_value = matrix_get(output, 0, 0);
     for (int i = 1; i < OUTPUT_SIZE; i++) {
-        double new_value = output->data[i];
+        double new_value = matrix_get(output, 0, i);
         if (new_value > highest_value) {
             highest_value = new_value;
             number = i;
@@ -156,3 +238,27 @@ unsigned char mnist_output_to_number(matrix_t *output) {
     }
     return number;
 }
+
+/**
+ * Convert a learning rate tuned for plain SGD to one of similar step size for the inputted optimizer.
+ * Momentum's velocity settles at the gradient over (1 - momentum), so its rate is scaled by (1 - momentum).
+*/
+double mnist_optimizer_learning_rate(optimizer_config_t *config, double sgd_learning_rate) {
+    switch (config->kind) {
+        case OPTIMIZER_MOMENTUM:
+        case OPTIMIZER_NESTEROV:
+            return sgd_learning_rate * (1 - config->momentum);
+        case OPTIMIZER_RMSPROP:
+        case OPTIMIZER_ADAM:
+            return sgd_learning_rate * ADAPTIVE_LEARNING_RATE_RATIO;
+        default:
+            return sgd_learning_rate;
+    }
+}
+
+/**
+ * @return The activation function of a new network's output layer when trained on the inputted loss.
+*/
+char *mnist_output_activation_function(loss_t loss) {
+    return loss == LOSS_CROSS_ENTROPY ? "softmax" : "sigmoid";
+}
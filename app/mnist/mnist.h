@@ -1,6 +1,13 @@
 #include <stdio.h>
+#include <stddef.h>
 #include <stdint.h>
+#include "../../src/idx.h"
+#include "../../src/idx_cache.h"
 #include "../../src/matrix.h"
+#include "../../src/matrix_f32.h"
+#include "../../src/loss.h"
+#include "../../src/optimizer.h"
+#include "../../src/random.h"
 
 //
 // 'mnist.h' definitions
@@ -12,27 +19,52 @@
 #define MNIST_DATASET_TRAINING_LABELS "datasets/mnist/train-labels.idx1-ubyte"
 #define MNIST_DATASET_TESTING_IMAGES "datasets/mnist/t10k-images.idx3-ubyte"
 #define MNIST_DATASET_TESTING_LABELS "datasets/mnist/t10k-labels.idx1-ubyte"
+// Appended to an images file's name for the name of its cache of normalized images.
+#define MNIST_CACHE_SUFFIX ".f64.cache"
 
 #define IMAGE_WIDTH 28
 #define INPUT_SIZE IMAGE_WIDTH * IMAGE_WIDTH
 #define OUTPUT_SIZE 10
 #define OUTPUT_DATA_SIZE OUTPUT_SIZE * OUTPUT_SIZE
+// The optimizer used when none is chosen on the command line.
+#define MNIST_DEFAULT_OPTIMIZER "sgd"
+// The loss used when none is chosen on the command line. The cross-entropy gives new networks a softmax output layer.
+#define MNIST_DEFAULT_LOSS "squared_error"
 
 typedef struct {
-    FILE *inputs_file;
-    FILE *outputs_file;
+    // The memory mapped images and labels, each image's bytes normalized as it is loaded.
+    idx_dataset_t dataset;
+    // The images normalized once, in a memory mapped cache file, once 'mnist_cache_load' is called.
+    idx_cache_t cache;
+    int cached;
     int32_t index;
     int32_t num_cases;
-    unsigned char *input_data_buffer;
+    // The range of cases loaded between resets, every case unless 'mnist_set_shard' is called.
+    int32_t shard_start;
+    int32_t shard_end;
+    // The order the cases are loaded in once 'mnist_shuffle' is called, the file's order until then.
+    int32_t *permutation;
     int batch_size;
 } mnist_handle_t;
 
-mnist_handle_t mnist_handle_init(int32_t num_cases, int batch_size, unsigned char *input_data_buffer);
+mnist_handle_t mnist_handle_init(int32_t num_cases, int batch_size);
 void mnist_handle_close(mnist_handle_t *handle);
 void mnist_images_load(const char *filename, mnist_handle_t *handle);
 void mnist_labels_load(const char *filename, mnist_handle_t *handle);
+int mnist_cache_load(const char *images_filename, mnist_handle_t *handle);
 int mnist_load_batch(mnist_handle_t *handle, double *inputs, unsigned char *outputs);
+int mnist_view_batch(mnist_handle_t *handle, double **inputs, double *buffer, unsigned char *outputs);
 void mnist_reset(mnist_handle_t *handle);
+void mnist_set_shard(mnist_handle_t *handle, int rank, int size);
+void mnist_shuffle(mnist_handle_t *handle, random_state_t *state);
+// A batch loaded by a data loader, a pointer to its normalized inputs, its own inputs unless they are viewed in the handle's cache, and its labels.
+size_t mnist_batch_bytes(int batch_size);
+double *mnist_batch_inputs(void *batch);
+unsigned char *mnist_batch_outputs(void *batch, int batch_size);
+int mnist_loader_fill(void *source_ptr, void *batch);
 void mnist_initialize_output_data(double *data);
 void mnist_initialize_outputs(matrix_t *outputs, double *data);
+void mnist_initialize_outputs_f32(matrix_f32_t *outputs, float *data);
 unsigned char mnist_output_to_number(matrix_t *output);
+double mnist_optimizer_learning_rate(optimizer_config_t *config, double sgd_learning_rate);
+char *mnist_output_activation_function(loss_t loss);
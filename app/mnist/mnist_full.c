@@ -1,15 +1,18 @@
 #include <stdio.h>
 #include <math.h>
 #include <stdlib.h>
-#include <time.h>
 
 #include "mnist.h"
 #include "mnist_full.h"
-#include "thread_wrapper.h"
 #include "../../src/neural_network.h"
 #include "../../src/neural_network_train.h"
 #include "../../src/neural_network_file.h"
+#include "../../src/neural_network_mixed.h"
+#include "../../src/data_loader.h"
 #include "../../src/error.h"
+#include "../../src/process_ring.h"
+#include "../../src/thread_pool.h"
+#include "../../src/timer.h"
 
 //
 // 'mnist_full.c' definitions
@@ -20,24 +23,51 @@
 #define NN_HIDDEN_LAYER_COUNT 1
 #define NN_HIDDEN_LAYER_SIZE_1 32
 #define NN_HIDDEN_LAYER_SIZES { NN_HIDDEN_LAYER_SIZE_1 }
-#define NN_ACTIVATION_FUNCTIONS { "sigmoid", "sigmoid" }
+#define NN_HIDDEN_ACTIVATION_FUNCTION "sigmoid"
 #define NN_LAYER_DATA_SIZE ((NN_INPUT_SIZE + 1) * NN_HIDDEN_LAYER_SIZE_1 + (NN_HIDDEN_LAYER_SIZE_1 + 1) * NN_OUTPUT_SIZE)
 
 #define BATCH_SIZE 16
-#define TRAINING_PARAMETER_INITIAL 0.01
-#define TRAINING_PARAMETER_FINAL 0.001
+// Batch updates average the gradients of their cases, so the steps are scaled by the batch size to match training case by case.
+#define TRAINING_PARAMETER_INITIAL (0.01 * BATCH_SIZE)
+#define TRAINING_PARAMETER_FINAL (0.001 * BATCH_SIZE)
+// Training stops once this many epochs in a row fail to beat the best testing accuracy, adaptive optimizers rarely improve every epoch.
+#define EPOCH_PATIENCE 3
+// The testing accuracy the training time is reported at, to compare optimizers and training modes.
+#define TARGET_ACCURACY 0.97
 
 #define N_THREADS 4
+// The number of workers of Hogwild and data-parallel training, each with its own trainer and share of the batch buffers.
+#define N_TRAIN_WORKERS N_THREADS
+// The batches the data loader loads ahead, enough for every thread to hold one while the next are loaded.
+#define N_LOADER_SLOTS (2 * N_THREADS)
 
 typedef struct {
     neural_network_t *neural_network;
     mnist_handle_t *mnist_handle;
     matrix_t *output_map;
-    mutex_wrapper_t *mutex;
+    // The background loader of batches from '*loader_handle', with each slot's inputs viewed as a matrix per case once loaded,
+    // the slot each Hogwild worker holds, -1 for none, and the cases the first worker has trained on, for its progress.
+    data_loader_t *loader;
+    mnist_handle_t **loader_handle;
+    matrix_t *slot_inputs;
+    int *worker_slots;
+    int worker_cases;
     double *inputs_data;
     matrix_t *inputs;
     unsigned char *outputs;
-    neural_network_evaluation_t *evaluations;
+    matrix_t *labels;
+    // The digits of a batch, for training on the cross-entropy by class index.
+    int *classes;
+    loss_t loss;
+    neural_network_inference_ctx_t *inference_ctxs;
+    neural_network_trainer_t *trainers;
+    // Mixed precision training's trainer, with the batch converted to single precision.
+    neural_network_mixed_trainer_t *mixed_trainer;
+    float *inputs_data_f32;
+    matrix_f32_t *inputs_f32;
+    matrix_f32_t *labels_f32;
+    matrix_f32_t *output_map_f32;
+    process_ring_t *ring;
 } storage_t;
 
 typedef struct {
@@ -47,37 +77,61 @@ typedef struct {
 } evaluation_storage_t;
 
 double training_parameter_calc(double p_high, double p_low, int cases_correct, int total_cases);
-void train_all_cases(neural_network_t *nn, mnist_handle_t *mh, storage_t storage, double training_parameter);
+int steps_per_epoch(int train_mode, int num_cases, int ranks);
+void train_all_cases(mnist_handle_t *mh, storage_t storage, double training_parameter);
+void train_all_cases_hogwild(mnist_handle_t *mh, storage_t *storage, double training_parameter);
+void train_all_cases_data_parallel(mnist_handle_t *mh, storage_t *storage, double training_parameter);
+void train_all_cases_distributed(mnist_handle_t *mh, storage_t *storage, double training_parameter);
+void train_all_cases_mixed(mnist_handle_t *mh, storage_t *storage, double training_parameter);
+void loader_start(storage_t *storage, mnist_handle_t *mh);
+/**
+ * The batch source of Hogwild training, taking the worker's next batch from the data loader and releasing its previous one.
+ * @param storage_ptr Intended to be passed a 'storage_t *'.
+ */
+int hogwild_next_batch(void *storage_ptr, int worker, matrix_t **inputs, matrix_t **labels);
 int evaluate_all_cases(storage_t storage);
 /**
+ * Run as a thread pool task.
  * @param eval_storage_ptr Intended to be passed an 'evaluation_storage_t *'.
  */
-void *evaluate_all_cases_thread(void *eval_storage_ptr);
+void evaluate_all_cases_thread(void *eval_storage_ptr);
 void log_start(const char *filename);
 void log_append(const char *filename, char *str);
-void log_append_time(const char *filename, char *string_buffer, const char *label, clock_t start, clock_t end);
+void log_append_time(const char *filename, char *string_buffer, const char *label, double start, double end);
 
 //
 // 'mnist_full.h' implementations
 //
 
-void mnist_full() {
+void mnist_full(int train_mode, int epochs, const char *optimizer_name, const char *schedule_name, const char *loss_name, int use_cache, const char *ring_address, int rank, int ranks) {
     //
     // Setup
     //
 
+    // Distributed training connects to the other processes first, and every process but the first trains silently.
+    process_ring_t *ring = NULL;
+    if (train_mode == MNIST_TRAIN_DISTRIBUTED)
+        ring = process_ring_create(ring_address, rank, ranks);
+    int is_main_process = ring == NULL || rank == 0;
+
     // For console and file logging
-    const char *log_file_name = "logs/mnist.txt";
+    const char *log_file_name = is_main_process ? "logs/mnist.txt" : NULL;
     char string_buffer[64];
 
     // Initialize the MNIST file handle
-    unsigned char input_data_unformated[INPUT_SIZE * BATCH_SIZE];
-    mnist_handle_t mnist_handle_training = mnist_handle_init(MNIST_N_CASES_TRAINING, BATCH_SIZE, input_data_unformated);
-    mnist_handle_t mnist_handle_testing = mnist_handle_init(MNIST_N_CASES_TESTING, BATCH_SIZE, input_data_unformated);
+    mnist_handle_t mnist_handle_training = mnist_handle_init(MNIST_N_CASES_TRAINING, BATCH_SIZE);
+    mnist_handle_t mnist_handle_testing = mnist_handle_init(MNIST_N_CASES_TESTING, BATCH_SIZE);
     mnist_images_load(MNIST_DATASET_TRAINING_IMAGES, &mnist_handle_training);
     mnist_labels_load(MNIST_DATASET_TRAINING_LABELS, &mnist_handle_training);
     mnist_images_load(MNIST_DATASET_TESTING_IMAGES, &mnist_handle_testing);
     mnist_labels_load(MNIST_DATASET_TESTING_LABELS, &mnist_handle_testing);
+    int cache_existed = 0;
+    if (use_cache) {
+        cache_existed = mnist_cache_load(MNIST_DATASET_TRAINING_IMAGES, &mnist_handle_training);
+        cache_existed &= mnist_cache_load(MNIST_DATASET_TESTING_IMAGES, &mnist_handle_testing);
+    }
+    if (ring)
+        mnist_set_shard(&mnist_handle_training, rank, ranks);
 
     // Storage space to send mnist_handle image data to.
     double inputs_data[INPUT_SIZE * BATCH_SIZE * N_THREADS];
@@ -90,12 +144,24 @@ void mnist_full() {
     matrix_t output_map[OUTPUT_SIZE];
     mnist_initialize_outputs(output_map, output_map_data);
 
-    // Storage space to send mnist_handle label data to.
+    // Storage space to send mnist_handle label data to, and the expected outputs of the labels.
     unsigned char outputs[BATCH_SIZE * N_THREADS];
+    matrix_t labels[BATCH_SIZE * N_THREADS];
+    int classes[BATCH_SIZE];
+    loss_t loss = loss_get(loss_name);
+
+    // Single precision copies of a batch and of the map from digit to output, for mixed precision training.
+    float inputs_data_f32[INPUT_SIZE * BATCH_SIZE];
+    matrix_f32_t inputs_f32[BATCH_SIZE];
+    matrix_f32_initialize_multiple_from_array(inputs_f32, BATCH_SIZE, 1, INPUT_SIZE, inputs_data_f32);
+    float output_map_data_f32[OUTPUT_DATA_SIZE];
+    matrix_f32_t output_map_f32[OUTPUT_SIZE];
+    mnist_initialize_outputs_f32(output_map_f32, output_map_data_f32);
+    matrix_f32_t labels_f32[BATCH_SIZE];
 
     // Set up a randomized neural network.
     int hidden_layer_sizes[NN_HIDDEN_LAYER_COUNT+1] = NN_HIDDEN_LAYER_SIZES;
-    char *activation_function_names[NN_HIDDEN_LAYER_COUNT+1] = NN_ACTIVATION_FUNCTIONS;
+    char *activation_function_names[NN_HIDDEN_LAYER_COUNT+1] = { NN_HIDDEN_ACTIVATION_FUNCTION, mnist_output_activation_function(loss) };
     layer_t neural_network_layers[NN_HIDDEN_LAYER_COUNT+1];
     double neural_network_layer_data[NN_LAYER_DATA_SIZE];
     neural_network_t neural_network = {
@@ -107,25 +173,84 @@ void mnist_full() {
     };
     neural_network_layers_from_array(&neural_network, neural_network_layer_data, activation_function_names);
     neural_network_layers_randomize(&neural_network);
+    // Every process of a ring starts from the first process's weights.
+    if (ring)
+        neural_network_distributed_broadcast(&neural_network, ring);
 
-    // Storage space to 
-    neural_network_evaluation_t evaluations[N_THREADS];
+    // Buffers for each thread's batches of inference when scoring accuracy.
+    neural_network_inference_ctx_t inference_ctxs[N_THREADS];
     for (int i = 0; i < N_THREADS; i++) {
-        neural_network_evaluation_initialize(&neural_network, &evaluations[i]);
+        neural_network_inference_ctx_initialize(&neural_network, &inference_ctxs[i], BATCH_SIZE);
+    }
+
+    // Buffers and gradients for training on a batch, allocated once for every epoch. Hogwild and data-parallel training have a trainer per worker.
+    neural_network_trainer_t trainers[N_TRAIN_WORKERS];
+    // Mixed precision training has a mixed precision trainer in their place.
+    int n_trainers = train_mode == MNIST_TRAIN_HOGWILD || train_mode == MNIST_TRAIN_DATA_PARALLEL ? N_TRAIN_WORKERS : 1;
+    if (train_mode == MNIST_TRAIN_MIXED)
+        n_trainers = 0;
+    for (int i = 0; i < n_trainers; i++) {
+        neural_network_trainer_initialize(&neural_network, &trainers[i], BATCH_SIZE);
+        neural_network_trainer_set_loss(&trainers[i], loss);
+    }
+    neural_network_mixed_trainer_t mixed_trainer;
+    if (train_mode == MNIST_TRAIN_MIXED) {
+        neural_network_mixed_trainer_initialize(&neural_network, &mixed_trainer, BATCH_SIZE);
+        neural_network_mixed_trainer_set_loss(&mixed_trainer, loss);
+    }
+
+    // A single optimizer shared by every trainer, its state updated along with the weights. Each process of a ring has its own,
+    // kept identical by applying the same summed gradients.
+    optimizer_config_t optimizer_config = optimizer_config_get(optimizer_name);
+    neural_network_optimizer_t optimizer;
+    neural_network_optimizer_initialize(&neural_network, &optimizer, optimizer_config);
+    for (int i = 0; i < n_trainers; i++) {
+        neural_network_trainer_set_optimizer(&trainers[i], &optimizer);
+    }
+    if (train_mode == MNIST_TRAIN_MIXED)
+        neural_network_mixed_trainer_set_optimizer(&mixed_trainer, &optimizer);
+
+    // A schedule shared by every trainer, moved on by every update, spanning the updates of every epoch.
+    schedule_t schedule;
+    if (schedule_name) {
+        int schedule_epochs = epochs ? epochs : MNIST_SCHEDULE_EPOCHS;
+        schedule_initialize(&schedule, schedule_name, (long long)schedule_epochs * steps_per_epoch(train_mode, mnist_handle_training.num_cases, ranks));
+        for (int i = 0; i < n_trainers; i++) {
+            neural_network_trainer_set_schedule(&trainers[i], &schedule);
+        }
+        if (train_mode == MNIST_TRAIN_MIXED)
+            neural_network_mixed_trainer_set_schedule(&mixed_trainer, &schedule);
     }
 
-    mutex_wrapper_t mutex;
-    mutex_wrapper_create(&mutex);
+    // A producer thread loads and normalizes the batches of single threaded, mixed precision and Hogwild training, and of evaluation,
+    // ahead of the threads consuming them. Data-parallel and distributed training load their own.
+    mnist_handle_t *loader_handle = NULL;
+    data_loader_t *loader = data_loader_create(N_LOADER_SLOTS, mnist_batch_bytes(BATCH_SIZE), mnist_loader_fill, &loader_handle);
+    matrix_t slot_inputs[N_LOADER_SLOTS * BATCH_SIZE];
+    int worker_slots[N_TRAIN_WORKERS];
 
     storage_t storage = {
         .neural_network=&neural_network,
         .mnist_handle=NULL,
         .output_map=output_map,
-        .mutex=&mutex,
+        .loader=loader,
+        .loader_handle=&loader_handle,
+        .slot_inputs=slot_inputs,
+        .worker_slots=worker_slots,
         .inputs_data=inputs_data,
         .inputs=inputs,
         .outputs=outputs,
-        .evaluations=evaluations
+        .labels=labels,
+        .classes=classes,
+        .loss=loss,
+        .inference_ctxs=inference_ctxs,
+        .trainers=trainers,
+        .mixed_trainer=&mixed_trainer,
+        .inputs_data_f32=inputs_data_f32,
+        .inputs_f32=inputs_f32,
+        .labels_f32=labels_f32,
+        .output_map_f32=output_map_f32,
+        .ring=ring
     };
 
     //
@@ -133,66 +258,139 @@ void mnist_full() {
     //
 
     log_start(log_file_name);
+    const char *train_mode_messages[5] = { "Training on a single thread.\n", "Training with Hogwild workers.\n", "Training with data-parallel workers.\n", "Training with distributed processes.\n", "Training on a single thread with mixed precision.\n" };
+    log_append(log_file_name, (char *)train_mode_messages[train_mode]);
+    sprintf(string_buffer, "Optimizer: %s.\n", optimizer_config.name);
+    log_append(log_file_name, string_buffer);
+    sprintf(string_buffer, "Schedule: %s.\n", schedule_name ? schedule.name : "by accuracy");
+    log_append(log_file_name, string_buffer);
+    sprintf(string_buffer, "Loss: %s.\n", loss_name);
+    log_append(log_file_name, string_buffer);
+    if (use_cache)
+        log_append(log_file_name, cache_existed ? "Mapped the normalized dataset cache.\n" : "Wrote the normalized dataset cache.\n");
 
     int best_epoch = 0;
     int max_num_correct = 0;
-    clock_t start_total = clock();
+    int reached_target = 0;
+    // The training cases are visited in a new order every epoch, drawn from a generator seeded by the shared one.
+    random_state_t shuffle_state;
+    random_state_seed(&shuffle_state, (uint64_t)rand());
+    double start_total = timer_seconds();
+    double training_seconds = 0;
     for (int i = 0; 1; i++) {
         sprintf(string_buffer, "-- Epoch %02d --\n", i);
         log_append(log_file_name, string_buffer);
 
         // Training
         storage.mnist_handle = &mnist_handle_training;
-        clock_t start_epoch = clock();
-        clock_t start = start_epoch;
+        double start_epoch = timer_seconds();
+        double start = start_epoch;
+        data_loader_reset_statistics(loader);
         if (i) {
-            double training_parameter = training_parameter_calc(TRAINING_PARAMETER_INITIAL, TRAINING_PARAMETER_FINAL, max_num_correct, mnist_handle_testing.num_cases);
-            train_all_cases(&neural_network, &mnist_handle_training, storage, training_parameter);
+            // With a schedule, the trainers scale the initial training parameter by the schedule's factor for each batch.
+            double training_parameter = TRAINING_PARAMETER_INITIAL;
+            if (!schedule_name)
+                training_parameter = training_parameter_calc(TRAINING_PARAMETER_INITIAL, TRAINING_PARAMETER_FINAL, max_num_correct, mnist_handle_testing.num_cases);
+            training_parameter = mnist_optimizer_learning_rate(&optimizer_config, training_parameter);
+            mnist_shuffle(&mnist_handle_training, &shuffle_state);
+            if (train_mode == MNIST_TRAIN_HOGWILD)
+                train_all_cases_hogwild(&mnist_handle_training, &storage, training_parameter);
+            else if (train_mode == MNIST_TRAIN_DATA_PARALLEL)
+                train_all_cases_data_parallel(&mnist_handle_training, &storage, training_parameter);
+            else if (train_mode == MNIST_TRAIN_DISTRIBUTED)
+                train_all_cases_distributed(&mnist_handle_training, &storage, training_parameter);
+            else if (train_mode == MNIST_TRAIN_MIXED)
+                train_all_cases_mixed(&mnist_handle_training, &storage, training_parameter);
+            else
+                train_all_cases(&mnist_handle_training, storage, training_parameter);
+            training_seconds += timer_seconds() - start;
             log_append(log_file_name, "Trained all cases.\n");
+            if (train_mode == MNIST_TRAIN_SINGLE || train_mode == MNIST_TRAIN_MIXED || train_mode == MNIST_TRAIN_HOGWILD) {
+                sprintf(string_buffer, "Waiting on data: %.3fs\n", data_loader_stall_seconds(loader));
+                log_append(log_file_name, string_buffer);
+            }
         }
         else {
             log_append(log_file_name, "No training.\n");
         }
-        log_append_time(log_file_name, string_buffer, "Time taken", start, clock());
-
-        // Test against training data
-        start = clock();
+        log_append_time(log_file_name, string_buffer, "Time taken", start, timer_seconds());
+
+        // Test against training data. Every process of a ring evaluates its identical network against the whole of both datasets,
+        // so they all reach the same decision to stop.
+        mnist_handle_t mnist_handle_evaluating = mnist_handle_training;
+        mnist_handle_evaluating.shard_start = 0;
+        mnist_handle_evaluating.shard_end = mnist_handle_training.num_cases;
+        // The training permutation only covers this process's shard, and the order cases are evaluated in does not matter.
+        mnist_handle_evaluating.permutation = NULL;
+        storage.mnist_handle = &mnist_handle_evaluating;
+        start = timer_seconds();
         int training_cases_correct = evaluate_all_cases(storage);
         sprintf(string_buffer, "Training dataset evaluation: %d / %d, %.01f%%\n", training_cases_correct, mnist_handle_training.num_cases, (double)100 * training_cases_correct / mnist_handle_training.num_cases);
         log_append(log_file_name, string_buffer);
-        log_append_time(log_file_name, string_buffer, "Time taken", start, clock());
+        log_append_time(log_file_name, string_buffer, "Time taken", start, timer_seconds());
 
         // Test against testing data
         storage.mnist_handle = &mnist_handle_testing;
-        start = clock();
+        start = timer_seconds();
         int testing_cases_correct = evaluate_all_cases(storage);
         sprintf(string_buffer, "Testing dataset evaluation: %d / %d, %.01f%%\n", testing_cases_correct, mnist_handle_testing.num_cases, (double)100 * testing_cases_correct / mnist_handle_testing.num_cases);
         log_append(log_file_name, string_buffer);
-        clock_t end = clock();
+        double end = timer_seconds();
+        // The time the evaluating threads spent waiting on the loader, summed over the threads and both datasets.
+        sprintf(string_buffer, "Evaluation waiting on data: %.3fs\n", data_loader_stall_seconds(loader));
+        log_append(log_file_name, string_buffer);
         log_append_time(log_file_name, string_buffer, "Time taken", start, end);
         log_append_time(log_file_name, string_buffer, "Epoch time taken", start_epoch, end);
         log_append_time(log_file_name, string_buffer, "Total time taken", start_total, end);
+        // Testing accuracy against the wall clock time spent training, to compare training modes.
+        sprintf(string_buffer, "Accuracy vs training time: %.2fs, %.02f%%\n", training_seconds, (double)100 * testing_cases_correct / mnist_handle_testing.num_cases);
+        log_append(log_file_name, string_buffer);
+        if (schedule_name)
+            schedule_observe(&schedule, (double)testing_cases_correct / mnist_handle_testing.num_cases);
+        if (!reached_target && testing_cases_correct >= TARGET_ACCURACY * mnist_handle_testing.num_cases) {
+            reached_target = 1;
+            sprintf(string_buffer, "Reached %.0f%% testing accuracy after %.2fs of training.\n", 100 * TARGET_ACCURACY, training_seconds);
+            log_append(log_file_name, string_buffer);
+        }
 
         if (testing_cases_correct > max_num_correct) {
             sprintf(string_buffer, "New best epoch. Saving neural network.\n");
             log_append(log_file_name, string_buffer);
             max_num_correct = testing_cases_correct;
             best_epoch = i;
-            neural_network_save_dynamic(&neural_network, "models/mnist.model.dynamic");
+            if (is_main_process)
+                neural_network_save_dynamic(&neural_network, "models/mnist.model.dynamic");
         }
-        else {
-            sprintf(string_buffer, "Epoch performed worse than last. Exiting.\n");
+        else if (i - best_epoch >= EPOCH_PATIENCE) {
+            sprintf(string_buffer, "No improvement in %d epochs. Exiting.\n", EPOCH_PATIENCE);
+            log_append(log_file_name, string_buffer);
+            break;
+        }
+        if (epochs && i == epochs) {
+            sprintf(string_buffer, "Trained for %d epochs. Exiting.\n", epochs);
             log_append(log_file_name, string_buffer);
             break;
         }
     }
+    if (!reached_target) {
+        sprintf(string_buffer, "Did not reach %.0f%% testing accuracy.\n", 100 * TARGET_ACCURACY);
+        log_append(log_file_name, string_buffer);
+    }
 
-    mutex_wrapper_close(&mutex);
+    data_loader_delete(loader);
+    neural_network_optimizer_delete(&optimizer);
+    for (int i = 0; i < n_trainers; i++) {
+        neural_network_trainer_delete(&trainers[i]);
+    }
+    if (train_mode == MNIST_TRAIN_MIXED)
+        neural_network_mixed_trainer_delete(&mixed_trainer);
     for (int i = 0; i < N_THREADS; i++) {
-        neural_network_evaluation_delete(evaluations[i]);
+        neural_network_inference_ctx_delete(&inference_ctxs[i]);
     }
     mnist_handle_close(&mnist_handle_training);
     mnist_handle_close(&mnist_handle_testing);
+    if (ring)
+        process_ring_delete(ring);
 }
 
 /**
@@ -204,30 +402,188 @@ double training_parameter_calc(double p_high, double p_low, int cases_correct, i
     return p_low * lerp_factor + p_high * (1 - lerp_factor);
 }
 
-void train_all_cases(neural_network_t *nn, mnist_handle_t *mh, storage_t storage, double training_parameter) {
-    mnist_reset(mh);
+/**
+ * @return The number of updates of the network in an epoch of the training mode, each the mean gradient of a batch of every worker or process.
+*/
+int steps_per_epoch(int train_mode, int num_cases, int ranks) {
+    if (train_mode == MNIST_TRAIN_DATA_PARALLEL)
+        return (num_cases + BATCH_SIZE * N_TRAIN_WORKERS - 1) / (BATCH_SIZE * N_TRAIN_WORKERS);
+    if (train_mode == MNIST_TRAIN_DISTRIBUTED)
+        return ((num_cases + ranks - 1) / ranks + BATCH_SIZE - 1) / BATCH_SIZE;
+    return (num_cases + BATCH_SIZE - 1) / BATCH_SIZE;
+}
+
+void train_all_cases(mnist_handle_t *mh, storage_t storage, double training_parameter) {
+    loader_start(&storage, mh);
     int num_cases;
-    while (num_cases = mnist_load_batch(mh, storage.inputs_data, storage.outputs)) {
+    int num_trained = 0;
+    int slot;
+    while ((slot = data_loader_acquire(storage.loader, &num_cases)) >= 0) {
+        void *batch = data_loader_slot(storage.loader, slot);
+        unsigned char *outputs = mnist_batch_outputs(batch, BATCH_SIZE);
+        matrix_t *inputs = storage.slot_inputs + slot*BATCH_SIZE;
+        matrix_initialize_multiple_from_array(inputs, num_cases, 1, INPUT_SIZE, mnist_batch_inputs(batch));
+        // The cross-entropy is trained on the digits themselves, the squared error on their one-hot outputs.
+        if (storage.loss == LOSS_CROSS_ENTROPY) {
+            for (int i = 0; i < num_cases; i++)
+                storage.classes[i] = outputs[i];
+            neural_network_trainer_train_batch_classes(storage.trainers, inputs, storage.classes, num_cases, training_parameter);
+        }
+        else {
+            for (int i = 0; i < num_cases; i++) {
+                unsigned char label = outputs[i];
+                storage.labels[i] = storage.output_map[label];
+            }
+            neural_network_trainer_train_batch(storage.trainers, inputs, storage.labels, num_cases, training_parameter);
+        }
+        data_loader_release(storage.loader, slot);
+        num_trained += num_cases;
+        printf("Trained: %5d / %5d\r", num_trained, mh->num_cases);
+        fflush(stdout);
+    }
+}
+
+/**
+ * Train with Hogwild workers, which pull batches from the data loader and update the network's weights without locking.
+*/
+void train_all_cases_hogwild(mnist_handle_t *mh, storage_t *storage, double training_parameter) {
+    loader_start(storage, mh);
+    for (int i = 0; i < N_TRAIN_WORKERS; i++)
+        storage->worker_slots[i] = -1;
+    storage->worker_cases = 0;
+    neural_network_train_hogwild(storage->trainers, N_TRAIN_WORKERS, hogwild_next_batch, storage, training_parameter, NULL);
+}
+
+/**
+ * Train with data-parallel workers on batches of a batch per worker, each worker computing the gradient of its share.
+ * The mean gradient is over a batch per worker, so the training parameter is scaled to match.
+*/
+void train_all_cases_data_parallel(mnist_handle_t *mh, storage_t *storage, double training_parameter) {
+    mnist_reset(mh);
+    while (1) {
+        int num_cases = 0;
+        for (int i = 0; i < N_TRAIN_WORKERS; i++) {
+            int batch_size = mnist_load_batch(mh, storage->inputs_data + num_cases*INPUT_SIZE, storage->outputs + num_cases);
+            if (!batch_size)
+                break;
+            num_cases += batch_size;
+        }
+        if (!num_cases)
+            return;
         for (int i = 0; i < num_cases; i++) {
-            unsigned char label = storage.outputs[i];
-            matrix_t *output = &storage.output_map[label];
-            neural_network_evaluation_outputs(nn, storage.inputs+i, *storage.evaluations);
-            neural_network_evaluation_errors(nn, output, *storage.evaluations);
-            neural_network_evaluation_apply(nn, storage.inputs+i, *storage.evaluations, training_parameter);
+            unsigned char label = storage->outputs[i];
+            storage->labels[i] = storage->output_map[label];
         }
+        neural_network_train_data_parallel(storage->trainers, N_TRAIN_WORKERS, storage->inputs, storage->labels, num_cases, training_parameter * N_TRAIN_WORKERS, NULL);
         printf("Trained: %5d / %5d\r", mh->index, mh->num_cases);
         fflush(stdout);
     }
 }
 
+/**
+ * Train as one process of a ring on this process's shard of the dataset, a batch at a time, the gradients summed across the ring.
+ * Every process takes as many steps as the largest shard needs, the others passing empty batches once their shard runs out.
+ * The mean gradient is over a batch per process, so the training parameter is scaled to match.
+*/
+void train_all_cases_distributed(mnist_handle_t *mh, storage_t *storage, double training_parameter) {
+    mnist_reset(mh);
+    int ranks = process_ring_size(storage->ring);
+    int largest_shard = (mh->num_cases + ranks - 1) / ranks;
+    int steps = (largest_shard + BATCH_SIZE - 1) / BATCH_SIZE;
+    for (int step = 0; step < steps; step++) {
+        int num_cases = mnist_load_batch(mh, storage->inputs_data, storage->outputs);
+        for (int i = 0; i < num_cases; i++) {
+            unsigned char label = storage->outputs[i];
+            storage->labels[i] = storage->output_map[label];
+        }
+        neural_network_train_distributed(storage->trainers, storage->ring, storage->inputs, storage->labels, num_cases, training_parameter * ranks);
+        if (process_ring_rank(storage->ring) == 0) {
+            printf("Trained: %5d / %5d\r", (step + 1) * BATCH_SIZE, largest_shard);
+            fflush(stdout);
+        }
+    }
+}
+
+/**
+ * Train on a single thread with mixed precision, each batch converted to single precision for the float copy of the network.
+*/
+void train_all_cases_mixed(mnist_handle_t *mh, storage_t *storage, double training_parameter) {
+    loader_start(storage, mh);
+    int num_cases;
+    int num_trained = 0;
+    int slot;
+    while ((slot = data_loader_acquire(storage->loader, &num_cases)) >= 0) {
+        void *batch = data_loader_slot(storage->loader, slot);
+        double *inputs_data = mnist_batch_inputs(batch);
+        unsigned char *outputs = mnist_batch_outputs(batch, BATCH_SIZE);
+        for (int i = 0; i < num_cases * INPUT_SIZE; i++)
+            storage->inputs_data_f32[i] = (float)inputs_data[i];
+        if (storage->loss == LOSS_CROSS_ENTROPY) {
+            for (int i = 0; i < num_cases; i++)
+                storage->classes[i] = outputs[i];
+            neural_network_mixed_trainer_train_batch_classes(storage->mixed_trainer, storage->inputs_f32, storage->classes, num_cases, training_parameter);
+        }
+        else {
+            for (int i = 0; i < num_cases; i++) {
+                unsigned char label = outputs[i];
+                storage->labels_f32[i] = storage->output_map_f32[label];
+            }
+            neural_network_mixed_trainer_train_batch(storage->mixed_trainer, storage->inputs_f32, storage->labels_f32, num_cases, training_parameter);
+        }
+        data_loader_release(storage->loader, slot);
+        num_trained += num_cases;
+        printf("Trained: %5d / %5d\r", num_trained, mh->num_cases);
+        fflush(stdout);
+    }
+}
+
+/**
+ * Load the handle's epoch with the data loader, its batches then taken from the loader's slots.
+*/
+void loader_start(storage_t *storage, mnist_handle_t *mh) {
+    *storage->loader_handle = mh;
+    mnist_reset(mh);
+    data_loader_start_epoch(storage->loader);
+}
+
+int hogwild_next_batch(void *storage_ptr, int worker, matrix_t **inputs, matrix_t **labels) {
+    storage_t *storage = (storage_t *)storage_ptr;
+    // The worker is done with its previous batch once it asks for the next.
+    if (storage->worker_slots[worker] >= 0)
+        data_loader_release(storage->loader, storage->worker_slots[worker]);
+    int num_cases;
+    int slot = data_loader_acquire(storage->loader, &num_cases);
+    storage->worker_slots[worker] = slot;
+    if (slot < 0)
+        return 0;
+
+    void *batch = data_loader_slot(storage->loader, slot);
+    unsigned char *outputs = mnist_batch_outputs(batch, BATCH_SIZE);
+    *inputs = storage->slot_inputs + slot*BATCH_SIZE;
+    matrix_initialize_multiple_from_array(*inputs, num_cases, 1, INPUT_SIZE, mnist_batch_inputs(batch));
+    *labels = storage->labels + worker*BATCH_SIZE;
+    for (int i = 0; i < num_cases; i++) {
+        unsigned char label = outputs[i];
+        (*labels)[i] = storage->output_map[label];
+    }
+    // Each worker trains on about an equal share of the cases.
+    if (worker == 0) {
+        storage->worker_cases += num_cases;
+        printf("Trained: %5d / %5d\r", storage->worker_cases * N_TRAIN_WORKERS, (*storage->loader_handle)->num_cases);
+        fflush(stdout);
+    }
+    return num_cases;
+}
+
 /**
  * @return The number of cases correctly classified.
 */
 int evaluate_all_cases(storage_t storage) {
     int num_cases_correct = 0;
-    mnist_reset(storage.mnist_handle);
+    loader_start(&storage, storage.mnist_handle);
 
-    thread_wrapper_t threads[N_THREADS];
+    thread_pool_group_t group;
+    thread_pool_group_initialize(&group, NULL);
     evaluation_storage_t evaluation_storages[N_THREADS];
     int thread_num_correct[N_THREADS];
     for (int i = 0; i < N_THREADS; i++) {
@@ -235,66 +591,77 @@ int evaluate_all_cases(storage_t storage) {
         thread_storage->neural_network=storage.neural_network;
         thread_storage->mnist_handle=storage.mnist_handle;
         thread_storage->output_map=storage.output_map;
-        thread_storage->mutex=storage.mutex;
-        thread_storage->inputs_data=storage.inputs_data + i*INPUT_SIZE*BATCH_SIZE;
-        thread_storage->inputs=storage.inputs + i*BATCH_SIZE;
-        thread_storage->outputs=storage.outputs + i*BATCH_SIZE;
-        thread_storage->evaluations=storage.evaluations + i;
+        thread_storage->loader=storage.loader;
+        thread_storage->inference_ctxs=storage.inference_ctxs + i;
         evaluation_storages[i].thread_num = i;
         evaluation_storages[i].num_cases_correct = &thread_num_correct[i];
-        thread_wrapper_create(&threads[i], evaluate_all_cases_thread, (void *)&evaluation_storages[i]);
+        thread_pool_group_submit(&group, evaluate_all_cases_thread, (void *)&evaluation_storages[i]);
     }
-    int num_threads_complete = 0;
-    while (num_threads_complete < N_THREADS) {
-        thread_wrapper_join(&threads[num_threads_complete]);
-        num_cases_correct += thread_num_correct[num_threads_complete];
-        num_threads_complete++;
+    thread_pool_group_wait(&group);
+    for (int i = 0; i < N_THREADS; i++) {
+        num_cases_correct += thread_num_correct[i];
     }
     printf("                              \r");
     return num_cases_correct;
 }
 
-void *evaluate_all_cases_thread(void *eval_storage_ptr) {
+void evaluate_all_cases_thread(void *eval_storage_ptr) {
     evaluation_storage_t *eval_storage = (evaluation_storage_t *)(eval_storage_ptr);
     storage_t *storage = &eval_storage->storage;
     int batch_size;
+    int num_tested = 0;
     int *num_cases_correct = eval_storage->num_cases_correct;
     *num_cases_correct = 0;
-    while (1) {
-        mutex_wrapper_lock(storage->mutex);
-        batch_size = mnist_load_batch(storage->mnist_handle, storage->inputs_data, storage->outputs);
-        mutex_wrapper_unlock(storage->mutex);
-        if (!batch_size)
-            return NULL;
+    int slot;
+    while ((slot = data_loader_acquire(storage->loader, &batch_size)) >= 0) {
+        void *batch = data_loader_slot(storage->loader, slot);
+        unsigned char *outputs = mnist_batch_outputs(batch, BATCH_SIZE);
+        // The batch is evaluated with a column per case, through a transposed view of the case rows.
+        matrix_t input_rows;
+        int offset = 0;
+        matrix_initialize_from_array(&input_rows, INPUT_SIZE, batch_size, mnist_batch_inputs(batch), &offset);
+        matrix_t inputs = matrix_transpose_view(&input_rows);
+        matrix_t outputs_calculated = neural_network_inference_evaluate(storage->neural_network, storage->inference_ctxs, &inputs);
         for (int i = 0; i < batch_size; i++) {
-            neural_network_evaluation_outputs(storage->neural_network, storage->inputs+i, *storage->evaluations);
-            unsigned char label = storage->outputs[i];
-            unsigned char label_calculated = mnist_output_to_number(&storage->evaluations->layers[storage->neural_network->hidden_layer_count].outputs);
+            matrix_t output_calculated = matrix_block_view(&outputs_calculated, i, 0, 1, OUTPUT_SIZE);
+            unsigned char label = outputs[i];
+            unsigned char label_calculated = mnist_output_to_number(&output_calculated);
             *num_cases_correct += label == label_calculated;
         }
+        data_loader_release(storage->loader, slot);
+        num_tested += batch_size;
+        // Each thread tests about an equal share of the cases.
         if (eval_storage->thread_num == 0) {
-            printf("Tested: %5d / %5d\r", storage->mnist_handle->index, storage->mnist_handle->num_cases);
+            printf("Tested: %5d / %5d\r", num_tested * N_THREADS, storage->mnist_handle->num_cases);
             fflush(stdout);
         }
     }
-    return NULL;
 }
 
+/**
+ * The logging functions do nothing when the inputted filename is NULL.
+*/
 void log_start(const char *filename) {
+    if (filename == NULL)
+        return;
     FILE *file = fopen(filename, "w");
     fprintf(file, "Training neural network on the MNIST training dataset.\n");
     fclose(file);
 }
 
 void log_append(const char *filename, char *str) {
+    if (filename == NULL)
+        return;
     FILE *file = fopen(filename, "a");
     printf("%s", str);
     fprintf(file, "%s", str);
     fclose(file);
 }
 
-void log_append_time(const char *filename, char *string_buffer, const char *label, clock_t start, clock_t end) {
-    int milliseconds = (end - start) * 1000 / CLOCKS_PER_SEC;
+void log_append_time(const char *filename, char *string_buffer, const char *label, double start, double end) {
+    if (filename == NULL)
+        return;
+    int milliseconds = (int)((end - start) * 1000);
     int seconds  = (milliseconds / 1000) % 60;
     int minutes = milliseconds / 1000 / 60;
     milliseconds = milliseconds % 1000;
@@ -2,4 +2,31 @@
 // 'mnist_full.h' definitions
 //
 
-void mnist_full();
+// The ways 'mnist_full' can train, on a single thread, with Hogwild workers, with synchronous data-parallel workers,
+// as one of a ring of processes each training on a shard of the dataset, or on a single thread with mixed precision.
+#define MNIST_TRAIN_SINGLE 0
+#define MNIST_TRAIN_HOGWILD 1
+#define MNIST_TRAIN_DATA_PARALLEL 2
+#define MNIST_TRAIN_DISTRIBUTED 3
+#define MNIST_TRAIN_MIXED 4
+
+// The number of epochs a schedule spans when the number of epochs is not given.
+#define MNIST_SCHEDULE_EPOCHS 10
+
+/**
+ * Train a new network on the MNIST training dataset, evaluating it against both datasets after each epoch, until it stops improving.
+ * Logs the training time taken to first reach 97% testing accuracy.
+ * @param train_mode One of 'MNIST_TRAIN_SINGLE', 'MNIST_TRAIN_HOGWILD', 'MNIST_TRAIN_DATA_PARALLEL', 'MNIST_TRAIN_DISTRIBUTED' or 'MNIST_TRAIN_MIXED'.
+ * @param epochs The most epochs to train for, and the length of the schedule. 0 trains until the network stops improving,
+ * with a schedule spanning 'MNIST_SCHEDULE_EPOCHS'.
+ * @param optimizer_name The update rule gradients are applied with, see 'optimizer_config_get'.
+ * @param schedule_name The learning rate schedule, see 'schedule_initialize', queried for every batch and shown each epoch's testing accuracy.
+ * NULL lowers the learning rate as the previous epoch's testing accuracy rises.
+ * @param loss_name The loss trained on, see 'loss_get'. The cross-entropy gives the network a softmax output layer,
+ * and single threaded training then computes the output errors from the labels' digits, without one-hot expected outputs.
+ * @param use_cache Not zero to read the images from caches of them normalized, see 'mnist_cache_load', rather than normalizing them every epoch.
+ * @param ring_address For 'MNIST_TRAIN_DISTRIBUTED', the address of the process ring, as passed to 'process_ring_create'. Otherwise unused.
+ * @param rank For 'MNIST_TRAIN_DISTRIBUTED', this process's position in the ring. Only the process of rank 0 logs and saves the network.
+ * @param ranks For 'MNIST_TRAIN_DISTRIBUTED', the number of processes in the ring.
+*/
+void mnist_full(int train_mode, int epochs, const char *optimizer_name, const char *schedule_name, const char *loss_name, int use_cache, const char *ring_address, int rank, int ranks);
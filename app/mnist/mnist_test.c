@@ -3,6 +3,8 @@
 #include "../../src/neural_network.h"
 #include "../../src/neural_network_file.h"
 
+#include <stdlib.h>
+
 //
 // 'mnist_test.c' definitions
 //
@@ -15,22 +17,18 @@
 //
 
 void mnist_test(const char *model_filename) {
-    unsigned char input_data_buffer[BATCH_SIZE * INPUT_SIZE];
-    mnist_handle_t mnist_handle = mnist_handle_init(TESTING_DATA_COUNT, BATCH_SIZE, input_data_buffer);
+    mnist_handle_t mnist_handle = mnist_handle_init(TESTING_DATA_COUNT, BATCH_SIZE);
     mnist_images_load("datasets/mnist/t10k-images.idx3-ubyte", &mnist_handle);
     mnist_labels_load("datasets/mnist/t10k-labels.idx1-ubyte", &mnist_handle);
 
     neural_network_t *neural_network = neural_network_load_dynamic(model_filename);
 
-    // Storage for inputs loaded from the MNIST handle.
+    // Storage for inputs loaded from the MNIST handle, a row per case.
     double inputs_data[BATCH_SIZE * INPUT_SIZE];
-    matrix_t inputs[BATCH_SIZE];
-    matrix_initialize_multiple_from_array(inputs, BATCH_SIZE, 1, INPUT_SIZE, inputs_data);
 
-    // Storage for outputs calculated through 'neural_network_evaluate'.
-    double outputs_calculated_batch_data[BATCH_SIZE * OUTPUT_SIZE];
-    matrix_t outputs_calculated_batch[BATCH_SIZE];
-    matrix_initialize_multiple_from_array(outputs_calculated_batch, BATCH_SIZE, 1, OUTPUT_SIZE, outputs_calculated_batch_data);
+    // Buffers for a batch of inference, which holds the calculated outputs.
+    neural_network_inference_ctx_t inference_ctx;
+    neural_network_inference_ctx_initialize(neural_network, &inference_ctx, BATCH_SIZE);
 
     // Storage of output labels loaded from the MNIST handle.
     unsigned char outputs[BATCH_SIZE];
@@ -39,9 +37,15 @@ void mnist_test(const char *model_filename) {
     printf("Testing:\n");
     int num_cases;
     while (num_cases = mnist_load_batch(&mnist_handle, inputs_data, outputs)) {
-        neural_network_evaluate(neural_network, num_cases, inputs, outputs_calculated_batch);
+        // The whole batch is evaluated with a column per case, through a transposed view of the case rows.
+        matrix_t input_rows;
+        int offset = 0;
+        matrix_initialize_from_array(&input_rows, INPUT_SIZE, num_cases, inputs_data, &offset);
+        matrix_t inputs = matrix_transpose_view(&input_rows);
+        matrix_t outputs_calculated = neural_network_inference_evaluate(neural_network, &inference_ctx, &inputs);
         for (int i = 0; i < num_cases; i++) {
-            unsigned char output_number_calculated = mnist_output_to_number(&outputs_calculated_batch[i]);
+            matrix_t output_calculated = matrix_block_view(&outputs_calculated, i, 0, 1, OUTPUT_SIZE);
+            unsigned char output_number_calculated = mnist_output_to_number(&output_calculated);
             unsigned char output_number = outputs[i];
             num_correct += (output_number_calculated == output_number);
         }
@@ -49,6 +53,8 @@ void mnist_test(const char *model_filename) {
         printf("Num correct: %d\n", num_correct);
     }
     mnist_handle_close(&mnist_handle);
+    neural_network_inference_ctx_delete(&inference_ctx);
+    neural_network_delete(neural_network);
 
     printf("Done!\n");
     printf("Perctentage correct: %.01f\n", ((double)num_correct * 100) / TESTING_DATA_COUNT);
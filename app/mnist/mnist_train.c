@@ -1,7 +1,9 @@
 #include <time.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "mnist.h"
+#include "../../src/data_loader.h"
 #include "../../src/neural_network.h"
 #include "../../src/neural_network_train.h"
 #include "../../src/neural_network_file.h"
@@ -22,31 +24,41 @@
 // Training parameters
 #define BATCH_SIZE 100
 #define TRAINING_DATA_COUNT 60000
-#define TRAINING_PARAMETER 0.001
+// Batch updates average the gradients of their cases, so the step is scaled by the batch size to match training case by case.
+#define TRAINING_PARAMETER (0.001 * BATCH_SIZE)
+// The shuffled batches gathered ahead of training, one being trained on while the next are gathered.
+#define N_LOADER_SLOTS 3
 
-neural_network_t *initialize_neural_network();
+neural_network_t *initialize_neural_network(loss_t loss);
 void save_neural_network(neural_network_t *nn, time_t timer, int iteration, int do_overwrite);
 
 //
 // 'mnist_train.h' implementations
 //
 
-void mnist_train(const char *model_filename, int epochs, int do_overwrite) {
-    unsigned char input_data_buffer[BATCH_SIZE * INPUT_SIZE];
-    mnist_handle_t mnist_handle = mnist_handle_init(TRAINING_DATA_COUNT, BATCH_SIZE, input_data_buffer);
+void mnist_train(const char *model_filename, int epochs, int do_overwrite, const char *optimizer_name, const char *schedule_name, const char *loss_name, int use_cache) {
+    mnist_handle_t mnist_handle = mnist_handle_init(TRAINING_DATA_COUNT, BATCH_SIZE);
     mnist_images_load("datasets/mnist/train-images.idx3-ubyte", &mnist_handle);
     mnist_labels_load("datasets/mnist/train-labels.idx1-ubyte", &mnist_handle);
+    if (use_cache)
+        printf(mnist_cache_load("datasets/mnist/train-images.idx3-ubyte", &mnist_handle) ? "Mapped the normalized dataset cache.\n" : "Wrote the normalized dataset cache.\n");
 
-    double inputs_data[BATCH_SIZE * INPUT_SIZE];
-    matrix_t inputs[BATCH_SIZE];
-    matrix_initialize_multiple_from_array(inputs, BATCH_SIZE, 1, INPUT_SIZE, inputs_data);
+    // The cases are shuffled every epoch, and gathered into batches in the background by the data loader.
+    random_state_t shuffle_state;
+    random_state_seed(&shuffle_state, (uint64_t)rand());
+    mnist_handle_t *loader_handle = &mnist_handle;
+    data_loader_t *loader = data_loader_create(N_LOADER_SLOTS, mnist_batch_bytes(BATCH_SIZE), mnist_loader_fill, &loader_handle);
+    // Each slot's batch viewed as a matrix per case, where the batch's inputs are once loaded.
+    matrix_t slot_inputs[N_LOADER_SLOTS * BATCH_SIZE];
 
     double output_map_data[OUTPUT_DATA_SIZE];
     mnist_initialize_output_data(output_map_data);
     matrix_t output_map[10];
     mnist_initialize_outputs(output_map, output_map_data);
 
-    unsigned char outputs[BATCH_SIZE];
+    matrix_t labels[BATCH_SIZE];
+    int classes[BATCH_SIZE];
+    loss_t loss = loss_get(loss_name);
 
     neural_network_t *neural_network = NULL;
     if (model_filename) {
@@ -54,28 +66,62 @@ void mnist_train(const char *model_filename, int epochs, int do_overwrite) {
         printf("Loaded model.\n");
     }
     else {
-        neural_network = initialize_neural_network();
+        neural_network = initialize_neural_network(loss);
     }
 
+    neural_network_trainer_t trainer;
+    neural_network_trainer_initialize(neural_network, &trainer, BATCH_SIZE);
+    neural_network_trainer_set_loss(&trainer, loss);
+    optimizer_config_t optimizer_config = optimizer_config_get(optimizer_name);
+    neural_network_optimizer_t optimizer;
+    neural_network_optimizer_initialize(neural_network, &optimizer, optimizer_config);
+    neural_network_trainer_set_optimizer(&trainer, &optimizer);
+    double learning_rate = mnist_optimizer_learning_rate(&optimizer_config, TRAINING_PARAMETER);
+    // The schedule spans every batch of every epoch.
+    schedule_t schedule;
+    schedule_initialize(&schedule, schedule_name, (long long)epochs * ((TRAINING_DATA_COUNT + BATCH_SIZE - 1) / BATCH_SIZE));
+    neural_network_trainer_set_schedule(&trainer, &schedule);
+
     time_t timer = time(NULL);
-    printf("Training...\n");
+    printf("Training with optimizer '%s', schedule '%s' and loss '%s'...\n", optimizer_config.name, schedule.name, loss_name);
     for (int i = 0; i < epochs; i++) {
         printf("Epoch %d\n", i+1);
+        mnist_shuffle(&mnist_handle, &shuffle_state);
+        mnist_reset(&mnist_handle);
+        data_loader_start_epoch(loader);
         int batch_size;
-        while (batch_size = mnist_load_batch(&mnist_handle, inputs_data, outputs)) {
-            for (int j = 0; j < batch_size; j++) {
-                unsigned char label = outputs[j];
-                matrix_t *label_matrix = &output_map[label];
-                neural_network_train_case(neural_network, &inputs[j], label_matrix, TRAINING_PARAMETER);
+        int num_trained = 0;
+        int slot;
+        while ((slot = data_loader_acquire(loader, &batch_size)) >= 0) {
+            void *batch = data_loader_slot(loader, slot);
+            unsigned char *outputs = mnist_batch_outputs(batch, BATCH_SIZE);
+            matrix_t *inputs = slot_inputs + slot*BATCH_SIZE;
+            matrix_initialize_multiple_from_array(inputs, batch_size, 1, INPUT_SIZE, mnist_batch_inputs(batch));
+            // The cross-entropy is trained on the digits themselves, the squared error on their one-hot outputs.
+            if (loss == LOSS_CROSS_ENTROPY) {
+                for (int j = 0; j < batch_size; j++)
+                    classes[j] = outputs[j];
+                neural_network_trainer_train_batch_classes(&trainer, inputs, classes, batch_size, learning_rate);
             }
-            printf("%d\r", mnist_handle.index);
+            else {
+                for (int j = 0; j < batch_size; j++) {
+                    unsigned char label = outputs[j];
+                    labels[j] = output_map[label];
+                }
+                neural_network_trainer_train_batch(&trainer, inputs, labels, batch_size, learning_rate);
+            }
+            data_loader_release(loader, slot);
+            num_trained += batch_size;
+            printf("%d\r", num_trained);
             fflush(stdout);
         }
-        printf("\n");
+        printf("\nLearning rate: %g\n", learning_rate * schedule_factor(&schedule, schedule_steps(&schedule) - 1));
         save_neural_network(neural_network, timer, i, do_overwrite);
-        mnist_reset(&mnist_handle);
     }
     printf("Done!\n");
+    data_loader_delete(loader);
+    neural_network_optimizer_delete(&optimizer);
+    neural_network_trainer_delete(&trainer);
     mnist_handle_close(&mnist_handle);
 }
 
@@ -83,9 +129,9 @@ void mnist_train(const char *model_filename, int epochs, int do_overwrite) {
 // 'mnist_train.c' implementations
 //
 
-neural_network_t *initialize_neural_network() {
+neural_network_t *initialize_neural_network(loss_t loss) {
     int hidden_layer_sizes[HIDDEN_LAYER_COUNT] = { HIDDEN_LAYER_SIZE_1 };
-    char *activation_function_names[HIDDEN_LAYER_COUNT+1] = { "sigmoid", "sigmoid" };
+    char *activation_function_names[HIDDEN_LAYER_COUNT+1] = { "sigmoid", mnist_output_activation_function(loss) };
     neural_network_t *neural_network = neural_network_create(
         INPUT_LAYER_SIZE,
         OUTPUT_LAYER_SIZE,
@@ -2,4 +2,4 @@
 // 'mnist_train.h' definitions
 //
 
-void mnist_train(const char *model_filename, int epochs, int do_overwrite);
+void mnist_train(const char *model_filename, int epochs, int do_overwrite, const char *optimizer_name, const char *schedule_name, const char *loss_name, int use_cache);
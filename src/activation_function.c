@@ -1,6 +1,8 @@
 #include "activation_function.h"
 
 #include "error.h"
+#include "matrix_arena.h"
+#include "matrix_kernels.h"
 
 #include <math.h>
 #include <string.h>
@@ -11,15 +13,19 @@
 
 void format_activation_function_name(activation_function_t af, const char *name);
 
-/**
- * Maps from (-inf,+inf) to (-1,1). Similarly shaped to a tangent function.
-*/
-double sigmoid(double);
-double sigmoid_derivative(double);
-double relu(double);
-double relu_derivative(double);
-double leaky_relu(double);
-double leaky_relu_derivative(double);
+// Every variant of an activation function, named after the scalar function of doubles.
+#define ACTIVATION_FUNCTION_VARIANTS(f) \
+    f, f##_derivative, f##_f32, f##_derivative_f32, \
+    f##_batch, f##_derivative_batch, f##_derivative_output_batch, \
+    f##_batch_f32, f##_derivative_batch_f32, f##_derivative_output_batch_f32
+
+#include "template_f64.h"
+#include "activation_function_template.h"
+#include "template_end.h"
+
+#include "template_f32.h"
+#include "activation_function_template.h"
+#include "template_end.h"
 
 //
 // 'activation_function.h' implementations
@@ -29,15 +35,19 @@ double leaky_relu_derivative(double);
 activation_function_t activation_function_get(const char *name) {
     // Chain of if-elses hooray
     if (strcmp(name, "sigmoid") == 0) {
-        activation_function_t af = { "sigmoid", sigmoid, sigmoid_derivative };
+        activation_function_t af = { "sigmoid", ACTIVATION_FUNCTION_VARIANTS(sigmoid), 0 };
         return af;
     }
     if (strcmp(name, "relu") == 0) {
-        activation_function_t af = { "relu", relu, relu_derivative };
+        activation_function_t af = { "relu", ACTIVATION_FUNCTION_VARIANTS(relu), 0 };
         return af;
     }
     if (strcmp(name, "leaky_relu") == 0) {
-        activation_function_t af = { "leaky_relu", leaky_relu, leaky_relu_derivative };
+        activation_function_t af = { "leaky_relu", ACTIVATION_FUNCTION_VARIANTS(leaky_relu), 0 };
+        return af;
+    }
+    if (strcmp(name, "softmax") == 0) {
+        activation_function_t af = { "softmax", ACTIVATION_FUNCTION_VARIANTS(softmax), 1 };
         return af;
     }
     make_error("Activation function does not exist");
@@ -50,40 +60,21 @@ void activation_function_copy(activation_function_t src, activation_function_t *
     strcpy(dest->name, src.name);
     dest->function = src.function;
     dest->derivative = src.derivative;
+    dest->function_f32 = src.function_f32;
+    dest->derivative_f32 = src.derivative_f32;
+    dest->function_batch = src.function_batch;
+    dest->derivative_batch = src.derivative_batch;
+    dest->derivative_output_batch = src.derivative_output_batch;
+    dest->function_batch_f32 = src.function_batch_f32;
+    dest->derivative_batch_f32 = src.derivative_batch_f32;
+    dest->derivative_output_batch_f32 = src.derivative_output_batch_f32;
+    dest->softmax = src.softmax;
 }
 
-//
-// 'activation_function.c' implementations
-//
-
-double sigmoid(double x) {
-    return 1 / (1 + exp(-x));
-}
+#include "template_f64.h"
+#include "activation_function_template.inc"
+#include "template_end.h"
 
-double sigmoid_derivative(double x) {
-    return sigmoid(x) * (1 - sigmoid(x));
-}
-
-double relu(double x) {
-    if (x > 0)
-        return x;
-    return 0;
-}
-
-double relu_derivative(double x) {
-    if (x > 0)
-        return 1;
-    return 0;
-}
-
-double leaky_relu(double x) {
-    if (x > 0)
-        return x;
-    return 0.5 * x;    
-}
-
-double leaky_relu_derivative(double x) {
-    if (x > 0)
-        return 1;
-    return 0.5;
-}
+#include "template_f32.h"
+#include "activation_function_template.inc"
+#include "template_end.h"
@@ -2,6 +2,7 @@
 #define NEURAL_NETWORK_ACTIVATION_FUNCTIONS
 
 #include "matrix.h"
+#include "matrix_f32.h"
 
 //
 // 'activation_function.h' definitions
@@ -9,17 +10,41 @@
 
 #define ACTIVATION_FUNCTION_NAME_SIZE 16
 
+/**
+ * An activation function and its derivative, for doubles and floats.
+ * The scalar maps take one entry at a time. The batch maps take whole arrays, so they can be vectorized,
+ * and add the derivative computed from the function's output, e.g. s * (1 - s) for the sigmoid s, which needs no further 'exp'.
+ * 'softmax' is set for the softmax, which is not element-wise. Its maps are the identity on the logits, which 'layer_forward' then normalizes
+ * a case at a time. Its derivative is never computed, as its Jacobian cancels against the gradient of the cross-entropy, leaving the outputs minus the labels,
+ * so it may only be used by a network's output layer.
+*/
 typedef struct {
     char name[ACTIVATION_FUNCTION_NAME_SIZE];
     matrix_map_t function;
     matrix_map_t derivative;
+    matrix_map_f32_t function_f32;
+    matrix_map_f32_t derivative_f32;
+    matrix_batch_map_t function_batch;
+    matrix_batch_map_t derivative_batch;
+    matrix_batch_map_t derivative_output_batch;
+    matrix_batch_map_f32_t function_batch_f32;
+    matrix_batch_map_f32_t derivative_batch_f32;
+    matrix_batch_map_f32_t derivative_output_batch_f32;
+    int softmax;
 } activation_function_t;
 
 /**
  * Returns the activation function mapped to by the inputted name.
- * @param name Valid inputs: "sigmoid", "relu", "leaky_relu".
+ * @param name Valid inputs: "sigmoid", "relu", "leaky_relu", "softmax".
 */
 activation_function_t activation_function_get(const char *name);
 void activation_function_copy(activation_function_t src, activation_function_t *dest);
 
+/**
+ * Replace each column of logits with its softmax, subtracting the column's largest logit before exponentiating so no 'exp' overflows.
+ * Entry (col, row) is at data[col * col_stride + row * row_stride].
+*/
+void softmax_columns(double *data, int cols, int rows, int row_stride, int col_stride);
+void softmax_columns_f32(float *data, int cols, int rows, int row_stride, int col_stride);
+
 #endif
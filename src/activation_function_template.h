@@ -0,0 +1,32 @@
+//
+// 'activation_function_template.h' definitions
+//
+
+/**
+ * Maps from (-inf,+inf) to (-1,1). Similarly shaped to a tangent function.
+*/
+SCALAR_T TEMPLATE_SUFFIX(sigmoid)(SCALAR_T);
+SCALAR_T TEMPLATE_SUFFIX(sigmoid_derivative)(SCALAR_T);
+SCALAR_T TEMPLATE_SUFFIX(relu)(SCALAR_T);
+SCALAR_T TEMPLATE_SUFFIX(relu_derivative)(SCALAR_T);
+SCALAR_T TEMPLATE_SUFFIX(leaky_relu)(SCALAR_T);
+SCALAR_T TEMPLATE_SUFFIX(leaky_relu_derivative)(SCALAR_T);
+SCALAR_T TEMPLATE_SUFFIX(softmax)(SCALAR_T);
+SCALAR_T TEMPLATE_SUFFIX(softmax_derivative)(SCALAR_T);
+
+/**
+ * Array-at-a-time variants, 'y[i] = f(x[i])' for i < n, where y may equal x.
+ * The '_derivative_output' variants take the function's outputs rather than its inputs.
+*/
+void TEMPLATE_SUFFIX(sigmoid_batch)(SCALAR_T *y, const SCALAR_T *x, int n);
+void TEMPLATE_SUFFIX(sigmoid_derivative_batch)(SCALAR_T *y, const SCALAR_T *x, int n);
+void TEMPLATE_SUFFIX(sigmoid_derivative_output_batch)(SCALAR_T *y, const SCALAR_T *x, int n);
+void TEMPLATE_SUFFIX(relu_batch)(SCALAR_T *y, const SCALAR_T *x, int n);
+void TEMPLATE_SUFFIX(relu_derivative_batch)(SCALAR_T *y, const SCALAR_T *x, int n);
+void TEMPLATE_SUFFIX(relu_derivative_output_batch)(SCALAR_T *y, const SCALAR_T *x, int n);
+void TEMPLATE_SUFFIX(leaky_relu_batch)(SCALAR_T *y, const SCALAR_T *x, int n);
+void TEMPLATE_SUFFIX(leaky_relu_derivative_batch)(SCALAR_T *y, const SCALAR_T *x, int n);
+void TEMPLATE_SUFFIX(leaky_relu_derivative_output_batch)(SCALAR_T *y, const SCALAR_T *x, int n);
+void TEMPLATE_SUFFIX(softmax_batch)(SCALAR_T *y, const SCALAR_T *x, int n);
+void TEMPLATE_SUFFIX(softmax_derivative_batch)(SCALAR_T *y, const SCALAR_T *x, int n);
+void TEMPLATE_SUFFIX(softmax_derivative_output_batch)(SCALAR_T *y, const SCALAR_T *x, int n);
@@ -0,0 +1,197 @@
+#include "data_loader.h"
+
+#include "error.h"
+#include "timer.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+//
+// 'data_loader.c' definitions
+//
+
+#define DATA_LOADER_ALIGNMENT 64
+
+struct data_loader_t {
+    int n_slots;
+    size_t slot_size;
+    unsigned char *slot_data;
+    // The number of cases of each slot's batch, and whether the slot is free for the producer to load.
+    int *slot_cases;
+    int *slot_free;
+    data_loader_fill_function_t fill;
+    void *source_data;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    // Batches of the epoch are loaded into slot 'tail % n_slots' and taken from slot 'head % n_slots'.
+    long long head;
+    long long tail;
+    // Set once the fill function returns 0, the epoch then ending when 'head' reaches 'tail'.
+    int epoch_loaded;
+    long long epoch;
+    int stop;
+    double stall_seconds;
+};
+
+void *data_loader_thread(void *loader_ptr);
+void data_loader_run_epoch(data_loader_t *loader);
+
+//
+// 'data_loader.h' implementations
+//
+
+data_loader_t *data_loader_create(int n_slots, size_t slot_size, data_loader_fill_function_t fill, void *source_data) {
+    cnd_make_error(n_slots < 1 || slot_size < 1, "A data loader needs at least one slot of at least one byte.");
+    data_loader_t *loader = (data_loader_t *)calloc(1, sizeof(data_loader_t));
+    cnd_make_error(loader == NULL, "Failed to allocate data loader.");
+    // Each slot starts on a cache line, so consumers of neighbouring slots share none.
+    loader->slot_size = (slot_size + DATA_LOADER_ALIGNMENT - 1) / DATA_LOADER_ALIGNMENT * DATA_LOADER_ALIGNMENT;
+    loader->n_slots = n_slots;
+    loader->slot_data = (unsigned char *)aligned_alloc(DATA_LOADER_ALIGNMENT, n_slots * loader->slot_size);
+    loader->slot_cases = (int *)calloc(n_slots, sizeof(int));
+    loader->slot_free = (int *)malloc(n_slots * sizeof(int));
+    cnd_make_error(!loader->slot_data || !loader->slot_cases || !loader->slot_free, "Failed to allocate data loader.");
+    for (int i = 0; i < n_slots; i++)
+        loader->slot_free[i] = 1;
+    loader->fill = fill;
+    loader->source_data = source_data;
+    // No epoch has been started, so there is nothing to take.
+    loader->epoch_loaded = 1;
+    pthread_mutex_init(&loader->mutex, NULL);
+    pthread_cond_init(&loader->cond, NULL);
+    cnd_make_error(pthread_create(&loader->thread, NULL, data_loader_thread, loader) != 0, "Failed to create data loader thread.");
+    return loader;
+}
+
+void data_loader_delete(data_loader_t *loader) {
+    pthread_mutex_lock(&loader->mutex);
+    loader->stop = 1;
+    pthread_cond_broadcast(&loader->cond);
+    pthread_mutex_unlock(&loader->mutex);
+    pthread_join(loader->thread, NULL);
+
+    pthread_mutex_destroy(&loader->mutex);
+    pthread_cond_destroy(&loader->cond);
+    free(loader->slot_data);
+    free(loader->slot_cases);
+    free(loader->slot_free);
+    free(loader);
+}
+
+void data_loader_start_epoch(data_loader_t *loader) {
+    pthread_mutex_lock(&loader->mutex);
+    cnd_make_error(!loader->epoch_loaded || loader->head != loader->tail, "A data loader's epoch must be taken to its end before the next is started.");
+    loader->epoch_loaded = 0;
+    loader->epoch++;
+    pthread_cond_broadcast(&loader->cond);
+    pthread_mutex_unlock(&loader->mutex);
+}
+
+int data_loader_acquire(data_loader_t *loader, int *n_cases) {
+    pthread_mutex_lock(&loader->mutex);
+    if (loader->head == loader->tail && !loader->epoch_loaded) {
+        double start = timer_seconds();
+        while (loader->head == loader->tail && !loader->epoch_loaded)
+            pthread_cond_wait(&loader->cond, &loader->mutex);
+        loader->stall_seconds += timer_seconds() - start;
+    }
+    if (loader->head == loader->tail) {
+        pthread_mutex_unlock(&loader->mutex);
+        *n_cases = 0;
+        return -1;
+    }
+    int slot = (int)(loader->head % loader->n_slots);
+    loader->head++;
+    *n_cases = loader->slot_cases[slot];
+    pthread_mutex_unlock(&loader->mutex);
+    return slot;
+}
+
+void data_loader_release(data_loader_t *loader, int slot) {
+    pthread_mutex_lock(&loader->mutex);
+    loader->slot_free[slot] = 1;
+    pthread_cond_broadcast(&loader->cond);
+    pthread_mutex_unlock(&loader->mutex);
+}
+
+void *data_loader_slot(data_loader_t *loader, int slot) {
+    return loader->slot_data + (size_t)slot * loader->slot_size;
+}
+
+int data_loader_size(data_loader_t *loader) {
+    return loader->n_slots;
+}
+
+double data_loader_stall_seconds(data_loader_t *loader) {
+    pthread_mutex_lock(&loader->mutex);
+    double stall_seconds = loader->stall_seconds;
+    pthread_mutex_unlock(&loader->mutex);
+    return stall_seconds;
+}
+
+void data_loader_reset_statistics(data_loader_t *loader) {
+    pthread_mutex_lock(&loader->mutex);
+    loader->stall_seconds = 0;
+    pthread_mutex_unlock(&loader->mutex);
+}
+
+//
+// 'data_loader.c' implementations
+//
+
+/**
+ * The loop of the producer thread, loading each epoch once it is started, until the loader is stopped.
+ * @param loader_ptr Intended to be passed a 'data_loader_t *'.
+*/
+void *data_loader_thread(void *loader_ptr) {
+    data_loader_t *loader = (data_loader_t *)loader_ptr;
+    long long epoch = 0;
+    while (1) {
+        pthread_mutex_lock(&loader->mutex);
+        while (!loader->stop && loader->epoch == epoch)
+            pthread_cond_wait(&loader->cond, &loader->mutex);
+        if (loader->stop) {
+            pthread_mutex_unlock(&loader->mutex);
+            return NULL;
+        }
+        epoch = loader->epoch;
+        pthread_mutex_unlock(&loader->mutex);
+
+        data_loader_run_epoch(loader);
+    }
+}
+
+/**
+ * Load batches into the slots in order, each once its consumer has released it, until the fill function runs out.
+ * The fill function runs without the lock held, so consumers keep taking ready batches while the next loads.
+*/
+void data_loader_run_epoch(data_loader_t *loader) {
+    while (1) {
+        pthread_mutex_lock(&loader->mutex);
+        int slot = (int)(loader->tail % loader->n_slots);
+        while (!loader->stop && !loader->slot_free[slot])
+            pthread_cond_wait(&loader->cond, &loader->mutex);
+        if (loader->stop) {
+            pthread_mutex_unlock(&loader->mutex);
+            return;
+        }
+        pthread_mutex_unlock(&loader->mutex);
+
+        int n_cases = loader->fill(loader->source_data, data_loader_slot(loader, slot));
+
+        pthread_mutex_lock(&loader->mutex);
+        if (n_cases > 0) {
+            loader->slot_free[slot] = 0;
+            loader->slot_cases[slot] = n_cases;
+            loader->tail++;
+        }
+        else {
+            loader->epoch_loaded = 1;
+        }
+        pthread_cond_broadcast(&loader->cond);
+        pthread_mutex_unlock(&loader->mutex);
+        if (n_cases <= 0)
+            return;
+    }
+}
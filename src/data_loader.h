@@ -0,0 +1,92 @@
+#ifndef DATA_LOADER
+#define DATA_LOADER
+
+#include <stddef.h>
+
+//
+// 'data_loader.h' definitions
+//
+
+/**
+ * A background loader of batches, a producer thread filling a ring of batch buffers, its slots, ahead of the threads consuming them.
+ * The producer loads a batch into a free slot with the loader's fill function, which reads, converts and normalizes it however the source needs,
+ * so consumers take a ready batch without waiting on the source, unless the producer has fallen behind.
+ * The batches of an epoch are loaded in order and taken in order, by any number of consumers, each returning its slot once done with it.
+*/
+typedef struct data_loader_t data_loader_t;
+
+/**
+ * Loads the next batch of an epoch into a slot. Only ever called on the loader's producer thread, so the source needs no locking.
+ * @param source_data The data given to 'data_loader_create'.
+ * @param slot The slot's buffer, of the size given to 'data_loader_create', aligned to a cache line.
+ * @return The number of cases loaded, 0 once the epoch has no batches left.
+*/
+typedef int (*data_loader_fill_function_t)(void *source_data, void *slot);
+
+/**
+ * Create a loader and start its producer thread, which waits for the first epoch to be started.
+ * @param n_slots The number of batch buffers, the most batches loaded ahead of the consumers.
+ * @param slot_size The number of bytes of each batch buffer.
+ * @param fill The function loading a batch into a slot.
+ * @param source_data The data passed to the fill function.
+ * @return The loader.
+*/
+data_loader_t *data_loader_create(int n_slots, size_t slot_size, data_loader_fill_function_t fill, void *source_data);
+
+/**
+ * Stop and join the loader's producer thread, and free the loader. Its current epoch, if any, must have been taken to its end.
+ * @param loader The loader to be deleted.
+*/
+void data_loader_delete(data_loader_t *loader);
+
+/**
+ * Start loading an epoch's batches, the fill function being called until it returns 0. The previous epoch must have been taken
+ * to its end and its slots released, and the source reset by the caller.
+ * @param loader The loader.
+*/
+void data_loader_start_epoch(data_loader_t *loader);
+
+/**
+ * Take the next batch of the epoch, waiting while the producer is loading it. Safe to call from several consumers at once.
+ * @param loader The loader.
+ * @param n_cases Set to the number of cases of the batch.
+ * @return The index of the batch's slot, to be given to 'data_loader_release' once done with, or -1 once the epoch has no batches left.
+*/
+int data_loader_acquire(data_loader_t *loader, int *n_cases);
+
+/**
+ * Return a slot to the producer to be loaded again.
+ * @param loader The loader.
+ * @param slot The index of the slot, as returned by 'data_loader_acquire'.
+*/
+void data_loader_release(data_loader_t *loader, int slot);
+
+/**
+ * Get the buffer of a slot.
+ * @param loader The loader.
+ * @param slot The index of the slot, from 0 to the number of slots - 1.
+ * @return The slot's buffer.
+*/
+void *data_loader_slot(data_loader_t *loader, int slot);
+
+/**
+ * Get the number of slots of the loader.
+ * @param loader The loader.
+ * @return The number of slots.
+*/
+int data_loader_size(data_loader_t *loader);
+
+/**
+ * Get the time consumers have spent waiting in 'data_loader_acquire' for a batch to be loaded, since the loader was created or its statistics were reset.
+ * @param loader The loader.
+ * @return The time in seconds, summed over the consumers.
+*/
+double data_loader_stall_seconds(data_loader_t *loader);
+
+/**
+ * Set the loader's stall time back to zero.
+ * @param loader The loader.
+*/
+void data_loader_reset_statistics(data_loader_t *loader);
+
+#endif
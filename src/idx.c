@@ -0,0 +1,108 @@
+#include "idx.h"
+
+#include "error.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//
+// 'idx.c' definitions
+//
+
+// The type byte of an IDX file of unsigned bytes, the only type read.
+#define IDX_TYPE_UNSIGNED_BYTE 0x08
+// The magic number's zero bytes, type byte and number of dimensions.
+#define IDX_MAGIC_SIZE 4
+
+int32_t idx_read_int32(const unsigned char *bytes);
+
+//
+// 'idx.h' implementations
+//
+
+void idx_file_open(idx_file_t *file, const char *filename) {
+    int fd = open(filename, O_RDONLY);
+    cnd_make_error(fd < 0, "IDX file does not exist.");
+    struct stat st;
+    cnd_make_error(fstat(fd, &st) != 0, "Failed to read IDX file's size.");
+    size_t size = (size_t)st.st_size;
+    cnd_make_error(size < IDX_MAGIC_SIZE, "IDX file is too short for its header.");
+    unsigned char *map = (unsigned char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    cnd_make_error(map == MAP_FAILED, "Failed to map IDX file.");
+
+    cnd_make_error(map[0] != 0 || map[1] != 0, "IDX file's magic number does not match.");
+    cnd_make_error(map[2] != IDX_TYPE_UNSIGNED_BYTE, "IDX file is not of unsigned bytes.");
+    int n_dimensions = map[3];
+    cnd_make_error(n_dimensions < 1 || n_dimensions > IDX_MAX_DIMENSIONS, "IDX file lists an unsupported number of dimensions.");
+    size_t header_size = IDX_MAGIC_SIZE + 4 * (size_t)n_dimensions;
+    cnd_make_error(size < header_size, "IDX file is too short for its header.");
+
+    file->map = map;
+    file->map_size = size;
+    file->n_dimensions = n_dimensions;
+    file->item_size = 1;
+    for (int i = 0; i < n_dimensions; i++) {
+        int32_t dimension = idx_read_int32(map + IDX_MAGIC_SIZE + 4*i);
+        cnd_make_error(dimension < 0, "IDX file lists a negative dimension.");
+        file->dimensions[i] = dimension;
+        if (i > 0)
+            file->item_size *= (size_t)dimension;
+    }
+    file->n_items = file->dimensions[0];
+    cnd_make_error((size - header_size) / (file->item_size ? file->item_size : 1) < (size_t)file->n_items, "IDX file is shorter than the items it lists.");
+    file->data = map + header_size;
+}
+
+void idx_file_close(idx_file_t *file) {
+    munmap(file->map, file->map_size);
+    file->map = NULL;
+    file->data = NULL;
+}
+
+const uint8_t *idx_file_item(const idx_file_t *file, int32_t index) {
+    return file->data + (size_t)index * file->item_size;
+}
+
+const uint8_t *idx_file_items(const idx_file_t *file, int32_t start, int count, int *n_items) {
+    int32_t remaining = start < file->n_items ? file->n_items - start : 0;
+    *n_items = remaining < count ? (int)remaining : count;
+    return idx_file_item(file, start);
+}
+
+void idx_dataset_open(idx_dataset_t *dataset, const char *inputs_filename, const char *labels_filename) {
+    idx_file_open(&dataset->inputs, inputs_filename);
+    idx_file_open(&dataset->labels, labels_filename);
+    cnd_make_error(dataset->labels.n_dimensions != 1, "IDX labels are not a byte per case.");
+    cnd_make_error(dataset->inputs.n_items != dataset->labels.n_items, "IDX inputs and labels list different numbers of cases.");
+}
+
+void idx_dataset_close(idx_dataset_t *dataset) {
+    idx_file_close(&dataset->inputs);
+    idx_file_close(&dataset->labels);
+}
+
+idx_batch_t idx_dataset_batch(const idx_dataset_t *dataset, int32_t batch_index, int batch_size) {
+    idx_batch_t batch;
+    int32_t start = batch_index * batch_size;
+    batch.inputs = idx_file_items(&dataset->inputs, start, batch_size, &batch.n_cases);
+    batch.labels = idx_file_item(&dataset->labels, start);
+    return batch;
+}
+
+int32_t idx_dataset_batch_count(const idx_dataset_t *dataset, int batch_size) {
+    return (dataset->inputs.n_items + batch_size - 1) / batch_size;
+}
+
+//
+// 'idx.c' implementations
+//
+
+/**
+ * @return The big-endian 32 bit integer starting at the inputted bytes.
+*/
+int32_t idx_read_int32(const unsigned char *bytes) {
+    return (int32_t)((uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 | (uint32_t)bytes[2] << 8 | (uint32_t)bytes[3]);
+}
@@ -0,0 +1,110 @@
+#ifndef IDX
+#define IDX
+
+#include <stddef.h>
+#include <stdint.h>
+
+//
+// 'idx.h' definitions
+//
+
+// The most dimensions an IDX file may list, its number of items included.
+#define IDX_MAX_DIMENSIONS 8
+
+/**
+ * An IDX file of unsigned bytes, the format of the MNIST dataset, memory mapped read only.
+ * The file lists its number of items followed by the dimensions of each item, any number and size of them,
+ * its header being checked against its size once when opened, so its items can then be viewed by index without copying or locking.
+*/
+typedef struct {
+    unsigned char *map;
+    size_t map_size;
+    // The number of items, followed by the dimensions of each item.
+    int n_dimensions;
+    int32_t dimensions[IDX_MAX_DIMENSIONS];
+    int32_t n_items;
+    // The number of bytes of each item, the product of its dimensions.
+    size_t item_size;
+    const uint8_t *data;
+} idx_file_t;
+
+/**
+ * A dataset of an IDX file of inputs and an IDX file of a byte label per input.
+*/
+typedef struct {
+    idx_file_t inputs;
+    idx_file_t labels;
+} idx_dataset_t;
+
+/**
+ * A view of consecutive cases of a dataset, pointing into its files' mappings.
+*/
+typedef struct {
+    const uint8_t *inputs;
+    const uint8_t *labels;
+    int n_cases;
+} idx_batch_t;
+
+/**
+ * Map an IDX file of unsigned bytes, checking its header and that it holds every item it lists.
+ * @param file The file to be initialized.
+ * @param filename The name of the file.
+*/
+void idx_file_open(idx_file_t *file, const char *filename);
+
+/**
+ * Unmap an IDX file. Views of its items are invalid afterwards.
+ * @param file The file to be closed.
+*/
+void idx_file_close(idx_file_t *file);
+
+/**
+ * View an item of an IDX file.
+ * @param file The file.
+ * @param index The index of the item, from 0 to the number of items - 1.
+ * @return The item's 'item_size' bytes.
+*/
+const uint8_t *idx_file_item(const idx_file_t *file, int32_t index);
+
+/**
+ * View consecutive items of an IDX file.
+ * @param file The file.
+ * @param start The index of the first item.
+ * @param count The most items viewed, fewer once the file runs out.
+ * @param n_items Set to the number of items viewed, 0 when 'start' is past the last item.
+ * @return The items' bytes, one item after the other.
+*/
+const uint8_t *idx_file_items(const idx_file_t *file, int32_t start, int count, int *n_items);
+
+/**
+ * Map an IDX file of inputs and an IDX file of labels, checking the labels are a byte per input.
+ * @param dataset The dataset to be initialized.
+ * @param inputs_filename The name of the inputs' file.
+ * @param labels_filename The name of the labels' file.
+*/
+void idx_dataset_open(idx_dataset_t *dataset, const char *inputs_filename, const char *labels_filename);
+
+/**
+ * Unmap a dataset's files.
+ * @param dataset The dataset to be closed.
+*/
+void idx_dataset_close(idx_dataset_t *dataset);
+
+/**
+ * View a batch of a dataset by index, the batches being consecutive cases from the first, the last batch holding any remainder.
+ * @param dataset The dataset.
+ * @param batch_index The index of the batch.
+ * @param batch_size The number of cases of every batch but the last.
+ * @return The batch's view, of 0 cases when the batch is past the end of the dataset.
+*/
+idx_batch_t idx_dataset_batch(const idx_dataset_t *dataset, int32_t batch_index, int batch_size);
+
+/**
+ * Get the number of batches of a dataset.
+ * @param dataset The dataset.
+ * @param batch_size The number of cases of every batch but the last.
+ * @return The number of batches, the last holding any remainder.
+*/
+int32_t idx_dataset_batch_count(const idx_dataset_t *dataset, int batch_size);
+
+#endif
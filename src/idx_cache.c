@@ -0,0 +1,182 @@
+#include "idx_cache.h"
+
+#include "error.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//
+// 'idx_cache.c' definitions
+//
+
+#define IDX_CACHE_MAGIC 0x43584449u
+#define IDX_CACHE_VERSION 1
+// The largest number of values converted between writes while building a cache.
+#define IDX_CACHE_CHUNK 4096
+
+/**
+ * The header at the start of a cache file, padded to its alignment, the values following it.
+*/
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t type;
+    int32_t n_items;
+    uint64_t item_size;
+    // The key of the source the values were written from.
+    uint64_t source_size;
+    int64_t source_mtime_seconds;
+    int64_t source_mtime_nanoseconds;
+    double scale;
+} idx_cache_header_t;
+
+typedef union {
+    idx_cache_header_t header;
+    unsigned char padding[IDX_CACHE_ALIGNMENT];
+} idx_cache_header_block_t;
+
+void idx_cache_key(idx_cache_header_t *header, const char *source_filename, idx_cache_type_t type, double scale);
+int idx_cache_map(idx_cache_t *cache, const char *cache_filename, const idx_cache_header_t *key);
+void idx_cache_write(const char *source_filename, const char *cache_filename, idx_cache_header_t *key);
+size_t idx_cache_value_size(idx_cache_type_t type);
+
+//
+// 'idx_cache.h' implementations
+//
+
+int idx_cache_open(idx_cache_t *cache, const char *source_filename, const char *cache_filename, idx_cache_type_t type, double scale) {
+    idx_cache_header_t key;
+    idx_cache_key(&key, source_filename, type, scale);
+    if (idx_cache_map(cache, cache_filename, &key))
+        return 1;
+    idx_cache_write(source_filename, cache_filename, &key);
+    cnd_make_error(!idx_cache_map(cache, cache_filename, &key), "Failed to map written IDX cache.");
+    return 0;
+}
+
+void idx_cache_close(idx_cache_t *cache) {
+    munmap(cache->map, cache->map_size);
+    cache->map = NULL;
+    cache->data = NULL;
+}
+
+const float *idx_cache_item_f32(const idx_cache_t *cache, int32_t index) {
+    return (const float *)cache->data + (size_t)index * cache->item_size;
+}
+
+const double *idx_cache_item_f64(const idx_cache_t *cache, int32_t index) {
+    return (const double *)cache->data + (size_t)index * cache->item_size;
+}
+
+//
+// 'idx_cache.c' implementations
+//
+
+/**
+ * Fill a header with what a cache of the source must have been written from, its item counts being filled once the source is read.
+*/
+void idx_cache_key(idx_cache_header_t *header, const char *source_filename, idx_cache_type_t type, double scale) {
+    struct stat st;
+    cnd_make_error(stat(source_filename, &st) != 0, "IDX file does not exist.");
+    memset(header, 0, sizeof(idx_cache_header_t));
+    header->magic = IDX_CACHE_MAGIC;
+    header->version = IDX_CACHE_VERSION;
+    header->type = (uint32_t)type;
+    header->source_size = (uint64_t)st.st_size;
+    header->source_mtime_seconds = (int64_t)st.st_mtim.tv_sec;
+    header->source_mtime_nanoseconds = (int64_t)st.st_mtim.tv_nsec;
+    header->scale = scale;
+}
+
+/**
+ * Map a cache file if it exists, matches the key and holds every value its header lists.
+ * @return 1 if the cache was mapped, 0 otherwise.
+*/
+int idx_cache_map(idx_cache_t *cache, const char *cache_filename, const idx_cache_header_t *key) {
+    int fd = open(cache_filename, O_RDONLY);
+    if (fd < 0)
+        return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(idx_cache_header_block_t)) {
+        close(fd);
+        return 0;
+    }
+    size_t size = (size_t)st.st_size;
+    unsigned char *map = (unsigned char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return 0;
+
+    const idx_cache_header_t *header = (const idx_cache_header_t *)map;
+    int matches = header->magic == key->magic && header->version == key->version && header->type == key->type
+        && header->source_size == key->source_size && header->source_mtime_seconds == key->source_mtime_seconds
+        && header->source_mtime_nanoseconds == key->source_mtime_nanoseconds && header->scale == key->scale
+        && header->n_items >= 0
+        && (size - sizeof(idx_cache_header_block_t)) / idx_cache_value_size(key->type) >= (uint64_t)header->n_items * header->item_size;
+    if (!matches) {
+        munmap(map, size);
+        return 0;
+    }
+    cache->map = map;
+    cache->map_size = size;
+    cache->type = (idx_cache_type_t)header->type;
+    cache->n_items = header->n_items;
+    cache->item_size = (size_t)header->item_size;
+    cache->data = map + sizeof(idx_cache_header_block_t);
+    return 1;
+}
+
+/**
+ * Convert every byte of the source and write the cache, to a temporary file renamed over the cache once complete.
+ * @param key The cache's key, its item counts filled from the source.
+*/
+void idx_cache_write(const char *source_filename, const char *cache_filename, idx_cache_header_t *key) {
+    idx_file_t source;
+    idx_file_open(&source, source_filename);
+    key->n_items = source.n_items;
+    key->item_size = source.item_size;
+
+    // The temporary file is named by process, so processes writing the same cache at once each rename a complete file over it.
+    size_t name_size = strlen(cache_filename) + 32;
+    char *temporary_filename = (char *)malloc(name_size);
+    cnd_make_error(temporary_filename == NULL, "Failed to allocate IDX cache file name.");
+    snprintf(temporary_filename, name_size, "%s.%ld.tmp", cache_filename, (long)getpid());
+    FILE *file = fopen(temporary_filename, "wb");
+    cnd_make_error(file == NULL, "Failed to create IDX cache file.");
+
+    idx_cache_header_block_t block;
+    memset(&block, 0, sizeof(block));
+    block.header = *key;
+    int failed = fwrite(&block, sizeof(block), 1, file) != 1;
+    size_t n_values = (size_t)source.n_items * source.item_size;
+    size_t value_size = idx_cache_value_size((idx_cache_type_t)key->type);
+    double *chunk_f64 = (double *)malloc(IDX_CACHE_CHUNK * sizeof(double));
+    float *chunk_f32 = (float *)malloc(IDX_CACHE_CHUNK * sizeof(float));
+    cnd_make_error(chunk_f64 == NULL || chunk_f32 == NULL, "Failed to allocate IDX cache buffer.");
+    for (size_t start = 0; start < n_values && !failed; start += IDX_CACHE_CHUNK) {
+        size_t n = n_values - start < IDX_CACHE_CHUNK ? n_values - start : IDX_CACHE_CHUNK;
+        for (size_t i = 0; i < n; i++) {
+            chunk_f64[i] = source.data[start + i] / key->scale;
+            chunk_f32[i] = (float)chunk_f64[i];
+        }
+        const void *chunk = key->type == IDX_CACHE_F32 ? (const void *)chunk_f32 : (const void *)chunk_f64;
+        failed = fwrite(chunk, value_size, n, file) != n;
+    }
+    failed |= fclose(file) != 0;
+    cnd_make_error(failed, "Failed to write IDX cache file.");
+    cnd_make_error(rename(temporary_filename, cache_filename) != 0, "Failed to replace IDX cache file.");
+
+    free(chunk_f64);
+    free(chunk_f32);
+    free(temporary_filename);
+    idx_file_close(&source);
+}
+
+size_t idx_cache_value_size(idx_cache_type_t type) {
+    return type == IDX_CACHE_F32 ? sizeof(float) : sizeof(double);
+}
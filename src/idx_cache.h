@@ -0,0 +1,67 @@
+#ifndef IDX_CACHE
+#define IDX_CACHE
+
+#include "idx.h"
+
+//
+// 'idx_cache.h' definitions
+//
+
+// The alignment of a cache file's values, which start on a cache line, as do the mapping's pages.
+#define IDX_CACHE_ALIGNMENT 64
+
+typedef enum {
+    IDX_CACHE_F32,
+    IDX_CACHE_F64
+} idx_cache_type_t;
+
+/**
+ * A memory mapped cache file of the bytes of an IDX file divided by a scale, as floats or doubles, so they are normalized only once.
+ * The cache records the size and modification time of its source, and the type and scale it was written with,
+ * and is written again whenever any of them differ from its source's or those asked for.
+*/
+typedef struct {
+    unsigned char *map;
+    size_t map_size;
+    idx_cache_type_t type;
+    int32_t n_items;
+    // The number of values of each item.
+    size_t item_size;
+    const void *data;
+} idx_cache_t;
+
+/**
+ * Map the cache of an IDX file of unsigned bytes, first writing it if it does not exist or was written from a different source, type or scale.
+ * The cache is written to a temporary file renamed over the cache's name once complete, so readers only ever map complete caches.
+ * @param cache The cache to be initialized.
+ * @param source_filename The name of the IDX file.
+ * @param cache_filename The name of the cache file.
+ * @param type Whether the cache holds floats or doubles.
+ * @param scale The number each byte is divided by.
+ * @return 1 if an existing cache was mapped, 0 if the cache was written.
+*/
+int idx_cache_open(idx_cache_t *cache, const char *source_filename, const char *cache_filename, idx_cache_type_t type, double scale);
+
+/**
+ * Unmap a cache. Views of its items are invalid afterwards.
+ * @param cache The cache to be closed.
+*/
+void idx_cache_close(idx_cache_t *cache);
+
+/**
+ * View an item of a cache of floats.
+ * @param cache The cache, of type 'IDX_CACHE_F32'.
+ * @param index The index of the item, from 0 to the number of items - 1.
+ * @return The item's 'item_size' values.
+*/
+const float *idx_cache_item_f32(const idx_cache_t *cache, int32_t index);
+
+/**
+ * View an item of a cache of doubles.
+ * @param cache The cache, of type 'IDX_CACHE_F64'.
+ * @param index The index of the item, from 0 to the number of items - 1.
+ * @return The item's 'item_size' values.
+*/
+const double *idx_cache_item_f64(const idx_cache_t *cache, int32_t index);
+
+#endif
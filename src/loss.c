@@ -0,0 +1,18 @@
+#include "loss.h"
+
+#include "error.h"
+
+#include <string.h>
+
+//
+// 'loss.h' implementations
+//
+
+loss_t loss_get(const char *name) {
+    if (strcmp(name, "squared_error") == 0)
+        return LOSS_SQUARED_ERROR;
+    if (strcmp(name, "cross_entropy") == 0)
+        return LOSS_CROSS_ENTROPY;
+    make_error("Loss does not exist");
+    return LOSS_SQUARED_ERROR;
+}
@@ -0,0 +1,25 @@
+#ifndef LOSS
+#define LOSS
+
+//
+// 'loss.h' definitions
+//
+
+/**
+ * The losses a network can be trained to minimize, shared by doubles and floats.
+ * 'LOSS_SQUARED_ERROR' is half the squared distance of the outputs from the labels, its gradient the distance times the output activation's derivative.
+ * 'LOSS_CROSS_ENTROPY' is the cross-entropy of the labels and the outputs, for sigmoid or softmax outputs, whose derivative it cancels,
+ * leaving the distance alone. Softmax outputs are always trained with the cross-entropy, see 'activation_function_t'.
+*/
+typedef enum {
+    LOSS_SQUARED_ERROR,
+    LOSS_CROSS_ENTROPY
+} loss_t;
+
+/**
+ * Returns the loss mapped to by the inputted name.
+ * @param name Valid inputs: "squared_error", "cross_entropy".
+*/
+loss_t loss_get(const char *name);
+
+#endif
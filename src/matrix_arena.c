@@ -0,0 +1,136 @@
+#include "matrix_arena.h"
+
+#include "error.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+//
+// 'matrix_arena.c' definitions
+//
+
+struct matrix_arena_block_t {
+    matrix_arena_block_t *next;
+    size_t capacity;
+    unsigned char *data;
+};
+
+// Each thread's scratch arena lives as long as the thread, like the matrix multiplication packing buffers.
+static _Thread_local matrix_arena_t matrix_arena_thread_scratch;
+
+size_t matrix_arena_align(size_t size);
+matrix_arena_block_t *matrix_arena_block_create(size_t capacity);
+
+//
+// 'matrix_arena.h' implementations
+//
+
+matrix_arena_t *matrix_arena_create(size_t capacity) {
+    matrix_arena_t *arena = (matrix_arena_t *)malloc(sizeof(matrix_arena_t));
+    cnd_make_error(arena == NULL, "Failed to allocate matrix arena.");
+    matrix_arena_initialize(arena, capacity);
+    return arena;
+}
+
+void matrix_arena_initialize(matrix_arena_t *arena, size_t capacity) {
+    arena->capacity = capacity ? matrix_arena_align(capacity) : MATRIX_ARENA_DEFAULT_CAPACITY;
+    arena->first = matrix_arena_block_create(arena->capacity);
+    arena->current = arena->first;
+    arena->offset = 0;
+}
+
+void matrix_arena_delete(matrix_arena_t *arena) {
+    matrix_arena_free(arena);
+    free(arena);
+}
+
+void matrix_arena_free(matrix_arena_t *arena) {
+    matrix_arena_block_t *block = arena->first;
+    while (block) {
+        matrix_arena_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->offset = 0;
+}
+
+void *matrix_arena_alloc(matrix_arena_t *arena, size_t size) {
+    size = matrix_arena_align(size);
+    if (arena->capacity == 0)
+        arena->capacity = MATRIX_ARENA_DEFAULT_CAPACITY;
+    if (arena->first == NULL) {
+        arena->first = matrix_arena_block_create(size > arena->capacity ? size : arena->capacity);
+        arena->current = arena->first;
+        arena->offset = 0;
+    }
+
+    while (arena->offset + size > arena->current->capacity) {
+        // Move on to the next block if it fits, otherwise put a block that does between this one and the next.
+        matrix_arena_block_t *next = arena->current->next;
+        if (next == NULL || size > next->capacity) {
+            matrix_arena_block_t *block = matrix_arena_block_create(size > arena->capacity ? size : arena->capacity);
+            block->next = next;
+            arena->current->next = block;
+            next = block;
+        }
+        arena->current = next;
+        arena->offset = 0;
+    }
+
+    void *ptr = arena->current->data + arena->offset;
+    arena->offset += size;
+    return ptr;
+}
+
+void matrix_arena_reset(matrix_arena_t *arena) {
+    arena->current = arena->first;
+    arena->offset = 0;
+}
+
+matrix_arena_checkpoint_t matrix_arena_checkpoint(matrix_arena_t *arena) {
+    matrix_arena_checkpoint_t checkpoint = { arena->current, arena->offset };
+    return checkpoint;
+}
+
+void matrix_arena_restore(matrix_arena_t *arena, matrix_arena_checkpoint_t checkpoint) {
+    // A checkpoint taken before the first allocation has no block, which is the same as a reset.
+    if (checkpoint.block == NULL) {
+        matrix_arena_reset(arena);
+        return;
+    }
+    arena->current = checkpoint.block;
+    arena->offset = checkpoint.offset;
+}
+
+size_t matrix_arena_capacity(matrix_arena_t *arena) {
+    size_t capacity = 0;
+    for (matrix_arena_block_t *block = arena->first; block; block = block->next)
+        capacity += block->capacity;
+    return capacity;
+}
+
+matrix_arena_t *matrix_arena_scratch() {
+    return &matrix_arena_thread_scratch;
+}
+
+//
+// 'matrix_arena.c' implementations
+//
+
+size_t matrix_arena_align(size_t size) {
+    return (size + MATRIX_ARENA_ALIGNMENT - 1) & ~(size_t)(MATRIX_ARENA_ALIGNMENT - 1);
+}
+
+/**
+ * Allocate a block with its header in front of the data, padded so the data starts on an aligned address.
+*/
+matrix_arena_block_t *matrix_arena_block_create(size_t capacity) {
+    matrix_arena_block_t *block = (matrix_arena_block_t *)malloc(sizeof(matrix_arena_block_t) + MATRIX_ARENA_ALIGNMENT + capacity);
+    cnd_make_error(block == NULL, "Failed to allocate matrix arena block.");
+    block->next = NULL;
+    block->capacity = capacity;
+    block->data = (unsigned char *)(((uintptr_t)(block + 1) + MATRIX_ARENA_ALIGNMENT - 1) & ~(uintptr_t)(MATRIX_ARENA_ALIGNMENT - 1));
+    return block;
+}
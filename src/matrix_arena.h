@@ -0,0 +1,104 @@
+#ifndef MATRIX_ARENA
+#define MATRIX_ARENA
+
+#include <stddef.h>
+
+//
+// 'matrix_arena.h' definitions
+//
+
+// Every allocation from an arena starts on a cache line, which is also the widest vector register.
+#define MATRIX_ARENA_ALIGNMENT 64
+// The size of the first block of an arena created with a capacity of 0, such as a zero-initialized arena.
+#define MATRIX_ARENA_DEFAULT_CAPACITY 65536
+
+typedef struct matrix_arena_block_t matrix_arena_block_t;
+
+/**
+ * A bump allocator. Allocations are carved out of large blocks and are only released all at once, by 'matrix_arena_reset' or 'matrix_arena_restore'.
+ * When a block runs out, the next is reused or a new one is allocated, so once an arena has grown to fit a workload, repeating it allocates nothing.
+ * A zero-initialized arena is valid and empty.
+*/
+typedef struct {
+    matrix_arena_block_t *first;
+    matrix_arena_block_t *current;
+    size_t offset;
+    size_t capacity;
+} matrix_arena_t;
+
+/**
+ * A position in an arena to return to, releasing every allocation made after it.
+*/
+typedef struct {
+    matrix_arena_block_t *block;
+    size_t offset;
+} matrix_arena_checkpoint_t;
+
+/**
+ * Create an arena whose first block holds the inputted number of bytes.
+ * @param capacity The size in bytes of the arena's first block, and of every block added later unless a larger allocation needs more.
+ * @return An empty arena.
+*/
+matrix_arena_t *matrix_arena_create(size_t capacity);
+
+/**
+ * Initialize an arena in place, giving it a first block of the inputted number of bytes.
+ * @param arena The arena to be initialized.
+ * @param capacity The size in bytes of the arena's blocks.
+*/
+void matrix_arena_initialize(matrix_arena_t *arena, size_t capacity);
+
+/**
+ * Free every block of an arena created with 'matrix_arena_create', and the arena itself.
+ * @param arena The arena to be deleted.
+*/
+void matrix_arena_delete(matrix_arena_t *arena);
+
+/**
+ * Free every block of an arena, leaving it empty but valid. Intended for arenas initialized with 'matrix_arena_initialize' or zero-initialized.
+ * @param arena The arena to be freed.
+*/
+void matrix_arena_free(matrix_arena_t *arena);
+
+/**
+ * Allocate from the arena.
+ * @param arena The arena to allocate from.
+ * @param size The number of bytes to allocate.
+ * @return A pointer aligned to MATRIX_ARENA_ALIGNMENT, valid until the arena is reset or restored to before this allocation.
+*/
+void *matrix_arena_alloc(matrix_arena_t *arena, size_t size);
+
+/**
+ * Release every allocation of the arena, keeping its blocks for reuse.
+ * @param arena The arena to be reset.
+*/
+void matrix_arena_reset(matrix_arena_t *arena);
+
+/**
+ * Get the arena's current position, to later release everything allocated after it.
+ * @param arena The arena.
+ * @return The checkpoint to pass to 'matrix_arena_restore'.
+*/
+matrix_arena_checkpoint_t matrix_arena_checkpoint(matrix_arena_t *arena);
+
+/**
+ * Release every allocation made since the checkpoint was taken, keeping the blocks for reuse.
+ * @param arena The arena the checkpoint was taken from.
+ * @param checkpoint The position to return to.
+*/
+void matrix_arena_restore(matrix_arena_t *arena, matrix_arena_checkpoint_t checkpoint);
+
+/**
+ * Get the number of bytes held by the arena's blocks.
+ * @param arena The arena.
+ * @return The total capacity of every block of the arena.
+*/
+size_t matrix_arena_capacity(matrix_arena_t *arena);
+
+/**
+ * Get this thread's scratch arena, used by the library for temporary buffers. Callers take a checkpoint before using it and restore it after.
+ * @return The calling thread's scratch arena.
+*/
+matrix_arena_t *matrix_arena_scratch();
+
+#endif
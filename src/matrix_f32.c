@@ -0,0 +1,11 @@
+#include "matrix_f32.h"
+#include "error.h"
+#include "matrix_gemm.h"
+#include "matrix_kernels.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "template_f32.h"
+#include "matrix_template.inc"
+#include "template_end.h"
@@ -0,0 +1,18 @@
+#ifndef MATRIX_F32
+#define MATRIX_F32
+
+//
+// 'matrix_f32.h' definitions
+//
+
+/**
+ * The single precision matrix library, 'matrix_f32_t' with functions 'matrix_f32_*', mirroring 'matrix.h'.
+*/
+
+#include "matrix_arena.h"
+
+#include "template_f32.h"
+#include "matrix_template.h"
+#include "template_end.h"
+
+#endif
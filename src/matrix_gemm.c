@@ -0,0 +1,53 @@
+#include "matrix_gemm.h"
+
+#include "error.h"
+#include "matrix_kernels.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+//
+// 'matrix_gemm.c' definitions
+//
+
+// Register tile computed by the micro-kernel, rows x columns of C.
+#define GEMM_MR 4
+#define GEMM_NR 8
+// Cache blocks. A (MC x KC) panel stays in L2, a (KC x NR) sliver of B stays in L1, B (KC x NC) panel stays in L3.
+#define GEMM_MC 96
+#define GEMM_KC 256
+#define GEMM_NC 2048
+// Products with fewer multiply-adds than this skip packing, it costs more than it saves.
+#define GEMM_SMALL_FLOPS (48 * 48 * 48)
+// Products with at least this many multiply-adds are split into tiles across the thread pool, below it threading costs more than it saves.
+#define GEMM_PARALLEL_FLOPS (128 * 128 * 128)
+// The number of tiles per thread of the pool, so threads that finish early can steal the remaining tiles.
+#define GEMM_TILES_PER_THREAD 2
+// Products with fewer columns than this are computed a column at a time, the packed path would pad them to GEMM_NR.
+#define GEMM_NARROW_N GEMM_NR
+
+#define GEMM_ALIGNMENT 64
+// Entries the epilogue gathers onto the stack at a time.
+#define GEMM_EPILOGUE_CHUNK 64
+
+static thread_pool_t *matrix_gemm_pool;
+
+//
+// 'matrix_gemm.h' implementations
+//
+
+void matrix_gemm_set_thread_pool(thread_pool_t *pool) {
+    matrix_gemm_pool = pool;
+}
+
+thread_pool_t *matrix_gemm_thread_pool() {
+    return matrix_gemm_pool ? matrix_gemm_pool : thread_pool_default();
+}
+
+#include "template_f64.h"
+#include "matrix_gemm_template.inc"
+#include "template_end.h"
+
+#include "template_f32.h"
+#include "matrix_gemm_template.inc"
+#include "template_end.h"
@@ -0,0 +1,35 @@
+#ifndef MATRIX_GEMM
+#define MATRIX_GEMM
+
+//
+// 'matrix_gemm.h' definitions
+//
+
+#include "thread_pool.h"
+
+/**
+ * Declares 'matrix_gemm' for doubles and 'matrix_f32_gemm' for floats.
+ * Large products are split into tiles of C computed across a thread pool, smaller ones stay on the calling thread.
+*/
+
+/**
+ * Set the thread pool large matrix multiplications are split across. Intended to be set before multiplying, it is not synchronized with running multiplications.
+ * @param pool The pool to use. NULL selects the library's default pool, a pool of size 1 keeps every multiplication on the calling thread.
+*/
+void matrix_gemm_set_thread_pool(thread_pool_t *pool);
+
+/**
+ * Get the thread pool large matrix multiplications are split across.
+ * @return The pool set by 'matrix_gemm_set_thread_pool', otherwise the library's default pool.
+*/
+thread_pool_t *matrix_gemm_thread_pool();
+
+#include "template_f64.h"
+#include "matrix_gemm_template.h"
+#include "template_end.h"
+
+#include "template_f32.h"
+#include "matrix_gemm_template.h"
+#include "template_end.h"
+
+#endif
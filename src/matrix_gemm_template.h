@@ -0,0 +1,64 @@
+//
+// 'matrix_gemm_template.h' definitions
+//
+
+/**
+ * Compute C = alpha * A * B + beta * C, where C has m rows and n columns, and A and B share the inner dimension k.
+ * Every matrix is addressed through a row stride and a column stride, so element (row i, col j) of A is a[i * rsa + j * csa].
+ * If beta is zero, C is not read before it is written.
+ * @param m The number of rows of A and C.
+ * @param n The number of columns of B and C.
+ * @param k The number of columns of A, and rows of B.
+ * @param alpha The scale applied to the product A * B.
+ * @param a The data of matrix A.
+ * @param rsa The row stride of matrix A.
+ * @param csa The column stride of matrix A.
+ * @param b The data of matrix B.
+ * @param rsb The row stride of matrix B.
+ * @param csb The column stride of matrix B.
+ * @param beta The scale applied to matrix C before the product is added.
+ * @param c The data of matrix C. The output matrix.
+ * @param rsc The row stride of matrix C.
+ * @param csc The column stride of matrix C.
+*/
+void TEMPLATE_FN(matrix, gemm)(
+    int m, int n, int k,
+    SCALAR_T alpha,
+    const SCALAR_T *a, int rsa, int csa,
+    const SCALAR_T *b, int rsb, int csb,
+    SCALAR_T beta,
+    SCALAR_T *c, int rsc, int csc
+);
+
+#define GEMM_EPILOGUE_T TEMPLATE_T(matrix_gemm_epilogue)
+
+/**
+ * Work applied to every entry of C as soon as its product is complete, while the entry is still in registers or cache.
+ * With z = (alpha * A * B + beta * C)(i, j) + bias[i], entry (i, j) of C becomes function(z).
+ * Entry (i, j) of D becomes derivative_output(function(z)) if 'derivative_output' is set, which is cheaper for most activations, otherwise derivative(z).
+ * The functions map arrays, 'y[i] = f(x[i])', and are called on short runs of entries.
+ * Any of 'bias', 'function', 'derivative' and 'derivative_output' may be NULL to skip that step, 'd' is only written if a derivative is set.
+*/
+typedef struct {
+    const SCALAR_T *bias;
+    void (*function)(SCALAR_T *y, const SCALAR_T *x, int n);
+    void (*derivative)(SCALAR_T *y, const SCALAR_T *x, int n);
+    void (*derivative_output)(SCALAR_T *y, const SCALAR_T *x, int n);
+    SCALAR_T *d;
+    int rsd;
+    int csd;
+} GEMM_EPILOGUE_T;
+
+/**
+ * Compute C = alpha * A * B + beta * C like 'matrix_gemm', applying the inputted epilogue to every entry of C in the same pass.
+ * @param epilogue The work applied to each finished entry, NULL to behave exactly like 'matrix_gemm'.
+*/
+void TEMPLATE_FN(matrix, gemm_epilogue)(
+    int m, int n, int k,
+    SCALAR_T alpha,
+    const SCALAR_T *a, int rsa, int csa,
+    const SCALAR_T *b, int rsb, int csb,
+    SCALAR_T beta,
+    SCALAR_T *c, int rsc, int csc,
+    const GEMM_EPILOGUE_T *epilogue
+);
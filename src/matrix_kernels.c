@@ -0,0 +1,358 @@
+#include "matrix_kernels.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+//
+// 'matrix_kernels.c' definitions
+//
+
+// The vector kernels are compiled with per-function target attributes, so the rest of the library keeps the baseline instruction set.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  #define MATRIX_KERNELS_X86
+  #include <cpuid.h>
+  #include <immintrin.h>
+#endif
+
+/**
+ * Define the reference kernels, plain loops the compiler is free to vectorize for the baseline instruction set. 'exp' calls the C library.
+*/
+#define MATRIX_KERNELS_SCALAR_DEFINE(isa, T, exp_function) \
+    static void matrix_kernel_add_##isa(T *a, const T *b, int n) { \
+        for (int i = 0; i < n; i++) \
+            a[i] += b[i]; \
+    } \
+    static void matrix_kernel_subtract_##isa(T *a, const T *b, int n) { \
+        for (int i = 0; i < n; i++) \
+            a[i] -= b[i]; \
+    } \
+    static void matrix_kernel_multiply_##isa(T *a, const T *b, int n) { \
+        for (int i = 0; i < n; i++) \
+            a[i] *= b[i]; \
+    } \
+    static void matrix_kernel_copy_##isa(T *dest, const T *src, int n) { \
+        for (int i = 0; i < n; i++) \
+            dest[i] = src[i]; \
+    } \
+    static void matrix_kernel_axpy_##isa(T *y, T alpha, const T *x, int n) { \
+        for (int i = 0; i < n; i++) \
+            y[i] += alpha * x[i]; \
+    } \
+    static void matrix_kernel_exp_##isa(T *y, const T *x, int n) { \
+        for (int i = 0; i < n; i++) \
+            y[i] = exp_function(x[i]); \
+    }
+
+MATRIX_KERNELS_SCALAR_DEFINE(scalar, double, exp)
+MATRIX_KERNELS_SCALAR_DEFINE(scalar_f32, float, expf)
+
+/**
+ * Define the reference optimizer updates, each reading and writing every array once per element.
+*/
+#define MATRIX_KERNELS_OPTIMIZER_SCALAR_DEFINE(isa, T, sqrt_function) \
+    static void matrix_kernel_momentum_##isa(T *w, T *v, const T *g, T lr, T mu, int n) { \
+        for (int i = 0; i < n; i++) { \
+            v[i] = mu * v[i] + g[i]; \
+            w[i] -= lr * v[i]; \
+        } \
+    } \
+    static void matrix_kernel_nesterov_##isa(T *w, T *v, const T *g, T lr, T mu, int n) { \
+        for (int i = 0; i < n; i++) { \
+            v[i] = mu * v[i] + g[i]; \
+            w[i] -= lr * (g[i] + mu * v[i]); \
+        } \
+    } \
+    static void matrix_kernel_rmsprop_##isa(T *w, T *s, const T *g, T lr, T rho, T eps, int n) { \
+        for (int i = 0; i < n; i++) { \
+            s[i] = rho * s[i] + (1 - rho) * g[i] * g[i]; \
+            w[i] -= lr * g[i] / (sqrt_function(s[i]) + eps); \
+        } \
+    } \
+    static void matrix_kernel_adam_##isa(T *w, T *m, T *v, const T *g, T lr, T b1, T b2, T eps, int n) { \
+        for (int i = 0; i < n; i++) { \
+            m[i] = b1 * m[i] + (1 - b1) * g[i]; \
+            v[i] = b2 * v[i] + (1 - b2) * g[i] * g[i]; \
+            w[i] -= lr * m[i] / (sqrt_function(v[i]) + eps); \
+        } \
+    }
+
+MATRIX_KERNELS_OPTIMIZER_SCALAR_DEFINE(scalar, double, sqrt)
+MATRIX_KERNELS_OPTIMIZER_SCALAR_DEFINE(scalar_f32, float, sqrtf)
+
+#ifdef MATRIX_KERNELS_X86
+
+/**
+ * Define the kernels for one instruction set. Full vectors are processed with unaligned loads and stores, the remainder element by element.
+*/
+#define MATRIX_KERNELS_DEFINE(isa, isa_target, T, VT, width, load, store, add, sub, mul, set1) \
+    __attribute__((target(isa_target))) static void matrix_kernel_add_##isa(T *a, const T *b, int n) { \
+        int i = 0; \
+        for (; i + (width) <= n; i += (width)) \
+            store(a + i, add(load(a + i), load(b + i))); \
+        for (; i < n; i++) \
+            a[i] += b[i]; \
+    } \
+    __attribute__((target(isa_target))) static void matrix_kernel_subtract_##isa(T *a, const T *b, int n) { \
+        int i = 0; \
+        for (; i + (width) <= n; i += (width)) \
+            store(a + i, sub(load(a + i), load(b + i))); \
+        for (; i < n; i++) \
+            a[i] -= b[i]; \
+    } \
+    __attribute__((target(isa_target))) static void matrix_kernel_multiply_##isa(T *a, const T *b, int n) { \
+        int i = 0; \
+        for (; i + (width) <= n; i += (width)) \
+            store(a + i, mul(load(a + i), load(b + i))); \
+        for (; i < n; i++) \
+            a[i] *= b[i]; \
+    } \
+    __attribute__((target(isa_target))) static void matrix_kernel_copy_##isa(T *dest, const T *src, int n) { \
+        int i = 0; \
+        for (; i + 2 * (width) <= n; i += 2 * (width)) { \
+            VT lo = load(src + i); \
+            VT hi = load(src + i + (width)); \
+            store(dest + i, lo); \
+            store(dest + i + (width), hi); \
+        } \
+        for (; i < n; i++) \
+            dest[i] = src[i]; \
+    } \
+    __attribute__((target(isa_target))) static void matrix_kernel_axpy_##isa(T *y, T alpha, const T *x, int n) { \
+        VT alpha_v = set1(alpha); \
+        int i = 0; \
+        for (; i + (width) <= n; i += (width)) \
+            store(y + i, add(load(y + i), mul(alpha_v, load(x + i)))); \
+        for (; i < n; i++) \
+            y[i] += alpha * x[i]; \
+    }
+
+MATRIX_KERNELS_DEFINE(sse2, "sse2", double, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_add_pd, _mm_sub_pd, _mm_mul_pd, _mm_set1_pd)
+MATRIX_KERNELS_DEFINE(avx2, "avx2", double, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd, _mm256_sub_pd, _mm256_mul_pd, _mm256_set1_pd)
+MATRIX_KERNELS_DEFINE(avx512, "avx512f", double, __m512d, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd, _mm512_sub_pd, _mm512_mul_pd, _mm512_set1_pd)
+
+MATRIX_KERNELS_DEFINE(sse2_f32, "sse2", float, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_add_ps, _mm_sub_ps, _mm_mul_ps, _mm_set1_ps)
+MATRIX_KERNELS_DEFINE(avx2_f32, "avx2", float, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_add_ps, _mm256_sub_ps, _mm256_mul_ps, _mm256_set1_ps)
+MATRIX_KERNELS_DEFINE(avx512_f32, "avx512f", float, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_add_ps, _mm512_sub_ps, _mm512_mul_ps, _mm512_set1_ps)
+
+/**
+ * Define the optimizer updates for one instruction set, fused so each array is loaded and stored once per element, in the same order of operations
+ * as the reference loops. Full vectors are processed with unaligned loads and stores, the remainder through the reference kernels.
+*/
+#define MATRIX_KERNELS_OPTIMIZER_DEFINE(isa, isa_target, scalar_isa, T, VT, width, load, store, add, sub, mul, div, sqrt, set1) \
+    __attribute__((target(isa_target))) static void matrix_kernel_momentum_##isa(T *w, T *v, const T *g, T lr, T mu, int n) { \
+        VT lr_v = set1(lr); \
+        VT mu_v = set1(mu); \
+        int i = 0; \
+        for (; i + (width) <= n; i += (width)) { \
+            VT v_v = add(mul(mu_v, load(v + i)), load(g + i)); \
+            store(v + i, v_v); \
+            store(w + i, sub(load(w + i), mul(lr_v, v_v))); \
+        } \
+        matrix_kernel_momentum_##scalar_isa(w + i, v + i, g + i, lr, mu, n - i); \
+    } \
+    __attribute__((target(isa_target))) static void matrix_kernel_nesterov_##isa(T *w, T *v, const T *g, T lr, T mu, int n) { \
+        VT lr_v = set1(lr); \
+        VT mu_v = set1(mu); \
+        int i = 0; \
+        for (; i + (width) <= n; i += (width)) { \
+            VT g_v = load(g + i); \
+            VT v_v = add(mul(mu_v, load(v + i)), g_v); \
+            store(v + i, v_v); \
+            store(w + i, sub(load(w + i), mul(lr_v, add(g_v, mul(mu_v, v_v))))); \
+        } \
+        matrix_kernel_nesterov_##scalar_isa(w + i, v + i, g + i, lr, mu, n - i); \
+    } \
+    __attribute__((target(isa_target))) static void matrix_kernel_rmsprop_##isa(T *w, T *s, const T *g, T lr, T rho, T eps, int n) { \
+        VT lr_v = set1(lr); \
+        VT rho_v = set1(rho); \
+        VT rho_c = set1(1 - rho); \
+        VT eps_v = set1(eps); \
+        int i = 0; \
+        for (; i + (width) <= n; i += (width)) { \
+            VT g_v = load(g + i); \
+            VT s_v = add(mul(rho_v, load(s + i)), mul(mul(rho_c, g_v), g_v)); \
+            store(s + i, s_v); \
+            store(w + i, sub(load(w + i), div(mul(lr_v, g_v), add(sqrt(s_v), eps_v)))); \
+        } \
+        matrix_kernel_rmsprop_##scalar_isa(w + i, s + i, g + i, lr, rho, eps, n - i); \
+    } \
+    __attribute__((target(isa_target))) static void matrix_kernel_adam_##isa(T *w, T *m, T *v, const T *g, T lr, T b1, T b2, T eps, int n) { \
+        VT lr_v = set1(lr); \
+        VT b1_v = set1(b1); \
+        VT b1_c = set1(1 - b1); \
+        VT b2_v = set1(b2); \
+        VT b2_c = set1(1 - b2); \
+        VT eps_v = set1(eps); \
+        int i = 0; \
+        for (; i + (width) <= n; i += (width)) { \
+            VT g_v = load(g + i); \
+            VT m_v = add(mul(b1_v, load(m + i)), mul(b1_c, g_v)); \
+            VT v_v = add(mul(b2_v, load(v + i)), mul(mul(b2_c, g_v), g_v)); \
+            store(m + i, m_v); \
+            store(v + i, v_v); \
+            store(w + i, sub(load(w + i), div(mul(lr_v, m_v), add(sqrt(v_v), eps_v)))); \
+        } \
+        matrix_kernel_adam_##scalar_isa(w + i, m + i, v + i, g + i, lr, b1, b2, eps, n - i); \
+    }
+
+MATRIX_KERNELS_OPTIMIZER_DEFINE(sse2, "sse2", scalar, double, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_add_pd, _mm_sub_pd, _mm_mul_pd, _mm_div_pd, _mm_sqrt_pd, _mm_set1_pd)
+MATRIX_KERNELS_OPTIMIZER_DEFINE(avx2, "avx2", scalar, double, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd, _mm256_sub_pd, _mm256_mul_pd, _mm256_div_pd, _mm256_sqrt_pd, _mm256_set1_pd)
+MATRIX_KERNELS_OPTIMIZER_DEFINE(avx512, "avx512f", scalar, double, __m512d, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd, _mm512_sub_pd, _mm512_mul_pd, _mm512_div_pd, _mm512_sqrt_pd, _mm512_set1_pd)
+
+MATRIX_KERNELS_OPTIMIZER_DEFINE(sse2_f32, "sse2", scalar_f32, float, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_add_ps, _mm_sub_ps, _mm_mul_ps, _mm_div_ps, _mm_sqrt_ps, _mm_set1_ps)
+MATRIX_KERNELS_OPTIMIZER_DEFINE(avx2_f32, "avx2", scalar_f32, float, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_add_ps, _mm256_sub_ps, _mm256_mul_ps, _mm256_div_ps, _mm256_sqrt_ps, _mm256_set1_ps)
+MATRIX_KERNELS_OPTIMIZER_DEFINE(avx512_f32, "avx512f", scalar_f32, float, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_add_ps, _mm512_sub_ps, _mm512_mul_ps, _mm512_div_ps, _mm512_sqrt_ps, _mm512_set1_ps)
+
+/**
+ * exp(x) = 2^k * exp(r), where k = round(x / ln(2)) and r = x - k * ln(2), so |r| <= ln(2) / 2.
+ * ln(2) is split into a high part with trailing zero bits, which k multiplies exactly, and a low part, so r carries no cancellation error.
+ * exp(r) is its Taylor polynomial, degree 13 for doubles and 7 for floats, whose truncation error over |r| <= ln(2) / 2 is below half an ulp.
+ * k is rounded by adding 1.5 * 2^mantissa_bits, which leaves k in the low bits of the sum, and 2^k is built by shifting (k + bias) into the exponent.
+ * Inputs are clamped to [-708, 709] for doubles and [-87, 88] for floats, so 2^k stays a normal number.
+ * Measured against the C library over the clamped range, the relative error is below 1 ulp: at most 1.8e-16 for doubles and 1.1e-7 for floats.
+*/
+#define MATRIX_EXP_DEGREE_double 13
+#define MATRIX_EXP_LOG2E_double 1.4426950408889634
+#define MATRIX_EXP_LN2_HI_double 6.93147180369123816490e-01
+#define MATRIX_EXP_LN2_LO_double 1.90821492927058770002e-10
+#define MATRIX_EXP_ROUND_double 6755399441055744.0
+#define MATRIX_EXP_MIN_double -708.0
+#define MATRIX_EXP_MAX_double 709.0
+#define MATRIX_EXP_BIAS_double 1023
+#define MATRIX_EXP_MANTISSA_BITS_double 52
+
+#define MATRIX_EXP_DEGREE_float 7
+#define MATRIX_EXP_LOG2E_float 1.44269504f
+#define MATRIX_EXP_LN2_HI_float 0.693359375f
+#define MATRIX_EXP_LN2_LO_float -2.12194440e-4f
+#define MATRIX_EXP_ROUND_float 12582912.0f
+#define MATRIX_EXP_MIN_float -87.0f
+#define MATRIX_EXP_MAX_float 88.0f
+#define MATRIX_EXP_BIAS_float 127
+#define MATRIX_EXP_MANTISSA_BITS_float 23
+
+// 1/i! for i = degree..0, the Taylor coefficients in Horner order.
+static const double matrix_exp_coefficients_double[MATRIX_EXP_DEGREE_double + 1] = {
+    1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0,
+    1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 1.0 / 2.0, 1.0, 1.0
+};
+static const float matrix_exp_coefficients_float[MATRIX_EXP_DEGREE_float + 1] = {
+    1.0f / 5040.0f, 1.0f / 720.0f, 1.0f / 120.0f, 1.0f / 24.0f, 1.0f / 6.0f, 1.0f / 2.0f, 1.0f, 1.0f
+};
+
+/**
+ * Define the vectorized 'exp' kernel for one instruction set. The vectors are GCC vector extensions, lowered to the instruction set of the target attribute.
+ * The remainder is padded into one more full vector, so every entry goes through the same instructions.
+*/
+#define MATRIX_KERNELS_EXP_DEFINE(isa, isa_target, T, IT, width) \
+    typedef T matrix_exp_vector_##isa __attribute__((vector_size((width) * sizeof(T)))); \
+    typedef IT matrix_exp_bits_##isa __attribute__((vector_size((width) * sizeof(T)))); \
+    __attribute__((target(isa_target))) static inline matrix_exp_vector_##isa matrix_exp_vector_##isa##_apply(matrix_exp_vector_##isa x) { \
+        matrix_exp_vector_##isa min = (matrix_exp_vector_##isa){ 0 } + MATRIX_EXP_MIN_##T; \
+        matrix_exp_vector_##isa max = (matrix_exp_vector_##isa){ 0 } + MATRIX_EXP_MAX_##T; \
+        matrix_exp_bits_##isa below = x < min; \
+        matrix_exp_bits_##isa above = x > max; \
+        x = (matrix_exp_vector_##isa)(((matrix_exp_bits_##isa)x & ~below) | ((matrix_exp_bits_##isa)min & below)); \
+        x = (matrix_exp_vector_##isa)(((matrix_exp_bits_##isa)x & ~above) | ((matrix_exp_bits_##isa)max & above)); \
+        matrix_exp_vector_##isa shifted = x * MATRIX_EXP_LOG2E_##T + MATRIX_EXP_ROUND_##T; \
+        matrix_exp_vector_##isa k = shifted - MATRIX_EXP_ROUND_##T; \
+        matrix_exp_vector_##isa r = x - k * MATRIX_EXP_LN2_HI_##T; \
+        r = r - k * MATRIX_EXP_LN2_LO_##T; \
+        matrix_exp_vector_##isa p = (matrix_exp_vector_##isa){ 0 } + matrix_exp_coefficients_##T[0]; \
+        for (int c = 1; c <= MATRIX_EXP_DEGREE_##T; c++) \
+            p = p * r + matrix_exp_coefficients_##T[c]; \
+        matrix_exp_bits_##isa scale = ((matrix_exp_bits_##isa)shifted + MATRIX_EXP_BIAS_##T) << MATRIX_EXP_MANTISSA_BITS_##T; \
+        return p * (matrix_exp_vector_##isa)scale; \
+    } \
+    __attribute__((target(isa_target))) static void matrix_kernel_exp_##isa(T *y, const T *x, int n) { \
+        matrix_exp_vector_##isa v; \
+        int i = 0; \
+        for (; i + (width) <= n; i += (width)) { \
+            memcpy(&v, x + i, sizeof(v)); \
+            v = matrix_exp_vector_##isa##_apply(v); \
+            memcpy(y + i, &v, sizeof(v)); \
+        } \
+        if (i < n) { \
+            v = (matrix_exp_vector_##isa){ 0 }; \
+            memcpy(&v, x + i, (n - i) * sizeof(T)); \
+            v = matrix_exp_vector_##isa##_apply(v); \
+            memcpy(y + i, &v, (n - i) * sizeof(T)); \
+        } \
+    }
+
+MATRIX_KERNELS_EXP_DEFINE(sse2, "sse2", double, int64_t, 2)
+MATRIX_KERNELS_EXP_DEFINE(avx2, "avx2", double, int64_t, 4)
+MATRIX_KERNELS_EXP_DEFINE(avx512, "avx512f", double, int64_t, 8)
+
+MATRIX_KERNELS_EXP_DEFINE(sse2_f32, "sse2", float, int32_t, 4)
+MATRIX_KERNELS_EXP_DEFINE(avx2_f32, "avx2", float, int32_t, 8)
+MATRIX_KERNELS_EXP_DEFINE(avx512_f32, "avx512f", float, int32_t, 16)
+
+// CPUID.1:EDX
+#define CPUID_SSE2 (1u << 26)
+// CPUID.1:ECX
+#define CPUID_OSXSAVE (1u << 27)
+#define CPUID_AVX (1u << 28)
+// CPUID.(7,0):EBX
+#define CPUID_AVX2 (1u << 5)
+#define CPUID_AVX512F (1u << 16)
+// XCR0, the register states the operating system saves on a context switch.
+#define XCR0_SSE_AVX 0x06u
+#define XCR0_AVX512 0xE0u
+
+unsigned int matrix_xgetbv();
+
+#endif
+
+//
+// 'matrix_kernels.h' implementations
+//
+
+int matrix_isa_supported(matrix_isa_t isa) {
+    if (isa == MATRIX_ISA_SCALAR)
+        return 1;
+#ifdef MATRIX_KERNELS_X86
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return 0;
+    if (isa == MATRIX_ISA_SSE2)
+        return (edx & CPUID_SSE2) != 0;
+
+    // Wider registers also need the operating system to preserve them.
+    if (!(ecx & CPUID_OSXSAVE) || !(ecx & CPUID_AVX))
+        return 0;
+    unsigned int xcr0 = matrix_xgetbv();
+    if ((xcr0 & XCR0_SSE_AVX) != XCR0_SSE_AVX)
+        return 0;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return 0;
+    if (isa == MATRIX_ISA_AVX2)
+        return (ebx & CPUID_AVX2) != 0;
+    if (isa == MATRIX_ISA_AVX512)
+        return (ebx & CPUID_AVX512F) != 0 && (xcr0 & XCR0_AVX512) == XCR0_AVX512;
+#endif
+    return 0;
+}
+
+//
+// 'matrix_kernels.c' implementations
+//
+
+#ifdef MATRIX_KERNELS_X86
+unsigned int matrix_xgetbv() {
+    unsigned int eax, edx;
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return eax;
+}
+#endif
+
+#include "template_f64.h"
+#include "matrix_kernels_template.inc"
+#include "template_end.h"
+
+#include "template_f32.h"
+#include "matrix_kernels_template.inc"
+#include "template_end.h"
@@ -0,0 +1,36 @@
+#ifndef MATRIX_KERNELS
+#define MATRIX_KERNELS
+
+//
+// 'matrix_kernels.h' definitions
+//
+
+/**
+ * The instruction sets element-wise kernels are compiled for, in order of increasing vector width.
+*/
+typedef enum {
+    MATRIX_ISA_SCALAR,
+    MATRIX_ISA_SSE2,
+    MATRIX_ISA_AVX2,
+    MATRIX_ISA_AVX512,
+    MATRIX_ISA_COUNT
+} matrix_isa_t;
+
+/**
+ * Check, through CPUID, whether the host CPU and operating system support the inputted instruction set.
+ * @param isa The instruction set to check.
+ * @return Non-zero if kernels for the instruction set were compiled in and can run on this host.
+*/
+int matrix_isa_supported(matrix_isa_t isa);
+
+// 'matrix_kernels_t' with 'matrix_kernels_get' and 'matrix_kernels' for doubles.
+#include "template_f64.h"
+#include "matrix_kernels_template.h"
+#include "template_end.h"
+
+// 'matrix_kernels_f32_t' with 'matrix_f32_kernels_get' and 'matrix_f32_kernels' for floats.
+#include "template_f32.h"
+#include "matrix_kernels_template.h"
+#include "template_end.h"
+
+#endif
@@ -0,0 +1,49 @@
+//
+// 'matrix_kernels_template.h' definitions
+//
+
+#define MATRIX_KERNELS_T TEMPLATE_T(matrix_kernels)
+
+/**
+ * A table of element-wise kernels over contiguous arrays of length 'n', all compiled for the same instruction set.
+*/
+typedef struct {
+    matrix_isa_t isa;
+    const char *name;
+    /** a[i] += b[i] */
+    void (*add)(SCALAR_T *a, const SCALAR_T *b, int n);
+    /** a[i] -= b[i] */
+    void (*subtract)(SCALAR_T *a, const SCALAR_T *b, int n);
+    /** a[i] *= b[i] */
+    void (*multiply)(SCALAR_T *a, const SCALAR_T *b, int n);
+    /** dest[i] = src[i] */
+    void (*copy)(SCALAR_T *dest, const SCALAR_T *src, int n);
+    /** y[i] += alpha * x[i] */
+    void (*axpy)(SCALAR_T *y, SCALAR_T alpha, const SCALAR_T *x, int n);
+    /** y[i] = exp(x[i]), y may equal x. Vectorized kernels have a relative error below 1 ulp, see 'matrix_kernels.c'. */
+    void (*exp)(SCALAR_T *y, const SCALAR_T *x, int n);
+    /** Fused momentum update of weights w with velocity v and gradient g, v[i] = mu * v[i] + g[i], w[i] -= lr * v[i] */
+    void (*momentum)(SCALAR_T *w, SCALAR_T *v, const SCALAR_T *g, SCALAR_T lr, SCALAR_T mu, int n);
+    /** Fused Nesterov momentum update, v[i] = mu * v[i] + g[i], w[i] -= lr * (g[i] + mu * v[i]) */
+    void (*nesterov)(SCALAR_T *w, SCALAR_T *v, const SCALAR_T *g, SCALAR_T lr, SCALAR_T mu, int n);
+    /** Fused RMSProp update with mean square s, s[i] = rho * s[i] + (1 - rho) * g[i]^2, w[i] -= lr * g[i] / (sqrt(s[i]) + eps) */
+    void (*rmsprop)(SCALAR_T *w, SCALAR_T *s, const SCALAR_T *g, SCALAR_T lr, SCALAR_T rho, SCALAR_T eps, int n);
+    /**
+     * Fused Adam update with first and second moments m and v, m[i] = b1 * m[i] + (1 - b1) * g[i], v[i] = b2 * v[i] + (1 - b2) * g[i]^2,
+     * w[i] -= lr * m[i] / (sqrt(v[i]) + eps). The bias corrections of the moments are folded into 'lr' and 'eps' by the caller.
+    */
+    void (*adam)(SCALAR_T *w, SCALAR_T *m, SCALAR_T *v, const SCALAR_T *g, SCALAR_T lr, SCALAR_T b1, SCALAR_T b2, SCALAR_T eps, int n);
+} MATRIX_KERNELS_T;
+
+/**
+ * Get the kernels compiled for a specific instruction set.
+ * @param isa The instruction set of the kernels.
+ * @return The kernel table, or NULL if the instruction set is not supported on this host.
+*/
+const MATRIX_KERNELS_T *TEMPLATE_FN(matrix, kernels_get)(matrix_isa_t isa);
+
+/**
+ * Get the widest kernels supported on this host. The choice is made once, on first use.
+ * @return The kernel table used by the matrix library.
+*/
+const MATRIX_KERNELS_T *TEMPLATE_FN(matrix, kernels)();
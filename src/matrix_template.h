@@ -0,0 +1,289 @@
+//
+// 'matrix_template.h' definitions
+//
+
+/**
+ * Declarations of the matrix library for one scalar type. Included by 'matrix.h' and 'matrix_f32.h' with the template parameters set.
+*/
+
+#define MATRIX_T TEMPLATE_T(matrix)
+#define MATRIX_MAP_T TEMPLATE_T(matrix_map)
+#define MATRIX_BATCH_MAP_T TEMPLATE_T(matrix_batch_map)
+#define MATRIX_FN(name) TEMPLATE_FN(matrix, name)
+
+/**
+ * A function which takes a matrix entry and returns another matrix entry.
+*/
+typedef SCALAR_T (*MATRIX_MAP_T)(SCALAR_T);
+
+/**
+ * A function which maps every entry of array x into array y, both of length n. y may equal x.
+*/
+typedef void (*MATRIX_BATCH_MAP_T)(SCALAR_T *y, const SCALAR_T *x, int n);
+
+/**
+ *  @brief A 2D matrix.
+ *  Entries are stored row by row. A matrix can also be a view into another matrix's data, through a stride and a transposed flag.
+ *  'stride' is the distance in the data array between consecutive stored rows, 0 meaning the rows are packed.
+ *  If 'transposed' is set, the stored rows are the matrix's columns.
+ *  Views do not own their data and must not be deleted.
+*/
+typedef struct {
+    int cols;
+    int rows;
+    SCALAR_T *data;
+    int stride;
+    int transposed;
+} MATRIX_T;
+
+/**
+ * Create a matrix with the inputted number of columns and rows.
+ * @param cols The number of columns of the returned matrix.
+ * @param rows The number of rows of the returned matrix.
+ * @returns A matrix with the inputted number of columns and rows.
+*/
+MATRIX_T *MATRIX_FN(create)(int cols, int rows);
+
+/**
+ * Modify the inputted matrix to have the entered columns and rows, giving it a newly allocated data array.
+ * @param mat The matrix to be modified.
+ * @param cols The number of columns for the entered matrix.
+ * @param rows The number of rows for the entered matrix.
+ */
+void MATRIX_FN(create_i)(MATRIX_T *mat, int cols, int rows);
+
+/**
+ * Create a matrix with the inputted number of columns and rows, with the matrix and its data allocated from the arena.
+ * The matrix must not be deleted, it is released with the arena.
+ * @param cols The number of columns of the returned matrix.
+ * @param rows The number of rows of the returned matrix.
+ * @param arena The arena to allocate from.
+ * @returns A matrix with the inputted number of columns and rows.
+*/
+MATRIX_T *MATRIX_FN(create_from_arena)(int cols, int rows, matrix_arena_t *arena);
+
+/**
+ * Modify the inputted matrix to have the entered columns and rows, giving it a data array allocated from the arena.
+ * The data must not be freed, it is released with the arena.
+ * @param mat The matrix to be modified.
+ * @param cols The number of columns for the entered matrix.
+ * @param rows The number of rows for the entered matrix.
+ * @param arena The arena to allocate from.
+ */
+void MATRIX_FN(create_i_from_arena)(MATRIX_T *mat, int cols, int rows, matrix_arena_t *arena);
+
+/**
+ * Initialize a matrix with the inputted columns and rows, with data from the inputted array and offset.
+ * Increments the offset by the size of the array (cols * rows).
+ * @param mat The matrix to be initialized.
+ * @param cols The columns of the matrix.
+ * @param rows The rows of the matrix.
+ * @param array The array containing the data of the matrix.
+ * @param offset The position in the array of the matrix's data. It gets incremented by (cols * rows).
+*/
+void MATRIX_FN(initialize_from_array)(MATRIX_T *mat, int cols, int rows, SCALAR_T *array, int *offset);
+
+/**
+ * Initialize an array of matrices with the same inputted columns and rows, with data from the inputted array.
+ * @param mat The array of matrices to be initialized.
+ * @param num_matrices The number of matrices in the array to be initialized.
+ * @param cols The columns of every matrix in the array.
+ * @param rows The rows of every matrix in the array.
+ * @param array The array of data to be partitioned between each matrix.
+ */
+void MATRIX_FN(initialize_multiple_from_array)(MATRIX_T *mat, int num_matrices, int cols, int rows, SCALAR_T *array);
+
+/**
+ * Get a view of the inputted matrix's transpose, sharing its data.
+ * @param mat The matrix to be viewed.
+ * @return A matrix with the columns and rows of the inputted matrix swapped.
+*/
+MATRIX_T MATRIX_FN(transpose_view)(MATRIX_T *mat);
+
+/**
+ * Get a view of a block of the inputted matrix, sharing its data.
+ * @param mat The matrix to be viewed.
+ * @param col The column of the block's top left entry.
+ * @param row The row of the block's top left entry.
+ * @param cols The number of columns of the block.
+ * @param rows The number of rows of the block.
+ * @return A matrix of the block's entries.
+*/
+MATRIX_T MATRIX_FN(block_view)(MATRIX_T *mat, int col, int row, int cols, int rows);
+
+/**
+ * Get the distance in the matrix's data array between entries (col, row) and (col, row + 1).
+ * @param mat The matrix.
+ * @return The row stride of the matrix.
+*/
+int MATRIX_FN(row_stride)(MATRIX_T *mat);
+
+/**
+ * Get the distance in the matrix's data array between entries (col, row) and (col + 1, row).
+ * @param mat The matrix.
+ * @return The column stride of the matrix.
+*/
+int MATRIX_FN(col_stride)(MATRIX_T *mat);
+
+/**
+ * Delete the matrix to prevent memory leaks.
+ * @param mat The matrix to be deleted.
+*/
+void MATRIX_FN(delete)(MATRIX_T *mat);
+
+/**
+ * Print the matrix to the console.
+ * @param mat The matrix to be printed.
+*/
+void MATRIX_FN(print)(MATRIX_T *mat);
+
+/**
+ * Print the matrix dimensions to the console.
+ * @param mat The matrix to be printed.
+*/
+void MATRIX_FN(print_short)(MATRIX_T *mat);
+
+/**
+ * Set the element of the matrix at (col, row) to be 'val'.
+ * @param mat The matrix to emplace a value into.
+ * @param col The column of the value to be set.
+ * @param row The row of the value to be set.
+ * @param val The value to be placed at (col, row).
+*/
+void MATRIX_FN(set)(MATRIX_T *mat, int col, int row, SCALAR_T val);
+
+/**
+ * Get the element of the matrix at (col, row).
+ * @param mat The matrix to retrieve an element from.
+ * @param col The column of the matrix entry.
+ * @param row The row of the matrix entry.
+ * @return The value of the matrix at (col, row).
+*/
+SCALAR_T MATRIX_FN(get)(MATRIX_T *mat, int col, int row);
+
+/**
+ * Copy every element of the inputted matrix into a new matrix, which is returned.
+ * @param mat The matrix to be copied.
+ * @return An exact copy of the matrix inputted.
+*/
+MATRIX_T *MATRIX_FN(copy_n)(MATRIX_T *mat);
+
+/**
+ * Copy every element of matrix I into matrix O.
+ * @param mat_I Matrix I.
+ * @param mat_O Matrix O.
+*/
+void MATRIX_FN(copy_o)(MATRIX_T *mat_I, MATRIX_T *mat_O);
+
+/**
+ * Place every element (i,j) of the inputted matrix into a new matrix's (j,i), which is then returned.
+ * @param mat The matrix to be transposed.
+ * @return The matrix transpose of the inputted matrix.
+*/
+MATRIX_T *MATRIX_FN(transpose_n)(MATRIX_T *mat);
+
+/**
+ * Place the matrix transpose of matrix I into matrix O.
+ * @param mat_I Matrix I.
+ * @param mat_O Matrix O. The output matrix.
+*/
+void MATRIX_FN(transpose_o)(MATRIX_T *mat_I, MATRIX_T *mat_O);
+
+/**
+ * Perform a matrix multiplication of matrices A and B and return the result in a new matrix.
+ * The columns of A must equal the rows of B.
+ * @param mat_A Matrix A.
+ * @param mat_B Matrix B.
+ * @return The matrix multiplication of matrices A and B.
+*/
+MATRIX_T *MATRIX_FN(multiply)(MATRIX_T *mat_A, MATRIX_T *mat_B);
+
+/**
+ * Perform a multiplication of matrices A and B and return the result in matrix O.
+ * The columns of A must equal the rows of B.
+ * The dimensions of O must be (B cols, A rows).
+ * @param mat_A Matrix A.
+ * @param mat_B Matrix B.
+ * @param mat_O Matrix O. The output matrix.
+*/
+void MATRIX_FN(multiply_o)(MATRIX_T *mat_A, MATRIX_T *mat_B, MATRIX_T *mat_O);
+
+/**
+ * Perform a multiplication of matrices A and B, scale it and add it onto matrix O.
+ * The columns of A must equal the rows of B.
+ * The dimensions of O must be (B cols, A rows).
+ * @param mat_A Matrix A.
+ * @param mat_B Matrix B.
+ * @param scale The scale applied to the multiplication before it is added.
+ * @param mat_O Matrix O. The output matrix.
+*/
+void MATRIX_FN(multiply_accumulate_o)(MATRIX_T *mat_A, MATRIX_T *mat_B, SCALAR_T scale, MATRIX_T *mat_O);
+
+/**
+ * Scalar multiply every entry of matrix A and matrix B, storing the result in-place in matrix A.
+ * @param mat_A Matrix A.
+ * @param mat_B Matrix B.
+*/
+void MATRIX_FN(multiply_scalar_i)(MATRIX_T *mat_A, MATRIX_T *mat_B);
+
+/**
+ * Multiply matrix A onto matrix B, then add matrix X, returning the result.
+ * @param mat_A Matrix A.
+ * @param mat_B Matrix B.
+ * @param mat_X Matrix X.
+ * @return The matrix multiplication of matrices A and B, added to matrix X.
+*/
+MATRIX_T *MATRIX_FN(multiply_add)(MATRIX_T *mat_A, MATRIX_T *mat_B, MATRIX_T *mat_X);
+
+/**
+ * Add all entries of matrix B to matrix A, in-place in matrix A.
+ * @param mat_A Matrix A. The output matrix.
+ * @param mat_B Matrix B.
+*/
+void MATRIX_FN(add_i)(MATRIX_T *mat_A, MATRIX_T *mat_B);
+
+/**
+ * Subtract all entries of matrix B from matrix A, in-place in matrix A.
+ * @param mat_A Matrix A. The output matrix.
+ * @param mat_B Matrix B.
+*/
+void MATRIX_FN(subtract_i)(MATRIX_T *mat_A, MATRIX_T *mat_B);
+
+/**
+ * Add all entries of matrix B, multiplied by a scale, to matrix A, in-place in matrix A.
+ * @param mat_A Matrix A. The output matrix.
+ * @param mat_B Matrix B.
+ * @param scale The scale applied to every entry of matrix B.
+*/
+void MATRIX_FN(add_scaled_i)(MATRIX_T *mat_A, MATRIX_T *mat_B, SCALAR_T scale);
+
+/**
+ * Apply a function to every entry of a matrix, in-place.
+ * @param mat The target matrix.
+ * @param map The function to apply to every entry of the matrix.
+*/
+void MATRIX_FN(apply_function_i)(MATRIX_T *mat, MATRIX_MAP_T map);
+
+/**
+ * Apply a function to every entry of matrix I, placing the result into matrix O.
+ * @param mat_I Matrix I.
+ * @param map The function to apply to every entry of matrix I.
+ * @param mat_O Matrix O. The output matrix.
+*/
+void MATRIX_FN(apply_function_o)(MATRIX_T *mat_I, MATRIX_MAP_T map, MATRIX_T *mat_O);
+
+/**
+ * Apply an array-at-a-time function to every entry of matrix I, placing the result into matrix O. Matrix O may be matrix I.
+ * @param mat_I Matrix I.
+ * @param map The function applied to runs of contiguous entries of matrix I.
+ * @param mat_O Matrix O. The output matrix.
+*/
+void MATRIX_FN(apply_batch_function_o)(MATRIX_T *mat_I, MATRIX_BATCH_MAP_T map, MATRIX_T *mat_O);
+
+/**
+ * Apply a function to every entry of a matrix, placing the result into a new matrix.
+ * @param mat The target matrix.
+ * @param map The function to apply to every entry of the matrix.
+ * @return The new matrix containing all mapped entries of the inputted matrix.
+*/
+MATRIX_T *MATRIX_FN(apply_function)(MATRIX_T *mat, MATRIX_MAP_T map);
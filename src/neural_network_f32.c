@@ -0,0 +1,12 @@
+#include "neural_network_f32.h"
+
+#include "error.h"
+#include "matrix_gemm.h"
+#include "random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "template_f32.h"
+#include "neural_network_template.inc"
+#include "template_end.h"
@@ -0,0 +1,19 @@
+#ifndef NEURAL_NETWORK_F32
+#define NEURAL_NETWORK_F32
+
+#include "activation_function.h"
+#include "matrix_f32.h"
+
+//
+// 'neural_network_f32.h' Definitions
+//
+
+/**
+ * The single precision neural network, 'neural_network_f32_t' with functions 'neural_network_f32_*', mirroring 'neural_network.h'.
+*/
+
+#include "template_f32.h"
+#include "neural_network_template.h"
+#include "template_end.h"
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef NEURAL_NETWORK_FILE_F32
+#define NEURAL_NETWORK_FILE_F32
+
+#include "neural_network_f32.h"
+
+//
+// 'neural_network_file_f32.h' definitions
+//
+
+/**
+ * Saving and loading of single precision neural networks, mirroring 'neural_network_file.h'.
+ * 'neural_network_f32_load_dynamic' also loads double precision model files, converting them to single precision.
+*/
+
+#include "template_f32.h"
+#include "neural_network_file_template.h"
+#include "template_end.h"
+
+#endif
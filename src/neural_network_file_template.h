@@ -0,0 +1,31 @@
+//
+// 'neural_network_file_template.h' definitions
+//
+
+/**
+ * Save the input, output and hidden layer sizes of the inputted neural network.
+ * @param nn The neural network struct data to be saved.
+ * @param filename The file location where the data is to be saved.
+*/
+void NN_FN(save_static)(NN_T *nn, const char *filename);
+
+/**
+ * Save the input, output and hidden layer sizes of the inputted neural network, as well as all the weights and biases.
+ * The weights and biases are stored at the precision of the neural network.
+ * @param nn The neural network struct data to be saved.
+ * @param filename The file location where the data is to be saved.
+*/
+void NN_FN(save_dynamic)(NN_T *nn, const char *filename);
+
+/**
+ * Load the input, output and hidden layer sizes of a neural network.
+ * @param filename The file location from which the data is loaded.
+*/
+NN_T *NN_FN(load_static)(const char *filename);
+
+/**
+ * Load the input, output and hidden layer sizes of a neural network, as well as all the weights and biases.
+ * Weights and biases saved at a different precision are converted while loading.
+ * @param filename The file location from which the data is loaded.
+*/
+NN_T *NN_FN(load_dynamic)(const char *filename);
@@ -0,0 +1,134 @@
+#include "neural_network_mixed.h"
+
+#include "error.h"
+
+#include <stdlib.h>
+
+//
+// 'neural_network_mixed.c' definitions
+//
+
+void neural_network_mixed_trainer_refresh_array(const double *master, float *copy, int n);
+void neural_network_mixed_trainer_descend_array(double *master, float *copy, const float *g, double p, int n);
+void neural_network_mixed_trainer_widen_array(const float *g_f32, double *g, int n);
+
+//
+// 'neural_network_mixed.h' implementations
+//
+
+void neural_network_mixed_trainer_initialize(neural_network_t *nn, neural_network_mixed_trainer_t *trainer, int batch_size) {
+    trainer->nn = nn;
+    int n_layers = nn->hidden_layer_count + 1;
+    char **activation_function_names = (char **)malloc(n_layers * sizeof(char *));
+    cnd_make_error(activation_function_names == NULL, "Failed to allocate mixed precision trainer.");
+    for (int k = 0; k < n_layers; k++)
+        activation_function_names[k] = nn->layers[k].activation_function.name;
+    trainer->nn_f32 = neural_network_f32_create(nn->input_size, nn->output_size, nn->hidden_layer_count, nn->hidden_layer_sizes, activation_function_names);
+    free(activation_function_names);
+    neural_network_f32_trainer_initialize(trainer->nn_f32, &trainer->trainer, batch_size);
+
+    // The widened gradients mirror the float trainer's, a layer's weights followed by its biases.
+    trainer->gradient_data = (double *)malloc(trainer->trainer.parameter_count * sizeof(double));
+    trainer->gradients = (neural_network_gradient_t *)malloc(n_layers * sizeof(neural_network_gradient_t));
+    cnd_make_error(trainer->gradient_data == NULL || trainer->gradients == NULL, "Failed to allocate mixed precision trainer.");
+    int offset = 0;
+    for (int k = 0; k < n_layers; k++) {
+        matrix_t *weights = &nn->layers[k].weights;
+        matrix_initialize_from_array(&trainer->gradients[k].weights, weights->cols, weights->rows, trainer->gradient_data, &offset);
+        matrix_initialize_from_array(&trainer->gradients[k].biases, 1, weights->rows, trainer->gradient_data, &offset);
+    }
+    trainer->optimizer = NULL;
+    trainer->schedule = NULL;
+    neural_network_mixed_trainer_refresh(trainer);
+}
+
+void neural_network_mixed_trainer_delete(neural_network_mixed_trainer_t *trainer) {
+    neural_network_f32_trainer_delete(&trainer->trainer);
+    neural_network_f32_delete(trainer->nn_f32);
+    free(trainer->gradient_data);
+    free(trainer->gradients);
+    trainer->nn_f32 = NULL;
+    trainer->gradient_data = NULL;
+    trainer->gradients = NULL;
+}
+
+void neural_network_mixed_trainer_refresh(neural_network_mixed_trainer_t *trainer) {
+    neural_network_t *nn = trainer->nn;
+    for (int k = 0; k < nn->hidden_layer_count + 1; k++) {
+        matrix_t *weights = &nn->layers[k].weights;
+        matrix_t *biases = &nn->layers[k].biases;
+        neural_network_mixed_trainer_refresh_array(weights->data, trainer->nn_f32->layers[k].weights.data, weights->cols * weights->rows);
+        neural_network_mixed_trainer_refresh_array(biases->data, trainer->nn_f32->layers[k].biases.data, biases->rows);
+    }
+}
+
+void neural_network_mixed_trainer_gradients(neural_network_mixed_trainer_t *trainer, matrix_f32_t *inputs, matrix_f32_t *labels, int n) {
+    neural_network_f32_trainer_gradients(&trainer->trainer, inputs, labels, n);
+}
+
+void neural_network_mixed_trainer_apply(neural_network_mixed_trainer_t *trainer, double p) {
+    neural_network_t *nn = trainer->nn;
+    neural_network_gradient_f32_t *gradients_f32 = trainer->trainer.gradients;
+    if (trainer->schedule)
+        p *= schedule_next(trainer->schedule);
+    if (trainer->optimizer) {
+        neural_network_mixed_trainer_widen_array(trainer->trainer.gradient_data, trainer->gradient_data, (int)trainer->trainer.parameter_count);
+        neural_network_optimizer_apply(trainer->optimizer, nn, trainer->gradients, p);
+        neural_network_mixed_trainer_refresh(trainer);
+        return;
+    }
+    // Plain gradient descent updates each master weight and its float copy in a single pass.
+    for (int k = 0; k < nn->hidden_layer_count + 1; k++) {
+        matrix_t *weights = &nn->layers[k].weights;
+        matrix_t *biases = &nn->layers[k].biases;
+        neural_network_mixed_trainer_descend_array(weights->data, trainer->nn_f32->layers[k].weights.data, gradients_f32[k].weights.data, p, weights->cols * weights->rows);
+        neural_network_mixed_trainer_descend_array(biases->data, trainer->nn_f32->layers[k].biases.data, gradients_f32[k].biases.data, p, biases->rows);
+    }
+}
+
+void neural_network_mixed_trainer_train_batch(neural_network_mixed_trainer_t *trainer, matrix_f32_t *inputs, matrix_f32_t *labels, int n, double p) {
+    neural_network_f32_trainer_gradients(&trainer->trainer, inputs, labels, n);
+    neural_network_mixed_trainer_apply(trainer, p);
+}
+
+void neural_network_mixed_trainer_train_batch_classes(neural_network_mixed_trainer_t *trainer, matrix_f32_t *inputs, const int *classes, int n, double p) {
+    neural_network_f32_trainer_gradients_classes(&trainer->trainer, inputs, classes, n);
+    neural_network_mixed_trainer_apply(trainer, p);
+}
+
+void neural_network_mixed_trainer_set_optimizer(neural_network_mixed_trainer_t *trainer, neural_network_optimizer_t *optimizer) {
+    trainer->optimizer = optimizer;
+}
+
+void neural_network_mixed_trainer_set_schedule(neural_network_mixed_trainer_t *trainer, schedule_t *schedule) {
+    trainer->schedule = schedule;
+}
+
+void neural_network_mixed_trainer_set_loss(neural_network_mixed_trainer_t *trainer, loss_t loss) {
+    neural_network_f32_trainer_set_loss(&trainer->trainer, loss);
+}
+
+//
+// 'neural_network_mixed.c' implementations
+//
+
+void neural_network_mixed_trainer_refresh_array(const double *master, float *copy, int n) {
+    for (int i = 0; i < n; i++)
+        copy[i] = (float)master[i];
+}
+
+/**
+ * Move the master weights against the float gradients in double precision, and write each updated weight's float copy.
+*/
+void neural_network_mixed_trainer_descend_array(double *master, float *copy, const float *g, double p, int n) {
+    for (int i = 0; i < n; i++) {
+        double w = master[i] - p * (double)g[i];
+        master[i] = w;
+        copy[i] = (float)w;
+    }
+}
+
+void neural_network_mixed_trainer_widen_array(const float *g_f32, double *g, int n) {
+    for (int i = 0; i < n; i++)
+        g[i] = (double)g_f32[i];
+}
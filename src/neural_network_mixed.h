@@ -0,0 +1,108 @@
+#ifndef NEURAL_NETWORK_MIXED
+#define NEURAL_NETWORK_MIXED
+
+#include "neural_network.h"
+#include "neural_network_f32.h"
+#include "neural_network_train.h"
+#include "neural_network_train_f32.h"
+
+//
+// 'neural_network_mixed.h' definitions
+//
+
+/**
+ * A mixed precision trainer of a double precision network, the master weights. Batches are evaluated and their gradients computed
+ * in single precision, on a float copy of the network held by the trainer, and the gradients applied to the master weights in double precision,
+ * so updates too small for a float's precision still accumulate. The float copy is refreshed from the master weights after every update.
+ * Gradients are applied by plain gradient descent, fused with the refresh, unless a double precision optimizer is set, which is applied to
+ * the gradients widened into 'gradients'.
+*/
+typedef struct {
+    neural_network_t *nn;
+    neural_network_f32_t *nn_f32;
+    neural_network_trainer_f32_t trainer;
+    neural_network_gradient_t *gradients;
+    double *gradient_data;
+    neural_network_optimizer_t *optimizer;
+    schedule_t *schedule;
+} neural_network_mixed_trainer_t;
+
+/**
+ * Initialize a mixed precision trainer for the inputted network, creating its float copy and buffers for batches of up to the inputted number of cases.
+ * @param nn The double precision neural network the trainer will train, whose weights are the master weights.
+ * @param trainer The trainer to be initialized.
+ * @param batch_size The largest number of cases trained on at once.
+*/
+void neural_network_mixed_trainer_initialize(neural_network_t *nn, neural_network_mixed_trainer_t *trainer, int batch_size);
+
+/**
+ * Free the float copy and buffers of a mixed precision trainer.
+ * @param trainer The trainer to have its buffers freed.
+*/
+void neural_network_mixed_trainer_delete(neural_network_mixed_trainer_t *trainer);
+
+/**
+ * Copy the master weights into the float copy. Updates through the trainer do this themselves, it is only needed after the master weights are changed otherwise.
+ * @param trainer The trainer of the network.
+*/
+void neural_network_mixed_trainer_refresh(neural_network_mixed_trainer_t *trainer);
+
+/**
+ * Compute the mean gradient of a batch of cases, in single precision, into the float trainer's gradients, leaving the network unchanged.
+ * @param trainer The trainer of the network.
+ * @param inputs The single precision input matrices of the cases. The length of this array should equal 'n'.
+ * @param labels The single precision expected output matrices of the cases. The length of this array should equal 'n'.
+ * @param n The number of cases in the batch, at most the trainer's batch size.
+*/
+void neural_network_mixed_trainer_gradients(neural_network_mixed_trainer_t *trainer, matrix_f32_t *inputs, matrix_f32_t *labels, int n);
+
+/**
+ * Move the master weights against the float trainer's gradients in double precision, through the trainer's optimizer if it has one,
+ * then refresh the float copy. A trainer with a schedule takes the schedule's next step, scaling the training parameter by its factor.
+ * @param trainer The trainer of the network, with its gradients computed.
+ * @param p The training parameter, the learning rate. Weights will be adjusted proportional to this parameter.
+*/
+void neural_network_mixed_trainer_apply(neural_network_mixed_trainer_t *trainer, double p);
+
+/**
+ * Train the master weights on a batch of cases with a single update, computing the batch's mean gradient in single precision then applying it.
+ * @param trainer The trainer of the network.
+ * @param inputs The single precision input matrices of the cases. The length of this array should equal 'n'.
+ * @param labels The single precision expected output matrices of the cases. The length of this array should equal 'n'.
+ * @param n The number of cases in the batch, at most the trainer's batch size.
+ * @param p The training parameter. Weights will be adjusted proportional to this parameter and the batch's mean gradient.
+*/
+void neural_network_mixed_trainer_train_batch(neural_network_mixed_trainer_t *trainer, matrix_f32_t *inputs, matrix_f32_t *labels, int n, double p);
+
+/**
+ * Train the master weights on a batch of cases labelled by class index with a single update, see 'neural_network_f32_trainer_gradients_classes'.
+ * @param trainer The trainer of the network.
+ * @param inputs The single precision input matrices of the cases. The length of this array should equal 'n'.
+ * @param classes The class index of each case, from 0 to the output size - 1. The length of this array should equal 'n'.
+ * @param n The number of cases in the batch, at most the trainer's batch size.
+ * @param p The training parameter. Weights will be adjusted proportional to this parameter and the batch's mean gradient.
+*/
+void neural_network_mixed_trainer_train_batch_classes(neural_network_mixed_trainer_t *trainer, matrix_f32_t *inputs, const int *classes, int n, double p);
+
+/**
+ * Set the double precision optimizer the trainer applies its gradients to the master weights with.
+ * @param trainer The trainer of the network.
+ * @param optimizer The optimizer, initialized for the master network, or NULL to apply gradients by plain gradient descent.
+*/
+void neural_network_mixed_trainer_set_optimizer(neural_network_mixed_trainer_t *trainer, neural_network_optimizer_t *optimizer);
+
+/**
+ * Set the learning rate schedule the trainer's updates follow, see 'neural_network_trainer_set_schedule'.
+ * @param trainer The trainer of the network.
+ * @param schedule The schedule, or NULL to update at the training parameter.
+*/
+void neural_network_mixed_trainer_set_schedule(neural_network_mixed_trainer_t *trainer, schedule_t *schedule);
+
+/**
+ * Set the loss the trainer's batches are trained to minimize, see 'neural_network_trainer_set_loss'.
+ * @param trainer The trainer of the network.
+ * @param loss The loss, see 'loss_t'.
+*/
+void neural_network_mixed_trainer_set_loss(neural_network_mixed_trainer_t *trainer, loss_t loss);
+
+#endif
@@ -0,0 +1,162 @@
+//
+// 'neural_network_template.h' definitions
+//
+
+/**
+ * Declarations of the neural network for one scalar type. Included by 'neural_network.h' and 'neural_network_f32.h' with the template parameters set.
+*/
+
+#define LAYER_T TEMPLATE_T(layer)
+#define NN_T TEMPLATE_T(neural_network)
+#define NN_INFERENCE_CTX_T TEMPLATE_T(neural_network_inference_ctx)
+#define NN_FN(name) TEMPLATE_FN(neural_network, name)
+
+/**
+ * A hidden layer between output layers of the neural network.
+*/
+typedef struct {
+    MATRIX_T weights;
+    MATRIX_T biases;
+    activation_function_t activation_function;
+} LAYER_T;
+
+/**
+ * A struct representing a simple feed-forward neural network.
+*/
+typedef struct {
+    int input_size;
+    int output_size;
+    int hidden_layer_count;
+    int *hidden_layer_sizes;
+    LAYER_T *layers;
+} NN_T;
+
+/**
+ * Storage for inference only evaluation of batches of cases. Holds two activation buffers, each a column per case of the network's widest layer,
+ * which the layers alternate between, so no derivatives or per layer outputs are kept.
+*/
+typedef struct {
+    int batch_size;
+    int widest_layer;
+    SCALAR_T *buffers;
+} NN_INFERENCE_CTX_T;
+
+/**
+ * Create a feed-forward neural network with the given input parameters.
+ * @param input_size The number of rows of the input matrix.
+ * @param output_size The number of rows of the output matrix.
+ * @param hidden_layer_count The number of hidden layers.
+ * @param hidden_layer_sizes The number of rows of each hidden layer output. The length of this array should equal 'hidden_layer_count'.
+ * @param activation_functions The name of activation functions of each hidden layer. The length of this array should equal 'hidden_layer_count+1'.
+ * @return A neural network with undefined weights and biases matching the input parameters.
+*/
+NN_T *NN_FN(create)(int input_size, int output_size, int hidden_layer_count, int *hidden_layer_sizes, char **activation_functions);
+
+/**
+ * Create a feed-forward neural network with the given input parameters, with the network and all of its layers allocated from the arena.
+ * The neural network must not be deleted with 'neural_network_delete', it is released with the arena.
+ * @param input_size The number of rows of the input matrix.
+ * @param output_size The number of rows of the output matrix.
+ * @param hidden_layer_count The number of hidden layers.
+ * @param hidden_layer_sizes The number of rows of each hidden layer output. The length of this array should equal 'hidden_layer_count'.
+ * @param activation_functions The name of activation functions of each hidden layer. The length of this array should equal 'hidden_layer_count+1'.
+ * @param arena The arena to allocate from.
+ * @return A neural network with undefined weights and biases matching the input parameters.
+*/
+NN_T *NN_FN(create_from_arena)(int input_size, int output_size, int hidden_layer_count, int *hidden_layer_sizes, char **activation_functions, matrix_arena_t *arena);
+
+/**
+ * Initialize the neural network's layers' weight and bias matrices from a single array.
+ * @param nn The neural network with layers to be initialized.
+ * @param data The array which will be partitioned for the neural network's weight and bias matrices.
+ * @param activation_function_names The activation function names of each of the neural network's layers.
+ */
+void NN_FN(layers_from_array)(NN_T *nn, SCALAR_T *data, char **activation_function_names);
+
+/**
+ * Delete the inputted neural network to prevent memory leaks. Only intended to delete neural networks allocated by 'neural_network_create'.
+ * @param nn The neural network to be deleted.
+*/
+void NN_FN(delete)(NN_T *nn);
+
+/**
+ * Print the inputted neural network to the console.
+ * @param nn The neural network to be printed to the console.
+*/
+void NN_FN(print)(NN_T *nn);
+
+/**
+ * Randomize all weights and biases of the inputted neural network to be between (-1,1).
+ * @param nn The neural network to be randomized.
+*/
+void NN_FN(layers_randomize)(NN_T *nn);
+
+/**
+ * Compute a layer's activated outputs from its inputs in a single pass, the bias and activation function being applied as each weighted sum is completed.
+ * A softmax layer's outputs are then normalized a case at a time.
+ * @param layer The layer to compute the outputs of.
+ * @param inputs The inputs to the layer, a column per case, with a row per column of the layer's weights.
+ * @param outputs The matrix in which the outputs are placed, with the columns of the inputs and the rows of the layer's weights.
+ * @param derivatives The matrix in which the activation function's derivative at each output is placed, with the dimensions of the outputs. May be NULL if only the outputs are needed.
+*/
+void NN_FN(layer_forward)(LAYER_T *layer, MATRIX_T *inputs, MATRIX_T *outputs, MATRIX_T *derivatives);
+
+/**
+ * Evaluate the inputted neural network against an array of inputs, placing the respective outputs into the outputs array.
+ * @param nn The neural network to compute the inputs against.
+ * @param n_cases The number of input cases to compute.
+ * @param inputs The inputs to be passed to the neural network. The length of this array should equal 'n_cases'.
+ * @param outputs The array of matrices in which the outputs will be placed. The length of this array should equal 'n_cases'.
+*/
+void NN_FN(evaluate)(NN_T *nn, int n_cases, MATRIX_T *inputs, MATRIX_T *outputs);
+
+/**
+ * Get the size of the workspace needed by 'neural_network_evaluate_batch' for batches of up to the inputted number of cases.
+ * @param nn The neural network to be evaluated.
+ * @param batch_size The largest number of cases evaluated at once.
+ * @return The number of scalars the workspace must hold.
+*/
+size_t NN_FN(evaluate_batch_workspace_size)(NN_T *nn, int batch_size);
+
+/**
+ * Evaluate the inputted neural network against a batch of inputs, computing each layer for every case at once with a single matrix multiplication.
+ * The layer outputs are placed in the workspace, so nothing is allocated.
+ * @param nn The neural network to compute the inputs against.
+ * @param inputs The inputs, a column per case, with a row per input of the neural network. A transposed view of a matrix with a row per case avoids copying the inputs.
+ * @param outputs The matrix in which the outputs are placed, a column per case, with a row per output of the neural network.
+ * @param workspace Storage for the hidden layer outputs, holding at least 'neural_network_evaluate_batch_workspace_size(nn, inputs->cols)' scalars.
+*/
+void NN_FN(evaluate_batch)(NN_T *nn, MATRIX_T *inputs, MATRIX_T *outputs, SCALAR_T *workspace);
+
+/**
+ * Initialize an inference context for the inputted network, with buffers for batches of up to the inputted number of cases.
+ * @param nn The neural network the context will evaluate.
+ * @param ctx The inference context to be initialized.
+ * @param batch_size The largest number of cases evaluated at once.
+*/
+void NN_FN(inference_ctx_initialize)(NN_T *nn, NN_INFERENCE_CTX_T *ctx, int batch_size);
+
+/**
+ * Initialize an inference context for the inputted network, with buffers allocated from the arena.
+ * The context must not be deleted with 'neural_network_inference_ctx_delete', it is released with the arena.
+ * @param nn The neural network the context will evaluate.
+ * @param ctx The inference context to be initialized.
+ * @param batch_size The largest number of cases evaluated at once.
+ * @param arena The arena to allocate from.
+*/
+void NN_FN(inference_ctx_initialize_from_arena)(NN_T *nn, NN_INFERENCE_CTX_T *ctx, int batch_size, matrix_arena_t *arena);
+
+/**
+ * Free the buffers of an inference context initialized with 'neural_network_inference_ctx_initialize'.
+ * @param ctx The inference context to have its buffers freed.
+*/
+void NN_FN(inference_ctx_delete)(NN_INFERENCE_CTX_T *ctx);
+
+/**
+ * Evaluate the inputted neural network against a batch of inputs, computing only the layers' activated outputs.
+ * @param nn The neural network to compute the inputs against. Its layers must fit the context's buffers.
+ * @param ctx The inference context whose buffers hold the layer outputs.
+ * @param inputs The inputs, a column per case, with a row per input of the neural network. At most the context's batch size of cases.
+ * @return A view of the outputs in the context's buffers, a column per case, with each case's outputs contiguous. Valid until the context is next used.
+*/
+MATRIX_T NN_FN(inference_evaluate)(NN_T *nn, NN_INFERENCE_CTX_T *ctx, MATRIX_T *inputs);
@@ -0,0 +1,13 @@
+#include "neural_network_train_f32.h"
+#include "error.h"
+#include "matrix_gemm.h"
+#include "matrix_kernels.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "template_f32.h"
+#include "neural_network_train_template.inc"
+#include "template_end.h"
@@ -0,0 +1,24 @@
+#ifndef NEURAL_NETWORK_TRAIN_F32
+#define NEURAL_NETWORK_TRAIN_F32
+
+#include "neural_network_f32.h"
+#include "loss.h"
+#include "optimizer.h"
+#include "pipeline.h"
+#include "process_ring.h"
+#include "schedule.h"
+#include "thread_pool.h"
+
+//
+// 'neural_network_train_f32.h' definitions
+//
+
+/**
+ * Single precision training, 'neural_network_evaluation_f32_t' with functions 'neural_network_f32_*', mirroring 'neural_network_train.h'.
+*/
+
+#include "template_f32.h"
+#include "neural_network_train_template.h"
+#include "template_end.h"
+
+#endif
@@ -0,0 +1,428 @@
+//
+// 'neural_network_train_template.h' definitions
+//
+
+/**
+ * Declarations of neural network training for one scalar type. Included by 'neural_network_train.h' and 'neural_network_train_f32.h' with the template parameters set.
+*/
+
+#define NN_EVAL_LAYER_T TEMPLATE_T(neural_network_evaluation_layer)
+#define NN_EVAL_T TEMPLATE_T(neural_network_evaluation)
+#define NN_TRAIN_CTX_T TEMPLATE_T(neural_network_train_ctx)
+#define NN_GRADIENT_T TEMPLATE_T(neural_network_gradient)
+#define NN_OPTIMIZER_T TEMPLATE_T(neural_network_optimizer)
+#define NN_TRAINER_T TEMPLATE_T(neural_network_trainer)
+#define NN_BATCH_SOURCE_T TEMPLATE_T(neural_network_batch_source)
+#define NN_PIPELINE_T TEMPLATE_T(neural_network_pipeline)
+
+/**
+ * The outputs, activation function derivatives and errors of a layer, each a column with a row per neuron.
+*/
+typedef struct {
+    MATRIX_T outputs;
+    MATRIX_T derivatives;
+    MATRIX_T errors;
+} NN_EVAL_LAYER_T;
+
+typedef struct {
+    NN_EVAL_LAYER_T *layers;
+    SCALAR_T *all_data;
+} NN_EVAL_T;
+
+/**
+ * Storage for training on batches of cases. The inputs and expected outputs of a batch are gathered a case per column,
+ * and each evaluation layer holds the outputs, derivatives and errors of every case of the batch, a column per case.
+ * 'batch_layers' views the columns of 'layers' used by the batch being trained.
+ * A batch given by class index keeps its classes in 'classes' in place of gathering expected outputs, otherwise 'classes' is NULL.
+ * The output errors are the gradient of 'loss', the squared error unless set otherwise.
+*/
+typedef struct {
+    int batch_size;
+    loss_t loss;
+    const int *classes;
+    MATRIX_T input_rows;
+    MATRIX_T expected_rows;
+    NN_EVAL_LAYER_T *layers;
+    NN_EVAL_LAYER_T *batch_layers;
+    SCALAR_T *ones;
+    SCALAR_T *all_data;
+} NN_TRAIN_CTX_T;
+
+/**
+ * The gradient of the loss with respect to a layer's weights and biases, with the dimensions of the layer's matrices.
+*/
+typedef struct {
+    MATRIX_T weights;
+    MATRIX_T biases;
+} NN_GRADIENT_T;
+
+/**
+ * An update rule applied to a network's gradients, with the state it keeps per parameter. The state is 'optimizer_state_count' arrays
+ * of 'parameter_count' scalars one after another in 'state', each laid out like a trainer's 'gradient_data', a layer's weights followed by its biases.
+ * 'step' counts the updates applied, for Adam's bias corrections.
+*/
+typedef struct {
+    optimizer_config_t config;
+    size_t parameter_count;
+    SCALAR_T *state;
+    long long step;
+} NN_OPTIMIZER_T;
+
+/**
+ * A persistent trainer for a network, owning the evaluation of a single case, the buffers of a batch and a gradient per layer,
+ * all allocated when the trainer is initialized, so training through it allocates nothing.
+ * The gradients of every layer are partitioned from the single array 'gradient_data', of 'parameter_count' scalars.
+ * Gradients are applied by plain gradient descent unless an optimizer is set with 'neural_network_trainer_set_optimizer',
+ * at the training parameter passed unless a learning rate schedule is set with 'neural_network_trainer_set_schedule'.
+*/
+typedef struct {
+    NN_T *nn;
+    NN_EVAL_T eval;
+    NN_TRAIN_CTX_T ctx;
+    NN_GRADIENT_T *gradients;
+    SCALAR_T *gradient_data;
+    size_t parameter_count;
+    NN_OPTIMIZER_T *optimizer;
+    schedule_t *schedule;
+} NN_TRAINER_T;
+
+/**
+ * Supplies a worker of parallel training with its next batch of cases. Called concurrently by the workers, so it must be thread safe.
+ * @param source_data The data given to the training function.
+ * @param worker The index of the calling worker, so each worker can be given its own storage for its batch.
+ * @param inputs Set to the input matrices of the batch.
+ * @param labels Set to the expected output matrices of the batch.
+ * @return The number of cases in the batch, at most the batch size of the worker's trainer, or 0 once there are no batches left.
+*/
+typedef int (*NN_BATCH_SOURCE_T)(void *source_data, int worker, MATRIX_T **inputs, MATRIX_T **labels);
+
+/**
+ * Pipeline-parallel training of a network, its layers split into contiguous groups, a stage each, with a thread per stage.
+ * A batch is split into micro-batches which flow forwards through the stages and back, each stage accumulating the gradients of its own layers,
+ * and every stage updates its layers once the batch has flowed back through it. Stage s owns the layers [stage_layers[s], stage_layers[s+1]).
+ * Each micro-batch in flight has a slot, a training context holding its outputs, derivatives and errors at every layer.
+ * The batch being trained is held in 'inputs', 'labels', 'n' and 'p' while the stages run.
+*/
+typedef struct {
+    NN_T *nn;
+    pipeline_t *pipeline;
+    pipeline_schedule_t schedule;
+    int *stage_layers;
+    int micro_batch_size;
+    int max_micro_batches;
+    int n_slots;
+    NN_TRAIN_CTX_T *slots;
+    NN_GRADIENT_T *gradients;
+    SCALAR_T *gradient_data;
+    MATRIX_T *inputs;
+    MATRIX_T *labels;
+    int n;
+    SCALAR_T p;
+} NN_PIPELINE_T;
+
+/**
+ * Initialize the inputted evaluation to have an evaluation layer per hidden / output layer of the inputted network.
+ * @param nn The neural network for the evaluation struct to imitate.
+ * @param eval The neural network evaluation to be modified.
+ */
+void NN_FN(evaluation_initialize)(NN_T *nn, NN_EVAL_T *eval);
+
+/**
+ * Initialize the inputted evaluation to have an evaluation layer per hidden / output layer of the inputted network, allocated from the arena.
+ * The evaluation must not be deleted with 'neural_network_evaluation_delete', it is released with the arena.
+ * @param nn The neural network for the evaluation struct to imitate.
+ * @param eval The neural network evaluation to be modified.
+ * @param arena The arena to allocate from.
+ */
+void NN_FN(evaluation_initialize_from_arena)(NN_T *nn, NN_EVAL_T *eval, matrix_arena_t *arena);
+
+/**
+ * Free the memory referenced in the inputted evaluation struct. Intended to be used with structs initialized with 'neural_network_evaluation_initialize'.
+ * @param eval The evaluation struct to have it's members freed.
+ */
+void NN_FN(evaluation_delete)(NN_EVAL_T eval);
+
+/**
+ * For the given input, get the neural network's output and derivatives at each hidden / output layer.
+ * @param nn The neural network to apply the inputs to.
+ * @param input The input that the neural network generates outputs from.
+ * @param eval The evaluation struct to store the outputs and derivatives in.
+ */
+void NN_FN(evaluation_outputs)(NN_T *nn, MATRIX_T *input, NN_EVAL_T eval);
+
+/**
+ * Given an evaluation struct which contains outputs and derivatives, calculate the errors at each layer using these values, as well as the weights and biases of the inputted neural network.
+ * @param nn The neural network whose weights and biases are used to calculate the evaluation errors.
+ * @param output The output which is compared to the evaluation struct's output layer.
+ * @param eval The evaluation struct to store the errors at each layer.
+ */
+void NN_FN(evaluation_errors)(NN_T *nn, MATRIX_T *output, NN_EVAL_T eval);
+
+/**
+ * Given an evaluations struct which contains the errors of each layer of the neural network, calculate the errors in the inputted neural network's weights and biases, and correct them proportional to the inputted training parameter.
+ * @param nn The neural network to have it's weights and biases corrected.
+ * @param input The input which the neural network is being evaluated against.
+ * @param eval The evaluation struct which contains the errors generated by the neural network.
+ * @param p The training parameter. Errors in the network's weights and biases will be corrected proportional to this value.
+ */
+void NN_FN(evaluation_apply)(NN_T *nn, MATRIX_T *input, NN_EVAL_T eval, SCALAR_T p);
+
+/**
+ * Train the neural network on a single case. Its evaluation is allocated from the calling thread's scratch arena, so once the arena has grown to fit the network, training allocates nothing.
+ * @param nn The neural network to train.
+ * @param input The input matrix to evaluate the neural network on.
+ * @param output The matrix representing the expected output of the neural network.
+ * @param p The training parameter. Weights will be adjusted proportional to this parameter.
+*/
+void NN_FN(train_case)(NN_T *nn, MATRIX_T *input, MATRIX_T *output, SCALAR_T p);
+
+/**
+ * Initialize a training context for the inputted network, with buffers for batches of up to the inputted number of cases.
+ * @param nn The neural network the context will train.
+ * @param ctx The training context to be initialized.
+ * @param batch_size The largest number of cases trained on at once.
+ */
+void NN_FN(train_ctx_initialize)(NN_T *nn, NN_TRAIN_CTX_T *ctx, int batch_size);
+
+/**
+ * Initialize a training context for the inputted network, with buffers allocated from the arena.
+ * The context must not be deleted with 'neural_network_train_ctx_delete', it is released with the arena.
+ * @param nn The neural network the context will train.
+ * @param ctx The training context to be initialized.
+ * @param batch_size The largest number of cases trained on at once.
+ * @param arena The arena to allocate from.
+ */
+void NN_FN(train_ctx_initialize_from_arena)(NN_T *nn, NN_TRAIN_CTX_T *ctx, int batch_size, matrix_arena_t *arena);
+
+/**
+ * Free the buffers of a training context initialized with 'neural_network_train_ctx_initialize'.
+ * @param ctx The training context to have its buffers freed.
+ */
+void NN_FN(train_ctx_delete)(NN_TRAIN_CTX_T *ctx);
+
+/**
+ * Train the neural network on a batch of cases with a single update. The forward pass, the backward pass and the weight gradients
+ * (errors x activations^T) are each a matrix multiplication over the whole batch. The gradients are averaged over the batch.
+ * @param nn The neural network to train.
+ * @param inputs The input matrices of the cases. The length of this array should equal 'n'.
+ * @param labels The expected output matrices of the cases. The length of this array should equal 'n'.
+ * @param n The number of cases in the batch, at most the context's batch size.
+ * @param p The training parameter. Weights will be adjusted proportional to this parameter and the batch's mean gradient.
+ * @param ctx The training context whose buffers hold the batch.
+*/
+void NN_FN(train_batch)(NN_T *nn, MATRIX_T *inputs, MATRIX_T *labels, int n, SCALAR_T p, NN_TRAIN_CTX_T *ctx);
+
+/**
+ * Initialize a trainer for the inputted network, with buffers for single cases and batches of up to the inputted number of cases.
+ * @param nn The neural network the trainer will train.
+ * @param trainer The trainer to be initialized.
+ * @param batch_size The largest number of cases trained on at once.
+ */
+void NN_FN(trainer_initialize)(NN_T *nn, NN_TRAINER_T *trainer, int batch_size);
+
+/**
+ * Initialize a trainer for the inputted network, with buffers allocated from the arena.
+ * The trainer must not be deleted with 'neural_network_trainer_delete', it is released with the arena.
+ * @param nn The neural network the trainer will train.
+ * @param trainer The trainer to be initialized.
+ * @param batch_size The largest number of cases trained on at once.
+ * @param arena The arena to allocate from.
+ */
+void NN_FN(trainer_initialize_from_arena)(NN_T *nn, NN_TRAINER_T *trainer, int batch_size, matrix_arena_t *arena);
+
+/**
+ * Free the buffers of a trainer initialized with 'neural_network_trainer_initialize'.
+ * @param trainer The trainer to have its buffers freed.
+ */
+void NN_FN(trainer_delete)(NN_TRAINER_T *trainer);
+
+/**
+ * Train the trainer's network on a single case, in the trainer's evaluation.
+ * @param trainer The trainer of the network.
+ * @param input The input matrix to evaluate the neural network on.
+ * @param output The matrix representing the expected output of the neural network.
+ * @param p The training parameter. Weights will be adjusted proportional to this parameter.
+*/
+void NN_FN(trainer_train_case)(NN_TRAINER_T *trainer, MATRIX_T *input, MATRIX_T *output, SCALAR_T p);
+
+/**
+ * Compute the mean gradient of a batch of cases into the trainer's gradients, leaving the network unchanged.
+ * @param trainer The trainer of the network.
+ * @param inputs The input matrices of the cases. The length of this array should equal 'n'.
+ * @param labels The expected output matrices of the cases. The length of this array should equal 'n'.
+ * @param n The number of cases in the batch, at most the trainer's batch size.
+*/
+void NN_FN(trainer_gradients)(NN_TRAINER_T *trainer, MATRIX_T *inputs, MATRIX_T *labels, int n);
+
+/**
+ * Compute the mean gradient of a batch of cases labelled by class index into the trainer's gradients, leaving the network unchanged.
+ * The expected outputs are one-hot, 1 at the case's class and 0 elsewhere, and the output errors are computed in a single pass over the outputs.
+ * @param trainer The trainer of the network.
+ * @param inputs The input matrices of the cases. The length of this array should equal 'n'.
+ * @param classes The class index of each case, from 0 to the output size - 1. The length of this array should equal 'n'.
+ * @param n The number of cases in the batch, at most the trainer's batch size.
+*/
+void NN_FN(trainer_gradients_classes)(NN_TRAINER_T *trainer, MATRIX_T *inputs, const int *classes, int n);
+
+/**
+ * Move the trainer's network against the trainer's gradients, through the trainer's optimizer if it has one.
+ * A trainer with a schedule takes the schedule's next step, scaling the training parameter by its factor.
+ * @param trainer The trainer of the network, with its gradients computed.
+ * @param p The training parameter, the learning rate. Weights will be adjusted proportional to this parameter.
+*/
+void NN_FN(trainer_apply)(NN_TRAINER_T *trainer, SCALAR_T p);
+
+/**
+ * Train the trainer's network on a batch of cases with a single update, computing the batch's mean gradient then applying it.
+ * @param trainer The trainer of the network.
+ * @param inputs The input matrices of the cases. The length of this array should equal 'n'.
+ * @param labels The expected output matrices of the cases. The length of this array should equal 'n'.
+ * @param n The number of cases in the batch, at most the trainer's batch size.
+ * @param p The training parameter. Weights will be adjusted proportional to this parameter and the batch's mean gradient.
+*/
+void NN_FN(trainer_train_batch)(NN_TRAINER_T *trainer, MATRIX_T *inputs, MATRIX_T *labels, int n, SCALAR_T p);
+
+/**
+ * Train the trainer's network on a batch of cases labelled by class index with a single update, see 'neural_network_trainer_gradients_classes'.
+ * @param trainer The trainer of the network.
+ * @param inputs The input matrices of the cases. The length of this array should equal 'n'.
+ * @param classes The class index of each case, from 0 to the output size - 1. The length of this array should equal 'n'.
+ * @param n The number of cases in the batch, at most the trainer's batch size.
+ * @param p The training parameter. Weights will be adjusted proportional to this parameter and the batch's mean gradient.
+*/
+void NN_FN(trainer_train_batch_classes)(NN_TRAINER_T *trainer, MATRIX_T *inputs, const int *classes, int n, SCALAR_T p);
+
+/**
+ * Set the loss the trainer's batches are trained to minimize. A network with a softmax output layer is trained with the
+ * cross-entropy whatever the loss set. Single cases trained with 'neural_network_trainer_train_case' use the squared error, or the cross-entropy for softmax outputs.
+ * @param trainer The trainer of the network.
+ * @param loss The loss, see 'loss_t'.
+*/
+void NN_FN(trainer_set_loss)(NN_TRAINER_T *trainer, loss_t loss);
+
+/**
+ * Set the optimizer the trainer applies its gradients with. Trainers of the same network may share an optimizer, as the workers of
+ * parallel training do, and in Hogwild training its state is then updated without locking, racing like the weights.
+ * @param trainer The trainer of the network.
+ * @param optimizer The optimizer, initialized for the trainer's network, or NULL to apply gradients by plain gradient descent.
+*/
+void NN_FN(trainer_set_optimizer)(NN_TRAINER_T *trainer, NN_OPTIMIZER_T *optimizer);
+
+/**
+ * Set the learning rate schedule the trainer's updates follow, each update scaling the training parameter by the schedule's next factor.
+ * Trainers may share a schedule, each update of any of them moving it on a step.
+ * @param trainer The trainer of the network.
+ * @param schedule The schedule, or NULL to update at the training parameter.
+*/
+void NN_FN(trainer_set_schedule)(NN_TRAINER_T *trainer, schedule_t *schedule);
+
+/**
+ * Initialize an optimizer for the inputted network, with its state zeroed.
+ * @param nn The neural network the optimizer will update.
+ * @param optimizer The optimizer to be initialized.
+ * @param config The update rule and its hyper-parameters, see 'optimizer_config_get'.
+*/
+void NN_FN(optimizer_initialize)(NN_T *nn, NN_OPTIMIZER_T *optimizer, optimizer_config_t config);
+
+/**
+ * Free the state of an optimizer.
+ * @param optimizer The optimizer to have its state freed.
+*/
+void NN_FN(optimizer_delete)(NN_OPTIMIZER_T *optimizer);
+
+/**
+ * Zero the optimizer's state and step count, as if it were newly initialized.
+ * @param optimizer The optimizer to be reset.
+*/
+void NN_FN(optimizer_reset)(NN_OPTIMIZER_T *optimizer);
+
+/**
+ * Apply a gradient per layer to the network with the optimizer's update rule, updating each layer's weights, biases and state in a single fused pass.
+ * @param optimizer The optimizer, initialized for the network.
+ * @param nn The neural network to be updated.
+ * @param gradients The gradient of each layer, laid out as a trainer's gradients. The length of this array should equal the hidden layer count + 1.
+ * @param p The training parameter, the learning rate.
+*/
+void NN_FN(optimizer_apply)(NN_OPTIMIZER_T *optimizer, NN_T *nn, NN_GRADIENT_T *gradients, SCALAR_T p);
+
+/**
+ * Train a network Hogwild style. A worker per trainer pulls batches from the source until it is exhausted, and applies each batch's update
+ * to the shared weights and biases without locking, so updates race with the other workers' reads and writes. Each worker evaluates
+ * its batches in its own trainer's buffers and gradients, so the workers share nothing but the network and the source.
+ * @param trainers The trainers of the workers, all of the same network. The length of this array should equal 'n_workers'.
+ * @param n_workers The number of workers.
+ * @param source The function supplying the workers' batches.
+ * @param source_data The data passed to the source.
+ * @param p The training parameter. Weights will be adjusted proportional to this parameter and each batch's mean gradient.
+ * @param pool The pool the workers are run on, or NULL for the default pool. Workers beyond the pool's size start once a thread is free.
+*/
+void NN_FN(train_hogwild)(NN_TRAINER_T *trainers, int n_workers, NN_BATCH_SOURCE_T source, void *source_data, SCALAR_T p, thread_pool_t *pool);
+
+/**
+ * Train a network on a batch of cases synchronously across workers, with a single update. The batch is split into a contiguous shard per worker,
+ * each worker computes its shard's gradient into its own trainer, and the gradients are summed with a tree reduction of fixed order before
+ * being applied by the first trainer. The order of every sum depends only on the number of workers, so for a fixed seed and worker count
+ * the weights are bit-identical from run to run, whatever the size of the pool.
+ * @param trainers The trainers of the workers, all of the same network, with batch sizes of at least 'n' divided by 'n_workers', rounded up. The length of this array should equal 'n_workers'.
+ * @param n_workers The number of workers the batch is split across.
+ * @param inputs The input matrices of the cases. The length of this array should equal 'n'.
+ * @param labels The expected output matrices of the cases. The length of this array should equal 'n'.
+ * @param n The number of cases in the batch.
+ * @param p The training parameter. Weights will be adjusted proportional to this parameter and the batch's mean gradient.
+ * @param pool The pool the workers are run on, or NULL for the default pool.
+*/
+void NN_FN(train_data_parallel)(NN_TRAINER_T *trainers, int n_workers, MATRIX_T *inputs, MATRIX_T *labels, int n, SCALAR_T p, thread_pool_t *pool);
+
+/**
+ * Train the network on a batch of cases as one process of a ring, each process training its own copy of the network on its own shard of the data.
+ * The gradient of each layer is summed across the ring by an all-reduce on the ring's communication thread as soon as it is computed,
+ * overlapping with the backward pass through the earlier layers, and every process applies the same gradient, the mean over every case of every process's batch,
+ * whatever the size of each process's batch. Nothing is applied if every process's batch is empty.
+ * The networks stay identical if they start identical, see 'neural_network_distributed_broadcast'. Every process must call this the same number of times.
+ * @param trainer The trainer of this process's network.
+ * @param ring The ring of processes.
+ * @param inputs The input matrices of the cases. The length of this array should equal 'n'.
+ * @param labels The expected output matrices of the cases. The length of this array should equal 'n'.
+ * @param n The number of cases in the batch, at most the trainer's batch size. May be 0 once this process's shard is exhausted.
+ * @param p The training parameter. Weights will be adjusted proportional to this parameter and the mean gradient.
+*/
+void NN_FN(train_distributed)(NN_TRAINER_T *trainer, process_ring_t *ring, MATRIX_T *inputs, MATRIX_T *labels, int n, SCALAR_T p);
+
+/**
+ * Copy the weights and biases of the first process's network to the networks of every other process of the ring.
+ * @param nn This process's network, of the same shape in every process.
+ * @param ring The ring of processes.
+*/
+void NN_FN(distributed_broadcast)(NN_T *nn, process_ring_t *ring);
+
+/**
+ * Initialize pipeline-parallel training for the inputted network, starting its stages' threads. The layers are split into contiguous groups
+ * of about equal numbers of weights, at least one layer per stage.
+ * @param nn The neural network to train.
+ * @param pipeline The pipeline to be initialized.
+ * @param n_stages The number of stages, at most the number of layers with weights, the hidden layer count + 1.
+ * @param micro_batch_size The number of cases in each micro-batch.
+ * @param max_micro_batches The largest number of micro-batches a batch is split into.
+ * @param schedule The order each stage runs its forward and backward passes in. 'PIPELINE_SCHEDULE_GPIPE' holds a slot for every micro-batch,
+ * 'PIPELINE_SCHEDULE_1F1B' a slot per stage.
+*/
+void NN_FN(pipeline_initialize)(NN_T *nn, NN_PIPELINE_T *pipeline, int n_stages, int micro_batch_size, int max_micro_batches, pipeline_schedule_t schedule);
+
+/**
+ * Stop the pipeline's threads and free its buffers.
+ * @param pipeline The pipeline to be deleted.
+*/
+void NN_FN(pipeline_delete)(NN_PIPELINE_T *pipeline);
+
+/**
+ * Train the pipeline's network on a batch of cases with a single update, the batch split into micro-batches of the pipeline's micro-batch size
+ * which flow through the stages. Every stage sums its gradients over the micro-batches in the same order, so the result does not depend
+ * on the schedule, and matches 'neural_network_trainer_train_batch' up to the order of the sums.
+ * See 'pipeline_bubble_fraction' on 'pipeline->pipeline' for the time the stages spent idle.
+ * @param pipeline The pipeline of the network.
+ * @param inputs The input matrices of the cases. The length of this array should equal 'n'.
+ * @param labels The expected output matrices of the cases. The length of this array should equal 'n'.
+ * @param n The number of cases in the batch, at most the micro-batch size times the largest number of micro-batches.
+ * @param p The training parameter. Weights will be adjusted proportional to this parameter and the batch's mean gradient.
+*/
+void NN_FN(train_pipeline)(NN_PIPELINE_T *pipeline, MATRIX_T *inputs, MATRIX_T *labels, int n, SCALAR_T p);
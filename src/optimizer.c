@@ -0,0 +1,45 @@
+#include "optimizer.h"
+
+#include "error.h"
+
+#include <string.h>
+
+//
+// 'optimizer.h' implementations
+//
+
+optimizer_config_t optimizer_config_get(const char *name) {
+    optimizer_config_t config = { 0 };
+    config.momentum = 0.9;
+    config.decay = 0.9;
+    config.beta1 = 0.9;
+    config.beta2 = 0.999;
+    config.epsilon = 1e-8;
+    if (strcmp(name, "sgd") == 0)
+        config.kind = OPTIMIZER_SGD;
+    else if (strcmp(name, "momentum") == 0)
+        config.kind = OPTIMIZER_MOMENTUM;
+    else if (strcmp(name, "nesterov") == 0)
+        config.kind = OPTIMIZER_NESTEROV;
+    else if (strcmp(name, "rmsprop") == 0)
+        config.kind = OPTIMIZER_RMSPROP;
+    else if (strcmp(name, "adam") == 0)
+        config.kind = OPTIMIZER_ADAM;
+    else {
+        make_error("Optimizer does not exist");
+        return config;
+    }
+    strcpy(config.name, name);
+    return config;
+}
+
+int optimizer_state_count(optimizer_kind_t kind) {
+    switch (kind) {
+        case OPTIMIZER_SGD:
+            return 0;
+        case OPTIMIZER_ADAM:
+            return 2;
+        default:
+            return 1;
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef OPTIMIZER
+#define OPTIMIZER
+
+//
+// 'optimizer.h' definitions
+//
+
+#define OPTIMIZER_NAME_SIZE 16
+
+/**
+ * The update rules a trainer's gradients can be applied with.
+*/
+typedef enum {
+    OPTIMIZER_SGD,
+    OPTIMIZER_MOMENTUM,
+    OPTIMIZER_NESTEROV,
+    OPTIMIZER_RMSPROP,
+    OPTIMIZER_ADAM
+} optimizer_kind_t;
+
+/**
+ * An update rule and its hyper-parameters, shared by doubles and floats. The learning rate is the training parameter passed when training.
+ * 'momentum' is the decay of the velocity of momentum and Nesterov, 'decay' the decay of RMSProp's mean square,
+ * 'beta1' and 'beta2' the decays of Adam's moments, and 'epsilon' keeps RMSProp's and Adam's divisions finite.
+*/
+typedef struct {
+    char name[OPTIMIZER_NAME_SIZE];
+    optimizer_kind_t kind;
+    double momentum;
+    double decay;
+    double beta1;
+    double beta2;
+    double epsilon;
+} optimizer_config_t;
+
+/**
+ * Returns the update rule mapped to by the inputted name, with its usual hyper-parameters.
+ * @param name Valid inputs: "sgd", "momentum", "nesterov", "rmsprop", "adam".
+*/
+optimizer_config_t optimizer_config_get(const char *name);
+
+/**
+ * @return The number of values of state the update rule keeps per parameter, 0 for SGD, 2 for Adam.
+*/
+int optimizer_state_count(optimizer_kind_t kind);
+
+#endif
@@ -0,0 +1,272 @@
+#include "pipeline.h"
+
+#include "error.h"
+#include "timer.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+//
+// 'pipeline.c' definitions
+//
+
+/**
+ * A bounded queue of items from one stage to another, 'head' the next item to receive and 'tail' the next free slot.
+*/
+typedef struct {
+    int *items;
+    int capacity;
+    long long head;
+    long long tail;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} pipeline_queue_t;
+
+/**
+ * A stage's thread, with the index of its stage.
+*/
+typedef struct {
+    pipeline_t *pipeline;
+    int stage;
+} pipeline_worker_t;
+
+struct pipeline_t {
+    int n_stages;
+    // 'forward[s]' carries items from stage s to s+1, 'backward[s]' from stage s+1 to s.
+    pipeline_queue_t *forward;
+    pipeline_queue_t *backward;
+    pthread_t *threads;
+    pipeline_worker_t *workers;
+    // Each run increments 'generation', and the stages' threads run the function once for each increment.
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    long long generation;
+    int n_finished;
+    int stop;
+    pipeline_stage_function_t function;
+    void *data;
+    // Each stage only writes its own entries while running, read once every stage has finished.
+    double *busy_seconds;
+    double *wait_seconds;
+    double wall_seconds;
+};
+
+void pipeline_queue_initialize(pipeline_queue_t *queue, int capacity);
+void pipeline_queue_delete(pipeline_queue_t *queue);
+void pipeline_queue_push(pipeline_queue_t *queue, int item, double *wait_seconds);
+int pipeline_queue_pop(pipeline_queue_t *queue, double *wait_seconds);
+void pipeline_run_stage(pipeline_t *pipeline, int stage);
+void *pipeline_thread(void *worker_ptr);
+
+//
+// 'pipeline.h' implementations
+//
+
+pipeline_t *pipeline_create(int n_stages, int queue_capacity) {
+    cnd_make_error(n_stages < 1 || queue_capacity < 1, "A pipeline needs at least one stage and room for an item in each queue.");
+    pipeline_t *pipeline = (pipeline_t *)calloc(1, sizeof(pipeline_t));
+    cnd_make_error(pipeline == NULL, "Failed to allocate pipeline.");
+    pipeline->n_stages = n_stages;
+    pipeline->forward = (pipeline_queue_t *)malloc(n_stages * sizeof(pipeline_queue_t));
+    pipeline->backward = (pipeline_queue_t *)malloc(n_stages * sizeof(pipeline_queue_t));
+    pipeline->threads = (pthread_t *)malloc(n_stages * sizeof(pthread_t));
+    pipeline->workers = (pipeline_worker_t *)malloc(n_stages * sizeof(pipeline_worker_t));
+    pipeline->busy_seconds = (double *)calloc(n_stages, sizeof(double));
+    pipeline->wait_seconds = (double *)calloc(n_stages, sizeof(double));
+    cnd_make_error(!pipeline->forward || !pipeline->backward || !pipeline->threads || !pipeline->workers || !pipeline->busy_seconds || !pipeline->wait_seconds, "Failed to allocate pipeline.");
+    for (int i = 0; i < n_stages - 1; i++) {
+        pipeline_queue_initialize(&pipeline->forward[i], queue_capacity);
+        pipeline_queue_initialize(&pipeline->backward[i], queue_capacity);
+    }
+    pthread_mutex_init(&pipeline->mutex, NULL);
+    pthread_cond_init(&pipeline->cond, NULL);
+
+    for (int i = 1; i < n_stages; i++) {
+        pipeline->workers[i].pipeline = pipeline;
+        pipeline->workers[i].stage = i;
+        cnd_make_error(pthread_create(&pipeline->threads[i], NULL, pipeline_thread, &pipeline->workers[i]) != 0, "Failed to create pipeline thread.");
+    }
+    return pipeline;
+}
+
+void pipeline_delete(pipeline_t *pipeline) {
+    pthread_mutex_lock(&pipeline->mutex);
+    pipeline->stop = 1;
+    pthread_cond_broadcast(&pipeline->cond);
+    pthread_mutex_unlock(&pipeline->mutex);
+    for (int i = 1; i < pipeline->n_stages; i++)
+        pthread_join(pipeline->threads[i], NULL);
+
+    for (int i = 0; i < pipeline->n_stages - 1; i++) {
+        pipeline_queue_delete(&pipeline->forward[i]);
+        pipeline_queue_delete(&pipeline->backward[i]);
+    }
+    pthread_mutex_destroy(&pipeline->mutex);
+    pthread_cond_destroy(&pipeline->cond);
+    free(pipeline->forward);
+    free(pipeline->backward);
+    free(pipeline->threads);
+    free(pipeline->workers);
+    free(pipeline->busy_seconds);
+    free(pipeline->wait_seconds);
+    free(pipeline);
+}
+
+int pipeline_size(pipeline_t *pipeline) {
+    return pipeline->n_stages;
+}
+
+void pipeline_run(pipeline_t *pipeline, pipeline_stage_function_t function, void *data) {
+    double start = timer_seconds();
+    pthread_mutex_lock(&pipeline->mutex);
+    pipeline->function = function;
+    pipeline->data = data;
+    pipeline->n_finished = 0;
+    pipeline->generation++;
+    pthread_cond_broadcast(&pipeline->cond);
+    pthread_mutex_unlock(&pipeline->mutex);
+
+    pipeline_run_stage(pipeline, 0);
+
+    pthread_mutex_lock(&pipeline->mutex);
+    while (pipeline->n_finished < pipeline->n_stages - 1)
+        pthread_cond_wait(&pipeline->cond, &pipeline->mutex);
+    pthread_mutex_unlock(&pipeline->mutex);
+    pipeline->wall_seconds += timer_seconds() - start;
+}
+
+void pipeline_send_forward(pipeline_t *pipeline, int stage, int item) {
+    cnd_make_error(stage < 0 || stage >= pipeline->n_stages - 1, "Only a stage before the last can send forward.");
+    pipeline_queue_push(&pipeline->forward[stage], item, &pipeline->wait_seconds[stage]);
+}
+
+int pipeline_receive_forward(pipeline_t *pipeline, int stage) {
+    cnd_make_error(stage < 1 || stage >= pipeline->n_stages, "Only a stage after the first can receive forward.");
+    return pipeline_queue_pop(&pipeline->forward[stage - 1], &pipeline->wait_seconds[stage]);
+}
+
+void pipeline_send_backward(pipeline_t *pipeline, int stage, int item) {
+    cnd_make_error(stage < 1 || stage >= pipeline->n_stages, "Only a stage after the first can send backward.");
+    pipeline_queue_push(&pipeline->backward[stage - 1], item, &pipeline->wait_seconds[stage]);
+}
+
+int pipeline_receive_backward(pipeline_t *pipeline, int stage) {
+    cnd_make_error(stage < 0 || stage >= pipeline->n_stages - 1, "Only a stage before the last can receive backward.");
+    return pipeline_queue_pop(&pipeline->backward[stage], &pipeline->wait_seconds[stage]);
+}
+
+double pipeline_wall_seconds(pipeline_t *pipeline) {
+    return pipeline->wall_seconds;
+}
+
+double pipeline_bubble_fraction(pipeline_t *pipeline) {
+    if (pipeline->wall_seconds <= 0)
+        return 0;
+    double busy = 0;
+    for (int i = 0; i < pipeline->n_stages; i++)
+        busy += pipeline->busy_seconds[i];
+    double fraction = 1 - busy / (pipeline->n_stages * pipeline->wall_seconds);
+    return fraction < 0 ? 0 : fraction;
+}
+
+void pipeline_reset_statistics(pipeline_t *pipeline) {
+    pipeline->wall_seconds = 0;
+    for (int i = 0; i < pipeline->n_stages; i++) {
+        pipeline->busy_seconds[i] = 0;
+        pipeline->wait_seconds[i] = 0;
+    }
+}
+
+//
+// 'pipeline.c' implementations
+//
+
+void pipeline_queue_initialize(pipeline_queue_t *queue, int capacity) {
+    queue->items = (int *)malloc(capacity * sizeof(int));
+    cnd_make_error(queue->items == NULL, "Failed to allocate pipeline queue.");
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->tail = 0;
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->cond, NULL);
+}
+
+void pipeline_queue_delete(pipeline_queue_t *queue) {
+    free(queue->items);
+    pthread_mutex_destroy(&queue->mutex);
+    pthread_cond_destroy(&queue->cond);
+}
+
+/**
+ * Push an item, adding any time spent waiting for room to the inputted total.
+*/
+void pipeline_queue_push(pipeline_queue_t *queue, int item, double *wait_seconds) {
+    pthread_mutex_lock(&queue->mutex);
+    if (queue->tail - queue->head == queue->capacity) {
+        double start = timer_seconds();
+        while (queue->tail - queue->head == queue->capacity)
+            pthread_cond_wait(&queue->cond, &queue->mutex);
+        *wait_seconds += timer_seconds() - start;
+    }
+    queue->items[queue->tail % queue->capacity] = item;
+    queue->tail++;
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+/**
+ * Pop the oldest item, adding any time spent waiting for one to the inputted total.
+*/
+int pipeline_queue_pop(pipeline_queue_t *queue, double *wait_seconds) {
+    pthread_mutex_lock(&queue->mutex);
+    if (queue->tail == queue->head) {
+        double start = timer_seconds();
+        while (queue->tail == queue->head)
+            pthread_cond_wait(&queue->cond, &queue->mutex);
+        *wait_seconds += timer_seconds() - start;
+    }
+    int item = queue->items[queue->head % queue->capacity];
+    queue->head++;
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+    return item;
+}
+
+/**
+ * Run the pipeline's function as the inputted stage, counting the time it was not waiting on a queue as busy.
+*/
+void pipeline_run_stage(pipeline_t *pipeline, int stage) {
+    double wait_before = pipeline->wait_seconds[stage];
+    double start = timer_seconds();
+    pipeline->function(pipeline->data, stage);
+    double waited = pipeline->wait_seconds[stage] - wait_before;
+    pipeline->busy_seconds[stage] += timer_seconds() - start - waited;
+}
+
+/**
+ * The loop of a stage's thread, running the stage once for each run of the pipeline until it is stopped.
+ * @param worker_ptr Intended to be passed a 'pipeline_worker_t *'.
+*/
+void *pipeline_thread(void *worker_ptr) {
+    pipeline_worker_t *worker = (pipeline_worker_t *)worker_ptr;
+    pipeline_t *pipeline = worker->pipeline;
+    long long generation = 0;
+    while (1) {
+        pthread_mutex_lock(&pipeline->mutex);
+        while (!pipeline->stop && pipeline->generation == generation)
+            pthread_cond_wait(&pipeline->cond, &pipeline->mutex);
+        if (pipeline->stop) {
+            pthread_mutex_unlock(&pipeline->mutex);
+            return NULL;
+        }
+        generation = pipeline->generation;
+        pthread_mutex_unlock(&pipeline->mutex);
+
+        pipeline_run_stage(pipeline, worker->stage);
+
+        pthread_mutex_lock(&pipeline->mutex);
+        pipeline->n_finished++;
+        pthread_cond_broadcast(&pipeline->cond);
+        pthread_mutex_unlock(&pipeline->mutex);
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef PIPELINE
+#define PIPELINE
+
+//
+// 'pipeline.h' definitions
+//
+
+/**
+ * A pipeline of stages, each run on its own persistent thread, the first on the thread running the pipeline.
+ * Neighbouring stages pass integer items to each other through bounded queues, forwards from a stage to the next and backwards from a stage to the previous.
+ * A stage blocks on an empty or full queue, so unlike the thread pool's tasks, every stage must have its own thread.
+*/
+typedef struct pipeline_t pipeline_t;
+
+/**
+ * The work of one stage, run once by each stage for each call of 'pipeline_run'.
+ * @param data The data given to 'pipeline_run'.
+ * @param stage The index of the stage, from 0 to the number of stages - 1.
+*/
+typedef void (*pipeline_stage_function_t)(void *data, int stage);
+
+/**
+ * The orders the stages of a pipeline can run their micro-batches' forward and backward passes in.
+ * 'PIPELINE_SCHEDULE_GPIPE' runs every forward pass before any backward pass, holding every micro-batch's activations at once.
+ * 'PIPELINE_SCHEDULE_1F1B' alternates a forward and a backward pass once the pipeline is full, holding at most a micro-batch per stage.
+*/
+typedef enum {
+    PIPELINE_SCHEDULE_GPIPE,
+    PIPELINE_SCHEDULE_1F1B
+} pipeline_schedule_t;
+
+/**
+ * Create a pipeline, starting a thread for every stage but the first.
+ * @param n_stages The number of stages.
+ * @param queue_capacity The number of items each queue between stages holds before sending to it blocks.
+ * @return The pipeline.
+*/
+pipeline_t *pipeline_create(int n_stages, int queue_capacity);
+
+/**
+ * Stop and join the pipeline's threads, and free the pipeline.
+ * @param pipeline The pipeline to be deleted.
+*/
+void pipeline_delete(pipeline_t *pipeline);
+
+/**
+ * Get the number of stages of the pipeline.
+ * @param pipeline The pipeline.
+ * @return The number of stages.
+*/
+int pipeline_size(pipeline_t *pipeline);
+
+/**
+ * Run the inputted function once on every stage, the first stage on the calling thread, and wait for every stage to return.
+ * Every queue must be empty when the stages return.
+ * @param pipeline The pipeline.
+ * @param function The work of each stage.
+ * @param data The data passed to every stage.
+*/
+void pipeline_run(pipeline_t *pipeline, pipeline_stage_function_t function, void *data);
+
+/**
+ * Send an item from a stage to the next stage, waiting while the queue is full.
+ * @param pipeline The pipeline.
+ * @param stage The sending stage, not the last.
+ * @param item The item to be sent.
+*/
+void pipeline_send_forward(pipeline_t *pipeline, int stage, int item);
+
+/**
+ * Receive the oldest item sent forward to a stage by the previous stage, waiting while there is none.
+ * @param pipeline The pipeline.
+ * @param stage The receiving stage, not the first.
+ * @return The item.
+*/
+int pipeline_receive_forward(pipeline_t *pipeline, int stage);
+
+/**
+ * Send an item from a stage to the previous stage, waiting while the queue is full.
+ * @param pipeline The pipeline.
+ * @param stage The sending stage, not the first.
+ * @param item The item to be sent.
+*/
+void pipeline_send_backward(pipeline_t *pipeline, int stage, int item);
+
+/**
+ * Receive the oldest item sent backward to a stage by the next stage, waiting while there is none.
+ * @param pipeline The pipeline.
+ * @param stage The receiving stage, not the last.
+ * @return The item.
+*/
+int pipeline_receive_backward(pipeline_t *pipeline, int stage);
+
+/**
+ * Get the wall clock time spent in 'pipeline_run' since the pipeline was created or its statistics were reset.
+ * @param pipeline The pipeline.
+ * @return The time in seconds.
+*/
+double pipeline_wall_seconds(pipeline_t *pipeline);
+
+/**
+ * Get the proportion of the stages' time spent idle, the pipeline's bubble, since the pipeline was created or its statistics were reset.
+ * A stage is idle while it waits on a queue, and between returning and the last stage returning.
+ * @param pipeline The pipeline.
+ * @return The idle time summed over the stages, divided by the number of stages times the wall clock time, between 0 and 1.
+*/
+double pipeline_bubble_fraction(pipeline_t *pipeline);
+
+/**
+ * Set the pipeline's wall clock and idle times back to zero.
+ * @param pipeline The pipeline.
+*/
+void pipeline_reset_statistics(pipeline_t *pipeline);
+
+#endif
@@ -0,0 +1,368 @@
+#include "process_ring.h"
+
+#include "error.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+//
+// 'process_ring.c' definitions
+//
+
+// The number of operations that can be queued on the communication thread, submitting more waits for one to complete.
+#define PROCESS_RING_QUEUE_CAPACITY 64
+// How long a process retries connecting to the next process of the ring before giving up.
+#define PROCESS_RING_CONNECT_SECONDS 60
+#define PROCESS_RING_CONNECT_RETRY_NANOSECONDS 10000000
+#define PROCESS_RING_ADDRESS_LENGTH 256
+
+#ifdef MSG_NOSIGNAL
+  #define PROCESS_RING_SEND_FLAGS MSG_NOSIGNAL
+#else
+  #define PROCESS_RING_SEND_FLAGS 0
+#endif
+
+typedef struct {
+    process_ring_function_t function;
+    void *data;
+    size_t count;
+} process_ring_request_t;
+
+struct process_ring_t {
+    int rank;
+    int size;
+    // Sends go to the next process, receives come from the previous process.
+    int next_fd;
+    int prev_fd;
+    char unix_path[PROCESS_RING_ADDRESS_LENGTH];
+    void *buffer;
+    size_t buffer_capacity;
+    // Operations are queued in a ring buffer, 'head' is the next to run and 'tail' the next free slot.
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    process_ring_request_t requests[PROCESS_RING_QUEUE_CAPACITY];
+    long long head;
+    long long tail;
+    int stop;
+};
+
+/**
+ * A socket address parsed from a ring address, for one process of the ring.
+*/
+typedef struct {
+    int family;
+    char path[PROCESS_RING_ADDRESS_LENGTH];
+    char host[PROCESS_RING_ADDRESS_LENGTH];
+    int port;
+} process_ring_address_t;
+
+void process_ring_parse_address(const char *address, int rank, process_ring_address_t *parsed);
+int process_ring_listen(process_ring_address_t *address);
+int process_ring_connect(process_ring_address_t *address);
+int process_ring_try_connect(process_ring_address_t *address);
+void process_ring_set_nonblocking(int fd);
+void *process_ring_thread(void *ring_ptr);
+
+//
+// 'process_ring.h' implementations
+//
+
+process_ring_t *process_ring_create(const char *address, int rank, int size) {
+    cnd_make_error(size < 1 || rank < 0 || rank >= size, "Process ring rank must be between 0 and the ring's size.");
+    process_ring_t *ring = (process_ring_t *)calloc(1, sizeof(process_ring_t));
+    cnd_make_error(ring == NULL, "Failed to allocate process ring.");
+    ring->rank = rank;
+    ring->size = size;
+    ring->next_fd = -1;
+    ring->prev_fd = -1;
+    pthread_mutex_init(&ring->mutex, NULL);
+    pthread_cond_init(&ring->cond, NULL);
+
+    if (size > 1) {
+        // Every process listens before connecting, so a connection waits in the next process's backlog until it accepts.
+        process_ring_address_t own;
+        process_ring_address_t next;
+        process_ring_parse_address(address, rank, &own);
+        process_ring_parse_address(address, (rank + 1) % size, &next);
+        int listen_fd = process_ring_listen(&own);
+        if (own.family == AF_UNIX)
+            strcpy(ring->unix_path, own.path);
+        ring->next_fd = process_ring_connect(&next);
+        ring->prev_fd = accept(listen_fd, NULL, NULL);
+        cnd_make_error(ring->prev_fd < 0, "Failed to accept the previous process of the ring.");
+        close(listen_fd);
+        if (own.family == AF_UNIX)
+            unlink(ring->unix_path);
+        process_ring_set_nonblocking(ring->next_fd);
+        process_ring_set_nonblocking(ring->prev_fd);
+    }
+    cnd_make_error(pthread_create(&ring->thread, NULL, process_ring_thread, ring) != 0, "Failed to create process ring thread.");
+    return ring;
+}
+
+void process_ring_delete(process_ring_t *ring) {
+    process_ring_wait(ring);
+    pthread_mutex_lock(&ring->mutex);
+    ring->stop = 1;
+    pthread_cond_broadcast(&ring->cond);
+    pthread_mutex_unlock(&ring->mutex);
+    pthread_join(ring->thread, NULL);
+
+    if (ring->next_fd >= 0)
+        close(ring->next_fd);
+    if (ring->prev_fd >= 0)
+        close(ring->prev_fd);
+    pthread_mutex_destroy(&ring->mutex);
+    pthread_cond_destroy(&ring->cond);
+    free(ring->buffer);
+    free(ring);
+}
+
+int process_ring_rank(process_ring_t *ring) {
+    return ring->rank;
+}
+
+int process_ring_size(process_ring_t *ring) {
+    return ring->size;
+}
+
+void process_ring_submit(process_ring_t *ring, process_ring_function_t function, void *data, size_t count) {
+    pthread_mutex_lock(&ring->mutex);
+    while (ring->tail - ring->head == PROCESS_RING_QUEUE_CAPACITY)
+        pthread_cond_wait(&ring->cond, &ring->mutex);
+    process_ring_request_t *request = &ring->requests[ring->tail % PROCESS_RING_QUEUE_CAPACITY];
+    request->function = function;
+    request->data = data;
+    request->count = count;
+    ring->tail++;
+    pthread_cond_broadcast(&ring->cond);
+    pthread_mutex_unlock(&ring->mutex);
+}
+
+void process_ring_wait(process_ring_t *ring) {
+    pthread_mutex_lock(&ring->mutex);
+    while (ring->head != ring->tail)
+        pthread_cond_wait(&ring->cond, &ring->mutex);
+    pthread_mutex_unlock(&ring->mutex);
+}
+
+void process_ring_exchange(process_ring_t *ring, const void *send_data, size_t send_bytes, void *recv_data, size_t recv_bytes) {
+    const char *send_ptr = (const char *)send_data;
+    char *recv_ptr = (char *)recv_data;
+    while (send_bytes || recv_bytes) {
+        struct pollfd fds[2];
+        int n_fds = 0;
+        if (send_bytes)
+            fds[n_fds++] = (struct pollfd){ .fd=ring->next_fd, .events=POLLOUT };
+        if (recv_bytes)
+            fds[n_fds++] = (struct pollfd){ .fd=ring->prev_fd, .events=POLLIN };
+        if (poll(fds, n_fds, -1) < 0) {
+            cnd_make_error(errno != EINTR, "Failed to poll the process ring's sockets.");
+            continue;
+        }
+        for (int i = 0; i < n_fds; i++) {
+            if (!fds[i].revents)
+                continue;
+            if (fds[i].fd == ring->next_fd && send_bytes) {
+                ssize_t sent = send(ring->next_fd, send_ptr, send_bytes, PROCESS_RING_SEND_FLAGS);
+                cnd_make_error(sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR, "Failed to send to the next process of the ring.");
+                if (sent > 0) {
+                    send_ptr += sent;
+                    send_bytes -= sent;
+                }
+            }
+            else if (fds[i].fd == ring->prev_fd && recv_bytes) {
+                ssize_t received = recv(ring->prev_fd, recv_ptr, recv_bytes, 0);
+                cnd_make_error(received == 0, "The previous process of the ring disconnected.");
+                cnd_make_error(received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR, "Failed to receive from the previous process of the ring.");
+                if (received > 0) {
+                    recv_ptr += received;
+                    recv_bytes -= received;
+                }
+            }
+        }
+    }
+}
+
+void *process_ring_buffer(process_ring_t *ring, size_t bytes) {
+    if (ring->buffer_capacity >= bytes)
+        return ring->buffer;
+    free(ring->buffer);
+    ring->buffer = malloc(bytes);
+    cnd_make_error(ring->buffer == NULL, "Failed to allocate process ring buffer.");
+    ring->buffer_capacity = bytes;
+    return ring->buffer;
+}
+
+//
+// 'process_ring.c' implementations
+//
+
+/**
+ * Parse the address of the process of the inputted rank from a ring address.
+*/
+void process_ring_parse_address(const char *address, int rank, process_ring_address_t *parsed) {
+    memset(parsed, 0, sizeof(process_ring_address_t));
+    if (strncmp(address, "unix:", 5) == 0) {
+        parsed->family = AF_UNIX;
+        int length = snprintf(parsed->path, PROCESS_RING_ADDRESS_LENGTH, "%s.%d", address + 5, rank);
+        cnd_make_error(length < 0 || length >= (int)sizeof(((struct sockaddr_un *)0)->sun_path), "Process ring socket path is too long.");
+        return;
+    }
+
+    // A list has an entry per process, otherwise the processes share a host on consecutive ports.
+    const char *entry = address;
+    int port_offset = rank;
+    if (strchr(address, ',')) {
+        for (int i = 0; i < rank; i++) {
+            entry = strchr(entry, ',');
+            cnd_make_error(entry == NULL, "Process ring address list has fewer entries than processes.");
+            entry++;
+        }
+        port_offset = 0;
+    }
+    cnd_make_error(strncmp(entry, "tcp:", 4) != 0, "Process ring addresses must start with 'unix:' or 'tcp:'.");
+    entry += 4;
+    const char *entry_end = strchr(entry, ',');
+    size_t entry_length = entry_end ? (size_t)(entry_end - entry) : strlen(entry);
+    cnd_make_error(entry_length >= PROCESS_RING_ADDRESS_LENGTH, "Process ring address is too long.");
+    char host_port[PROCESS_RING_ADDRESS_LENGTH];
+    memcpy(host_port, entry, entry_length);
+    host_port[entry_length] = '\0';
+    char *colon = strrchr(host_port, ':');
+    cnd_make_error(colon == NULL, "Process ring TCP addresses must be 'tcp:<host>:<port>'.");
+    *colon = '\0';
+    parsed->family = AF_INET;
+    strcpy(parsed->host, host_port);
+    parsed->port = atoi(colon + 1) + port_offset;
+    cnd_make_error(parsed->port <= 0 || parsed->port > 65535, "Process ring TCP port is invalid.");
+}
+
+/**
+ * Open a socket listening on the inputted address.
+*/
+int process_ring_listen(process_ring_address_t *address) {
+    int fd;
+    if (address->family == AF_UNIX) {
+        struct sockaddr_un addr = { .sun_family=AF_UNIX };
+        strcpy(addr.sun_path, address->path);
+        unlink(address->path);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        cnd_make_error(fd < 0, "Failed to create process ring socket.");
+        cnd_make_error(bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0, "Failed to bind process ring socket.");
+    }
+    else {
+        char port[16];
+        sprintf(port, "%d", address->port);
+        struct addrinfo hints = { .ai_family=AF_UNSPEC, .ai_socktype=SOCK_STREAM, .ai_flags=AI_PASSIVE };
+        struct addrinfo *info;
+        cnd_make_error(getaddrinfo(address->host, port, &hints, &info) != 0, "Failed to resolve process ring host.");
+        fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+        cnd_make_error(fd < 0, "Failed to create process ring socket.");
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        cnd_make_error(bind(fd, info->ai_addr, info->ai_addrlen) != 0, "Failed to bind process ring socket.");
+        freeaddrinfo(info);
+    }
+    cnd_make_error(listen(fd, 1) != 0, "Failed to listen on process ring socket.");
+    return fd;
+}
+
+/**
+ * Connect to the inputted address, retrying until the process there is listening.
+*/
+int process_ring_connect(process_ring_address_t *address) {
+    struct timespec retry = { 0, PROCESS_RING_CONNECT_RETRY_NANOSECONDS };
+    long long attempts = (long long)PROCESS_RING_CONNECT_SECONDS * 1000000000 / PROCESS_RING_CONNECT_RETRY_NANOSECONDS;
+    for (long long i = 0; i < attempts; i++) {
+        int fd = process_ring_try_connect(address);
+        if (fd >= 0)
+            return fd;
+        nanosleep(&retry, NULL);
+    }
+    make_error("Timed out connecting to the next process of the ring.");
+    return -1;
+}
+
+/**
+ * @return The connected socket, or -1 if nothing is listening yet.
+*/
+int process_ring_try_connect(process_ring_address_t *address) {
+    if (address->family == AF_UNIX) {
+        struct sockaddr_un addr = { .sun_family=AF_UNIX };
+        strcpy(addr.sun_path, address->path);
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        cnd_make_error(fd < 0, "Failed to create process ring socket.");
+        if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0)
+            return fd;
+        close(fd);
+        return -1;
+    }
+    char port[16];
+    sprintf(port, "%d", address->port);
+    struct addrinfo hints = { .ai_family=AF_UNSPEC, .ai_socktype=SOCK_STREAM };
+    struct addrinfo *info;
+    if (getaddrinfo(address->host, port, &hints, &info) != 0)
+        return -1;
+    int fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+    cnd_make_error(fd < 0, "Failed to create process ring socket.");
+    int connected = connect(fd, info->ai_addr, info->ai_addrlen) == 0;
+    freeaddrinfo(info);
+    if (!connected) {
+        close(fd);
+        return -1;
+    }
+    // Gradients are sent in segments as soon as they are ready, so small segments should not wait to be coalesced.
+    int no_delay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+    return fd;
+}
+
+void process_ring_set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    cnd_make_error(flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0, "Failed to make process ring socket non-blocking.");
+}
+
+/**
+ * Run the queued operations in order until the ring is stopped.
+ * @param ring_ptr Intended to be passed a 'process_ring_t *'.
+*/
+void *process_ring_thread(void *ring_ptr) {
+    process_ring_t *ring = (process_ring_t *)ring_ptr;
+    pthread_mutex_lock(&ring->mutex);
+    while (1) {
+        while (ring->head == ring->tail && !ring->stop)
+            pthread_cond_wait(&ring->cond, &ring->mutex);
+        if (ring->head == ring->tail)
+            break;
+        process_ring_request_t request = ring->requests[ring->head % PROCESS_RING_QUEUE_CAPACITY];
+        pthread_mutex_unlock(&ring->mutex);
+        request.function(ring, request.data, request.count);
+        pthread_mutex_lock(&ring->mutex);
+        ring->head++;
+        pthread_cond_broadcast(&ring->cond);
+    }
+    pthread_mutex_unlock(&ring->mutex);
+    return NULL;
+}
+
+#include "template_f64.h"
+#include "process_ring_template.inc"
+#include "template_end.h"
+
+#include "template_f32.h"
+#include "process_ring_template.inc"
+#include "template_end.h"
@@ -0,0 +1,93 @@
+#ifndef PROCESS_RING
+#define PROCESS_RING
+
+#include <stddef.h>
+
+//
+// 'process_ring.h' definitions
+//
+
+/**
+ * A ring of processes, each connected by a socket to the next and the previous process, for collective operations such as all-reduce.
+ * Operations are queued to a communication thread owned by the ring and run in the order they were submitted, so the calling thread can keep
+ * computing while earlier operations are exchanged. Every process of the ring must submit the same operations in the same order.
+*/
+typedef struct process_ring_t process_ring_t;
+
+/**
+ * An operation run on the ring's communication thread.
+*/
+typedef void (*process_ring_function_t)(process_ring_t *ring, void *data, size_t count);
+
+/**
+ * Connect this process into a ring, blocking until it is connected to its neighbours.
+ * @param address Where the processes listen, either 'unix:<path>', where process r listens on '<path>.r', 'tcp:<host>:<port>', where process r listens
+ * on port '<port> + r' of the host, or a comma separated list of 'tcp:<host>:<port>' with an entry per process, for processes on several machines.
+ * @param rank The index of this process in the ring, from 0 to 'size - 1'.
+ * @param size The number of processes in the ring. A ring of size 1 opens no sockets.
+ * @return The ring.
+*/
+process_ring_t *process_ring_create(const char *address, int rank, int size);
+
+/**
+ * Wait for the ring's queued operations, close its sockets and free it.
+ * @param ring The ring to be deleted.
+*/
+void process_ring_delete(process_ring_t *ring);
+
+/**
+ * @param ring The ring.
+ * @return The index of this process in the ring.
+*/
+int process_ring_rank(process_ring_t *ring);
+
+/**
+ * @param ring The ring.
+ * @return The number of processes in the ring.
+*/
+int process_ring_size(process_ring_t *ring);
+
+/**
+ * Queue an operation on the ring's communication thread. Used by the typed operations, e.g. 'process_ring_allreduce_async'.
+ * @param ring The ring.
+ * @param function The operation.
+ * @param data The data passed to the operation.
+ * @param count The count passed to the operation.
+*/
+void process_ring_submit(process_ring_t *ring, process_ring_function_t function, void *data, size_t count);
+
+/**
+ * Block until every queued operation of the ring has completed.
+ * @param ring The ring.
+*/
+void process_ring_wait(process_ring_t *ring);
+
+/**
+ * Send to the next process and receive from the previous process at the same time. Only called from the ring's communication thread.
+ * @param ring The ring.
+ * @param send_data The data to send.
+ * @param send_bytes The number of bytes to send, may be 0.
+ * @param recv_data Where the received data is placed.
+ * @param recv_bytes The number of bytes to receive, may be 0.
+*/
+void process_ring_exchange(process_ring_t *ring, const void *send_data, size_t send_bytes, void *recv_data, size_t recv_bytes);
+
+/**
+ * Get a buffer of at least the inputted size owned by the ring, for operations to receive into. Only called from the ring's communication thread.
+ * @param ring The ring.
+ * @param bytes The number of bytes needed.
+ * @return The buffer, valid until the next call.
+*/
+void *process_ring_buffer(process_ring_t *ring, size_t bytes);
+
+// 'process_ring_allreduce', 'process_ring_allreduce_async' and 'process_ring_broadcast' for doubles.
+#include "template_f64.h"
+#include "process_ring_template.h"
+#include "template_end.h"
+
+// 'process_ring_f32_allreduce', 'process_ring_f32_allreduce_async' and 'process_ring_f32_broadcast' for floats.
+#include "template_f32.h"
+#include "process_ring_template.h"
+#include "template_end.h"
+
+#endif
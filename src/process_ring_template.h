@@ -0,0 +1,34 @@
+//
+// 'process_ring_template.h' definitions
+//
+
+/**
+ * Declarations of the ring's collective operations for one scalar type. Included by 'process_ring.h' with the template parameters set.
+*/
+
+/**
+ * Sum the inputted array across every process of the ring, each process receiving the sum in place.
+ * A ring all-reduce, a reduce-scatter then an all-gather, so each process sends and receives about twice the array whatever the ring's size.
+ * The sums are computed in a fixed order and copied to every process, so every process holds the same bits.
+ * @param ring The ring.
+ * @param data The array to be summed.
+ * @param count The number of scalars in the array.
+*/
+void TEMPLATE_FN(process_ring, allreduce)(process_ring_t *ring, SCALAR_T *data, size_t count);
+
+/**
+ * Queue an all-reduce of the inputted array on the ring's communication thread and return immediately.
+ * The array must not be accessed until 'process_ring_wait' returns.
+ * @param ring The ring.
+ * @param data The array to be summed.
+ * @param count The number of scalars in the array.
+*/
+void TEMPLATE_FN(process_ring, allreduce_async)(process_ring_t *ring, SCALAR_T *data, size_t count);
+
+/**
+ * Copy the inputted array of the first process of the ring to every other process.
+ * @param ring The ring.
+ * @param data The array to be sent by the first process, and overwritten on the others.
+ * @param count The number of scalars in the array.
+*/
+void TEMPLATE_FN(process_ring, broadcast)(process_ring_t *ring, SCALAR_T *data, size_t count);
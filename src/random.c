@@ -22,3 +22,36 @@ double random_double_between(double min, double max) {
 int random_int_between(int min_inclusive, int max_non_inclusive) {
     return min_inclusive + rand() % (max_non_inclusive - min_inclusive);
 }
+
+/**
+ * SplitMix64, a single 64 bit addition and a mix of the sum per draw.
+*/
+void random_state_seed(random_state_t *state, uint64_t seed) {
+    state->state = seed;
+}
+
+uint64_t random_state_next(random_state_t *state) {
+    uint64_t z = (state->state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Scales 32 random bits to the range with a multiplication rather than a division, the bias being below n / 2^32.
+*/
+uint32_t random_state_below(random_state_t *state, uint32_t n) {
+    return (uint32_t)(((random_state_next(state) >> 32) * (uint64_t)n) >> 32);
+}
+
+/**
+ * A Fisher-Yates shuffle, swapping each index from the last with one at or before it.
+*/
+void random_state_shuffle(random_state_t *state, int32_t *indices, int32_t n) {
+    for (int32_t i = n - 1; i > 0; i--) {
+        int32_t j = (int32_t)random_state_below(state, (uint32_t)i + 1);
+        int32_t swap = indices[i];
+        indices[i] = indices[j];
+        indices[j] = swap;
+    }
+}
@@ -1,6 +1,8 @@
 #ifndef RANDOM
 #define RANDOM
 
+#include <stdint.h>
+
 //
 // 'random.h' Definitions
 //
@@ -10,4 +12,36 @@ void random_init_seeded(int seed);
 double random_double_between(double min, double max);
 int random_int_between(int min, int max);
 
+/**
+ * The state of a fast seeded generator, independent of the shared generator above, so each user can draw its own reproducible sequence.
+*/
+typedef struct {
+    uint64_t state;
+} random_state_t;
+
+/**
+ * Seed a generator. Generators with the same seed draw the same sequence.
+ * @param state The generator to be seeded.
+ * @param seed Any value.
+*/
+void random_state_seed(random_state_t *state, uint64_t seed);
+
+/**
+ * @return The generator's next 64 random bits.
+*/
+uint64_t random_state_next(random_state_t *state);
+
+/**
+ * @return A random integer between [0, n), for n of at least 1.
+*/
+uint32_t random_state_below(random_state_t *state, uint32_t n);
+
+/**
+ * Put an array of indices in a random order, every order being about equally likely.
+ * @param state The generator drawn from.
+ * @param indices The indices to be shuffled in place.
+ * @param n The number of indices.
+*/
+void random_state_shuffle(random_state_t *state, int32_t *indices, int32_t n);
+
 #endif
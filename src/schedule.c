@@ -0,0 +1,119 @@
+#include "schedule.h"
+
+#include "error.h"
+
+#include <math.h>
+#include <string.h>
+
+//
+// 'schedule.c' definitions
+//
+
+#define SCHEDULE_PI 3.14159265358979323846
+
+double schedule_cosine(double from, double to, double progress);
+
+//
+// 'schedule.h' implementations
+//
+
+void schedule_initialize(schedule_t *schedule, const char *name, long long total_steps) {
+    cnd_make_error(total_steps < 1, "A schedule needs at least one step.");
+    schedule_kind_t kind;
+    if (strcmp(name, "constant") == 0)
+        kind = SCHEDULE_CONSTANT;
+    else if (strcmp(name, "step") == 0)
+        kind = SCHEDULE_STEP;
+    else if (strcmp(name, "exponential") == 0)
+        kind = SCHEDULE_EXPONENTIAL;
+    else if (strcmp(name, "cosine") == 0)
+        kind = SCHEDULE_COSINE;
+    else if (strcmp(name, "warmup") == 0)
+        kind = SCHEDULE_WARMUP;
+    else if (strcmp(name, "one-cycle") == 0)
+        kind = SCHEDULE_ONE_CYCLE;
+    else if (strcmp(name, "plateau") == 0)
+        kind = SCHEDULE_PLATEAU;
+    else {
+        make_error("Schedule does not exist");
+        return;
+    }
+
+    strcpy(schedule->name, name);
+    schedule->kind = kind;
+    schedule->total_steps = total_steps;
+    // Warmup takes the first twentieth of the run, one-cycle rises for the first 30%, and step halves the rate each quarter.
+    schedule->warmup_steps = kind == SCHEDULE_ONE_CYCLE ? (total_steps * 3 + 9) / 10 : (total_steps + 19) / 20;
+    schedule->step_size = (total_steps + 3) / 4;
+    schedule->decay = 0.5;
+    schedule->initial_factor = 0.04;
+    schedule->final_factor = kind == SCHEDULE_ONE_CYCLE ? 0.001 : 0.01;
+    schedule->patience = 1;
+    atomic_init(&schedule->step, 0);
+    schedule->plateau_factor = 1;
+    schedule->plateau_best = -INFINITY;
+    schedule->plateau_count = 0;
+}
+
+double schedule_factor(schedule_t *schedule, long long step) {
+    long long total = schedule->total_steps;
+    long long warmup = schedule->warmup_steps;
+    if (step >= total)
+        step = total - 1;
+    double progress = total > 1 ? (double)step / (total - 1) : 1;
+    switch (schedule->kind) {
+        case SCHEDULE_STEP:
+            return pow(schedule->decay, (double)(step / schedule->step_size));
+        case SCHEDULE_EXPONENTIAL:
+            return pow(schedule->final_factor, progress);
+        case SCHEDULE_COSINE:
+            return schedule_cosine(1, schedule->final_factor, progress);
+        case SCHEDULE_WARMUP:
+        case SCHEDULE_ONE_CYCLE: {
+            double initial = schedule->kind == SCHEDULE_WARMUP ? 0 : schedule->initial_factor;
+            if (step < warmup)
+                return 1 - (1 - initial) * (warmup - 1 - step) / warmup;
+            double decay_progress = total - warmup > 1 ? (double)(step - warmup) / (total - warmup - 1) : 1;
+            return schedule_cosine(1, schedule->final_factor, decay_progress);
+        }
+        case SCHEDULE_PLATEAU:
+            return schedule->plateau_factor;
+        default:
+            return 1;
+    }
+}
+
+double schedule_next(schedule_t *schedule) {
+    return schedule_factor(schedule, atomic_fetch_add(&schedule->step, 1));
+}
+
+void schedule_observe(schedule_t *schedule, double metric) {
+    if (schedule->kind != SCHEDULE_PLATEAU)
+        return;
+    if (metric > schedule->plateau_best) {
+        schedule->plateau_best = metric;
+        schedule->plateau_count = 0;
+        return;
+    }
+    if (++schedule->plateau_count >= schedule->patience) {
+        schedule->plateau_count = 0;
+        schedule->plateau_factor *= schedule->decay;
+        if (schedule->plateau_factor < schedule->final_factor)
+            schedule->plateau_factor = schedule->final_factor;
+    }
+}
+
+long long schedule_steps(schedule_t *schedule) {
+    return atomic_load(&schedule->step);
+}
+
+//
+// 'schedule.c' implementations
+//
+
+/**
+ * Interpolate along half a cosine, from 'from' at progress 0 to 'to' at progress 1.
+*/
+double schedule_cosine(double from, double to, double progress) {
+    return to + (from - to) * 0.5 * (1 + cos(SCHEDULE_PI * progress));
+}
@@ -0,0 +1,89 @@
+#ifndef SCHEDULE
+#define SCHEDULE
+
+#include <stdatomic.h>
+
+//
+// 'schedule.h' definitions
+//
+
+#define SCHEDULE_NAME_SIZE 16
+
+/**
+ * The shapes a learning rate can follow over training, as a factor of the training parameter.
+ * 'SCHEDULE_CONSTANT' stays at 1. 'SCHEDULE_STEP' multiplies by 'decay' every 'step_size' steps. 'SCHEDULE_EXPONENTIAL' decays smoothly
+ * to 'final_factor' at the last step. 'SCHEDULE_COSINE' follows half a cosine down to 'final_factor'. 'SCHEDULE_WARMUP' rises linearly
+ * from 0 over 'warmup_steps', then follows half a cosine down to 'final_factor'. 'SCHEDULE_ONE_CYCLE' rises linearly from 'initial_factor'
+ * to 1 over 'warmup_steps', then follows half a cosine down to 'final_factor'. 'SCHEDULE_PLATEAU' stays constant, multiplying by 'decay'
+ * whenever 'patience' observations in a row fail to beat the best, down to 'final_factor'.
+*/
+typedef enum {
+    SCHEDULE_CONSTANT,
+    SCHEDULE_STEP,
+    SCHEDULE_EXPONENTIAL,
+    SCHEDULE_COSINE,
+    SCHEDULE_WARMUP,
+    SCHEDULE_ONE_CYCLE,
+    SCHEDULE_PLATEAU
+} schedule_kind_t;
+
+/**
+ * A learning rate schedule, its shape's parameters and its position. Steps past 'total_steps' keep the factor of the last step.
+ * 'step' counts the factors handed out, atomically, so trainers updating a network concurrently can share a schedule.
+ * The plateau's state only changes through 'schedule_observe'.
+*/
+typedef struct {
+    char name[SCHEDULE_NAME_SIZE];
+    schedule_kind_t kind;
+    long long total_steps;
+    long long warmup_steps;
+    long long step_size;
+    double decay;
+    double initial_factor;
+    double final_factor;
+    int patience;
+    atomic_llong step;
+    double plateau_factor;
+    double plateau_best;
+    int plateau_count;
+} schedule_t;
+
+/**
+ * Initialize the schedule mapped to by the inputted name, with its usual parameters for a run of the inputted length, at its first step.
+ * @param schedule The schedule to be initialized.
+ * @param name Valid inputs: "constant", "step", "exponential", "cosine", "warmup", "one-cycle", "plateau".
+ * @param total_steps The number of steps, updates, the schedule spans.
+*/
+void schedule_initialize(schedule_t *schedule, const char *name, long long total_steps);
+
+/**
+ * Get the factor of the learning rate at a step, without moving the schedule.
+ * @param schedule The schedule.
+ * @param step The step, from 0.
+ * @return The factor the training parameter is multiplied by.
+*/
+double schedule_factor(schedule_t *schedule, long long step);
+
+/**
+ * Get the factor of the learning rate for the next update, and move the schedule on a step. Thread safe.
+ * @param schedule The schedule.
+ * @return The factor the training parameter is multiplied by.
+*/
+double schedule_next(schedule_t *schedule);
+
+/**
+ * Report a measure of progress, such as an epoch's accuracy, higher being better. Only 'SCHEDULE_PLATEAU' reacts, decaying once
+ * 'patience' observations in a row fail to beat the best. Not thread safe, intended to be called between epochs.
+ * @param schedule The schedule.
+ * @param metric The measure of progress.
+*/
+void schedule_observe(schedule_t *schedule, double metric);
+
+/**
+ * Get the number of steps the schedule has handed out.
+ * @param schedule The schedule.
+ * @return The number of calls of 'schedule_next'.
+*/
+long long schedule_steps(schedule_t *schedule);
+
+#endif
@@ -0,0 +1,12 @@
+//
+// 'template_end.h' definitions
+//
+
+/**
+ * Clear the template parameters set by 'template_f64.h' or 'template_f32.h'.
+*/
+#undef SCALAR_T
+#undef TEMPLATE_T
+#undef TEMPLATE_FN
+#undef TEMPLATE_SUFFIX
+#undef TEMPLATE_MATH
@@ -0,0 +1,14 @@
+//
+// 'template_f32.h' definitions
+//
+
+/**
+ * Template parameters for the single precision instantiation of the library.
+ * Include this before a '*_template.h' or '*_template.inc' file, and 'template_end.h' after it.
+ * Types are named 'prefix_f32_t' and functions 'prefix_f32_name'.
+*/
+#define SCALAR_T float
+#define TEMPLATE_T(prefix) prefix##_f32_t
+#define TEMPLATE_FN(prefix, name) prefix##_f32_##name
+#define TEMPLATE_SUFFIX(name) name##_f32
+#define TEMPLATE_MATH(name) name##f
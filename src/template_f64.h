@@ -0,0 +1,14 @@
+//
+// 'template_f64.h' definitions
+//
+
+/**
+ * Template parameters for the double precision instantiation of the library.
+ * Include this before a '*_template.h' or '*_template.inc' file, and 'template_end.h' after it.
+ * Types are named 'prefix_t' and functions 'prefix_name'.
+*/
+#define SCALAR_T double
+#define TEMPLATE_T(prefix) prefix##_t
+#define TEMPLATE_FN(prefix, name) prefix##_##name
+#define TEMPLATE_SUFFIX(name) name
+#define TEMPLATE_MATH(name) name
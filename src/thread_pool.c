@@ -0,0 +1,321 @@
+#include "thread_pool.h"
+
+#include "error.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+//
+// 'thread_pool.c' definitions
+//
+
+// Initial number of tasks a deque holds, it doubles when full.
+#define THREAD_POOL_DEQUE_CAPACITY 64
+// 'thread_pool_parallel_for' splits a range into at most this many chunks per thread, so workers that finish early can steal the rest.
+#define THREAD_POOL_CHUNKS_PER_THREAD 4
+
+typedef struct {
+    thread_pool_task_function_t function;
+    thread_pool_range_function_t range_function;
+    void *data;
+    int start;
+    int end;
+    thread_pool_group_t *group;
+} thread_pool_task_t;
+
+/**
+ * A ring buffer of tasks. The owner pushes and pops at the bottom, thieves take from the top.
+*/
+typedef struct {
+    pthread_mutex_t mutex;
+    thread_pool_task_t *tasks;
+    int capacity;
+    int top;
+    int bottom;
+} thread_pool_deque_t;
+
+struct thread_pool_t {
+    int size;
+    int n_workers;
+    pthread_t *threads;
+    // A deque per worker, then the deque of the threads outside the pool.
+    thread_pool_deque_t *deques;
+    atomic_int queued;
+    atomic_int sleeping;
+    atomic_int stop;
+    pthread_mutex_t sleep_mutex;
+    pthread_cond_t sleep_cond;
+};
+
+typedef struct {
+    thread_pool_t *pool;
+    int index;
+} thread_pool_worker_t;
+
+// The pool and deque index of the calling thread, if it is one of a pool's workers.
+static _Thread_local thread_pool_t *thread_pool_current;
+static _Thread_local int thread_pool_current_index;
+
+static thread_pool_t *thread_pool_default_pool;
+static pthread_once_t thread_pool_default_once = PTHREAD_ONCE_INIT;
+
+void thread_pool_default_create();
+void thread_pool_deque_initialize(thread_pool_deque_t *deque);
+void thread_pool_deque_push(thread_pool_deque_t *deque, thread_pool_task_t task);
+int thread_pool_deque_pop(thread_pool_deque_t *deque, thread_pool_task_t *task);
+int thread_pool_deque_steal(thread_pool_deque_t *deque, thread_pool_task_t *task);
+int thread_pool_own_index(thread_pool_t *pool);
+void thread_pool_push(thread_pool_t *pool, thread_pool_task_t task);
+int thread_pool_find_task(thread_pool_t *pool, int index, thread_pool_task_t *task);
+void thread_pool_run_task(thread_pool_task_t *task);
+void *thread_pool_worker(void *worker_ptr);
+
+//
+// 'thread_pool.h' implementations
+//
+
+thread_pool_t *thread_pool_create(int size) {
+    if (size <= 0)
+        size = thread_pool_cpu_count();
+    thread_pool_t *pool = (thread_pool_t *)malloc(sizeof(thread_pool_t));
+    cnd_make_error(pool == NULL, "Failed to allocate thread pool.");
+    pool->size = size;
+    pool->n_workers = size - 1;
+    atomic_init(&pool->queued, 0);
+    atomic_init(&pool->sleeping, 0);
+    atomic_init(&pool->stop, 0);
+    pthread_mutex_init(&pool->sleep_mutex, NULL);
+    pthread_cond_init(&pool->sleep_cond, NULL);
+
+    pool->deques = (thread_pool_deque_t *)malloc((pool->n_workers + 1) * sizeof(thread_pool_deque_t));
+    cnd_make_error(pool->deques == NULL, "Failed to allocate thread pool deques.");
+    for (int i = 0; i < pool->n_workers + 1; i++)
+        thread_pool_deque_initialize(&pool->deques[i]);
+
+    pool->threads = (pthread_t *)malloc((pool->n_workers + 1) * sizeof(pthread_t));
+    cnd_make_error(pool->threads == NULL, "Failed to allocate thread pool threads.");
+    for (int i = 0; i < pool->n_workers; i++) {
+        thread_pool_worker_t *worker = (thread_pool_worker_t *)malloc(sizeof(thread_pool_worker_t));
+        cnd_make_error(worker == NULL, "Failed to allocate thread pool worker.");
+        worker->pool = pool;
+        worker->index = i;
+        cnd_make_error(pthread_create(&pool->threads[i], NULL, thread_pool_worker, worker) != 0, "Failed to create thread pool worker.");
+    }
+    return pool;
+}
+
+void thread_pool_delete(thread_pool_t *pool) {
+    cnd_make_error(atomic_load(&pool->queued) != 0, "Deleting a thread pool with queued tasks.");
+    pthread_mutex_lock(&pool->sleep_mutex);
+    atomic_store(&pool->stop, 1);
+    pthread_cond_broadcast(&pool->sleep_cond);
+    pthread_mutex_unlock(&pool->sleep_mutex);
+    for (int i = 0; i < pool->n_workers; i++)
+        pthread_join(pool->threads[i], NULL);
+
+    for (int i = 0; i < pool->n_workers + 1; i++) {
+        pthread_mutex_destroy(&pool->deques[i].mutex);
+        free(pool->deques[i].tasks);
+    }
+    pthread_mutex_destroy(&pool->sleep_mutex);
+    pthread_cond_destroy(&pool->sleep_cond);
+    free(pool->deques);
+    free(pool->threads);
+    free(pool);
+}
+
+thread_pool_t *thread_pool_default() {
+    pthread_once(&thread_pool_default_once, thread_pool_default_create);
+    return thread_pool_default_pool;
+}
+
+int thread_pool_size(thread_pool_t *pool) {
+    return (pool ? pool : thread_pool_default())->size;
+}
+
+int thread_pool_cpu_count() {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count < 1 ? 1 : (int)count;
+}
+
+void thread_pool_group_initialize(thread_pool_group_t *group, thread_pool_t *pool) {
+    group->pool = pool ? pool : thread_pool_default();
+    atomic_init(&group->pending, 0);
+}
+
+void thread_pool_group_submit(thread_pool_group_t *group, thread_pool_task_function_t function, void *data) {
+    thread_pool_task_t task = { function, NULL, data, 0, 0, group };
+    atomic_fetch_add(&group->pending, 1);
+    thread_pool_push(group->pool, task);
+}
+
+void thread_pool_group_submit_range(thread_pool_group_t *group, thread_pool_range_function_t function, void *data, int start, int end) {
+    thread_pool_task_t task = { NULL, function, data, start, end, group };
+    atomic_fetch_add(&group->pending, 1);
+    thread_pool_push(group->pool, task);
+}
+
+void thread_pool_group_wait(thread_pool_group_t *group) {
+    thread_pool_t *pool = group->pool;
+    int index = thread_pool_own_index(pool);
+    thread_pool_task_t task;
+    while (atomic_load(&group->pending) > 0) {
+        if (thread_pool_find_task(pool, index, &task))
+            thread_pool_run_task(&task);
+        else
+            sched_yield();
+    }
+}
+
+void thread_pool_parallel_for(thread_pool_t *pool, int start, int end, int grain, thread_pool_range_function_t function, void *data) {
+    if (end <= start)
+        return;
+    if (pool == NULL)
+        pool = thread_pool_default();
+    if (grain < 1)
+        grain = 1;
+
+    long long n = end - start;
+    long long n_chunks = (n + grain - 1) / grain;
+    if (n_chunks > (long long)pool->size * THREAD_POOL_CHUNKS_PER_THREAD)
+        n_chunks = (long long)pool->size * THREAD_POOL_CHUNKS_PER_THREAD;
+    if (n_chunks <= 1 || pool->size == 1) {
+        function(data, start, end);
+        return;
+    }
+
+    thread_pool_group_t group;
+    thread_pool_group_initialize(&group, pool);
+    for (long long c = n_chunks - 1; c > 0; c--)
+        thread_pool_group_submit_range(&group, function, data, start + (int)(n * c / n_chunks), start + (int)(n * (c + 1) / n_chunks));
+    function(data, start, start + (int)(n / n_chunks));
+    thread_pool_group_wait(&group);
+}
+
+//
+// 'thread_pool.c' implementations
+//
+
+void thread_pool_default_create() {
+    thread_pool_default_pool = thread_pool_create(0);
+}
+
+void thread_pool_deque_initialize(thread_pool_deque_t *deque) {
+    pthread_mutex_init(&deque->mutex, NULL);
+    deque->capacity = THREAD_POOL_DEQUE_CAPACITY;
+    deque->tasks = (thread_pool_task_t *)malloc(deque->capacity * sizeof(thread_pool_task_t));
+    cnd_make_error(deque->tasks == NULL, "Failed to allocate thread pool deque.");
+    deque->top = 0;
+    deque->bottom = 0;
+}
+
+void thread_pool_deque_push(thread_pool_deque_t *deque, thread_pool_task_t task) {
+    pthread_mutex_lock(&deque->mutex);
+    if (deque->bottom - deque->top == deque->capacity) {
+        // Grow the ring buffer, unwrapping its tasks to start at index 0.
+        thread_pool_task_t *tasks = (thread_pool_task_t *)malloc(2 * deque->capacity * sizeof(thread_pool_task_t));
+        cnd_make_error(tasks == NULL, "Failed to grow thread pool deque.");
+        for (int i = deque->top; i < deque->bottom; i++)
+            tasks[i - deque->top] = deque->tasks[i & (deque->capacity - 1)];
+        free(deque->tasks);
+        deque->tasks = tasks;
+        deque->bottom -= deque->top;
+        deque->top = 0;
+        deque->capacity *= 2;
+    }
+    deque->tasks[deque->bottom & (deque->capacity - 1)] = task;
+    deque->bottom++;
+    pthread_mutex_unlock(&deque->mutex);
+}
+
+int thread_pool_deque_pop(thread_pool_deque_t *deque, thread_pool_task_t *task) {
+    int found = 0;
+    pthread_mutex_lock(&deque->mutex);
+    if (deque->bottom > deque->top) {
+        deque->bottom--;
+        *task = deque->tasks[deque->bottom & (deque->capacity - 1)];
+        found = 1;
+    }
+    pthread_mutex_unlock(&deque->mutex);
+    return found;
+}
+
+int thread_pool_deque_steal(thread_pool_deque_t *deque, thread_pool_task_t *task) {
+    int found = 0;
+    pthread_mutex_lock(&deque->mutex);
+    if (deque->bottom > deque->top) {
+        *task = deque->tasks[deque->top & (deque->capacity - 1)];
+        deque->top++;
+        found = 1;
+    }
+    pthread_mutex_unlock(&deque->mutex);
+    return found;
+}
+
+/**
+ * The deque of the calling thread, its own if it is a worker of the pool, otherwise the shared deque of threads outside the pool.
+*/
+int thread_pool_own_index(thread_pool_t *pool) {
+    return thread_pool_current == pool ? thread_pool_current_index : pool->n_workers;
+}
+
+void thread_pool_push(thread_pool_t *pool, thread_pool_task_t task) {
+    thread_pool_deque_push(&pool->deques[thread_pool_own_index(pool)], task);
+    atomic_fetch_add(&pool->queued, 1);
+    // A worker going to sleep counts itself as sleeping before checking 'queued', so either it sees this task or it is woken here.
+    if (atomic_load(&pool->sleeping) > 0) {
+        pthread_mutex_lock(&pool->sleep_mutex);
+        pthread_cond_signal(&pool->sleep_cond);
+        pthread_mutex_unlock(&pool->sleep_mutex);
+    }
+}
+
+/**
+ * Take the newest task of the deque at 'index', otherwise steal the oldest task of another deque.
+*/
+int thread_pool_find_task(thread_pool_t *pool, int index, thread_pool_task_t *task) {
+    if (atomic_load(&pool->queued) == 0)
+        return 0;
+    int n_deques = pool->n_workers + 1;
+    int found = thread_pool_deque_pop(&pool->deques[index], task);
+    for (int i = 1; !found && i < n_deques; i++)
+        found = thread_pool_deque_steal(&pool->deques[(index + i) % n_deques], task);
+    if (found)
+        atomic_fetch_sub(&pool->queued, 1);
+    return found;
+}
+
+void thread_pool_run_task(thread_pool_task_t *task) {
+    if (task->range_function)
+        task->range_function(task->data, task->start, task->end);
+    else
+        task->function(task->data);
+    atomic_fetch_sub_explicit(&task->group->pending, 1, memory_order_release);
+}
+
+void *thread_pool_worker(void *worker_ptr) {
+    thread_pool_worker_t worker = *(thread_pool_worker_t *)worker_ptr;
+    free(worker_ptr);
+    thread_pool_t *pool = worker.pool;
+    thread_pool_current = pool;
+    thread_pool_current_index = worker.index;
+
+    thread_pool_task_t task;
+    while (1) {
+        if (thread_pool_find_task(pool, worker.index, &task)) {
+            thread_pool_run_task(&task);
+            continue;
+        }
+        pthread_mutex_lock(&pool->sleep_mutex);
+        atomic_fetch_add(&pool->sleeping, 1);
+        while (atomic_load(&pool->queued) == 0 && !atomic_load(&pool->stop))
+            pthread_cond_wait(&pool->sleep_cond, &pool->sleep_mutex);
+        atomic_fetch_sub(&pool->sleeping, 1);
+        pthread_mutex_unlock(&pool->sleep_mutex);
+        if (atomic_load(&pool->stop) && atomic_load(&pool->queued) == 0)
+            break;
+    }
+    return NULL;
+}
@@ -0,0 +1,110 @@
+#ifndef THREAD_POOL
+#define THREAD_POOL
+
+#include <stdatomic.h>
+
+//
+// 'thread_pool.h' definitions
+//
+
+/**
+ * A persistent pool of worker threads, each with its own deque of tasks. Workers take their newest task first and, once their deque is empty,
+ * steal the oldest tasks of the other workers. Threads outside the pool submit to a shared deque which the workers also steal from.
+ * A thread waiting on work runs queued tasks until the work is done, so work may be submitted from within tasks.
+*/
+typedef struct thread_pool_t thread_pool_t;
+
+/**
+ * A task run on the pool, passed the data given when it was submitted.
+*/
+typedef void (*thread_pool_task_function_t)(void *data);
+
+/**
+ * A task run on the pool over the index range [start, end).
+*/
+typedef void (*thread_pool_range_function_t)(void *data, int start, int end);
+
+/**
+ * A set of tasks which can be waited on together.
+*/
+typedef struct {
+    thread_pool_t *pool;
+    atomic_int pending;
+} thread_pool_group_t;
+
+/**
+ * Create a thread pool. The thread waiting on the pool's work takes part in it, so a pool of size n starts n-1 worker threads.
+ * @param size The number of threads the pool's work runs on, or 0 for the number of online CPUs.
+ * @return The thread pool.
+*/
+thread_pool_t *thread_pool_create(int size);
+
+/**
+ * Stop and join the pool's worker threads, and free the pool. No work may be pending. Not intended for the pool returned by 'thread_pool_default'.
+ * @param pool The pool to be deleted.
+*/
+void thread_pool_delete(thread_pool_t *pool);
+
+/**
+ * Get the pool shared by the library, created with the number of online CPUs on first use.
+ * @return The default thread pool.
+*/
+thread_pool_t *thread_pool_default();
+
+/**
+ * Get the number of threads the pool's work runs on, including the waiting thread.
+ * @param pool The pool, or NULL for the default pool.
+ * @return The size of the pool.
+*/
+int thread_pool_size(thread_pool_t *pool);
+
+/**
+ * Get the number of CPUs online.
+ * @return The number of online CPUs, at least 1.
+*/
+int thread_pool_cpu_count();
+
+/**
+ * Initialize an empty task group on the inputted pool.
+ * @param group The group to be initialized.
+ * @param pool The pool the group's tasks are run on, or NULL for the default pool.
+*/
+void thread_pool_group_initialize(thread_pool_group_t *group, thread_pool_t *pool);
+
+/**
+ * Submit a task to the group's pool.
+ * @param group The group the task belongs to.
+ * @param function The task.
+ * @param data The data passed to the task.
+*/
+void thread_pool_group_submit(thread_pool_group_t *group, thread_pool_task_function_t function, void *data);
+
+/**
+ * Submit a task over an index range to the group's pool.
+ * @param group The group the task belongs to.
+ * @param function The task.
+ * @param data The data passed to the task.
+ * @param start The first index of the range.
+ * @param end One past the last index of the range.
+*/
+void thread_pool_group_submit_range(thread_pool_group_t *group, thread_pool_range_function_t function, void *data, int start, int end);
+
+/**
+ * Run queued tasks until every task of the group has completed. Only after this are the group's tasks guaranteed to have run.
+ * @param group The group to wait on.
+*/
+void thread_pool_group_wait(thread_pool_group_t *group);
+
+/**
+ * Split the index range [start, end) into chunks of at least 'grain' indices and run the function on each chunk across the pool, returning once all have completed.
+ * The calling thread runs the first chunk itself. Ranges too small to split are run directly on the calling thread.
+ * @param pool The pool to run on, or NULL for the default pool.
+ * @param start The first index of the range.
+ * @param end One past the last index of the range.
+ * @param grain The smallest number of indices in a chunk.
+ * @param function The function run on each chunk.
+ * @param data The data passed to the function.
+*/
+void thread_pool_parallel_for(thread_pool_t *pool, int start, int end, int grain, thread_pool_range_function_t function, void *data);
+
+#endif
@@ -0,0 +1,13 @@
+#include "timer.h"
+
+#include <time.h>
+
+//
+// 'timer.h' implementations
+//
+
+double timer_seconds() {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
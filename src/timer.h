@@ -0,0 +1,13 @@
+#ifndef TIMER
+#define TIMER
+
+//
+// 'timer.h' definitions
+//
+
+/**
+ * @return The wall clock time in seconds, from an arbitrary starting point. Unlike 'clock', which sums the time of every thread.
+*/
+double timer_seconds();
+
+#endif
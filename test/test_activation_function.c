@@ -0,0 +1,61 @@
+#include "../src/activation_function.h"
+#include "../src/error.h"
+
+#include <math.h>
+#include <stdio.h>
+
+/**
+ * This file checks the batch activation functions against the scalar ones, for doubles and floats,
+ * including the derivative computed from the function's outputs, and in-place use.
+*/
+
+#define N_SAMPLES 1001
+#define SAMPLE_RANGE 40.0
+
+/**
+ * Define 'check_activation_<suffix>', which compares the batch and scalar variants of one activation function.
+*/
+#define CHECK_ACTIVATION_DEFINE(suffix, T, field_suffix, tolerance) \
+    void check_batch_##suffix(const char *name, const char *variant, const T *result, T (*reference)(T), const T *x) { \
+        for (int i = 0; i < N_SAMPLES; i++) { \
+            double expected = (double)reference(x[i]); \
+            if (fabs((double)result[i] - expected) > (tolerance) * (1 + fabs(expected))) { \
+                printf("Activation '%s' variant '%s' (" #T ") mismatches at %lf: %le != %le\n", name, variant, (double)x[i], (double)result[i], expected); \
+                make_error("Batch activation function does not match the scalar function."); \
+            } \
+        } \
+    } \
+    void check_activation_##suffix(activation_function_t af) { \
+        T x[N_SAMPLES]; \
+        T y[N_SAMPLES]; \
+        T d[N_SAMPLES]; \
+        for (int i = 0; i < N_SAMPLES; i++) \
+            x[i] = (T)(SAMPLE_RANGE * i / (N_SAMPLES - 1) - SAMPLE_RANGE / 2); \
+        af.function_batch##field_suffix(y, x, N_SAMPLES); \
+        check_batch_##suffix(af.name, "function", y, af.function##field_suffix, x); \
+        af.derivative_batch##field_suffix(d, x, N_SAMPLES); \
+        check_batch_##suffix(af.name, "derivative", d, af.derivative##field_suffix, x); \
+        af.derivative_output_batch##field_suffix(y, y, N_SAMPLES); \
+        check_batch_##suffix(af.name, "derivative from output", y, af.derivative##field_suffix, x); \
+        for (int i = 0; i < N_SAMPLES; i++) \
+            y[i] = x[i]; \
+        af.function_batch##field_suffix(y, y, N_SAMPLES); \
+        check_batch_##suffix(af.name, "function in-place", y, af.function##field_suffix, x); \
+    }
+
+CHECK_ACTIVATION_DEFINE(f64, double, , 1e-14)
+CHECK_ACTIVATION_DEFINE(f32, float, _f32, 1e-6)
+
+int main(int argc, char *argv[]) {
+    const char *names[] = { "sigmoid", "relu", "leaky_relu" };
+    for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++) {
+        activation_function_t af = activation_function_get(names[i]);
+        check_activation_f64(af);
+        check_activation_f32(af);
+
+        activation_function_t copy;
+        activation_function_copy(af, &copy);
+        cnd_make_error(copy.function_batch != af.function_batch || copy.derivative_output_batch_f32 != af.derivative_output_batch_f32, "Activation function copy is missing the batch functions.");
+    }
+    printf("All activation function checks passed.\n");
+}
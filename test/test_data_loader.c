@@ -0,0 +1,128 @@
+#include "../src/data_loader.h"
+#include "../src/thread_pool.h"
+#include "../src/error.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * This file checks that a data loader hands out every batch of an epoch exactly once, in order for a single consumer,
+ * over several epochs and for several consumers at once, that slots are only reloaded once released,
+ * and that consumers waiting on a slow source are counted as stalled.
+*/
+
+#define N_SLOTS 3
+#define BATCH_SIZE 7
+#define N_CASES 100
+#define N_EPOCHS 3
+#define N_CONSUMERS 4
+#define SLOW_FILL_SECONDS 0.002
+
+typedef struct {
+    int index;
+    int n_cases;
+    int slow;
+} source_t;
+
+typedef struct {
+    int cases[BATCH_SIZE];
+} batch_t;
+
+typedef struct {
+    data_loader_t *loader;
+    atomic_int *visits;
+} consumer_t;
+
+void sleep_seconds(double seconds) {
+    struct timespec ts = { 0, (long)(seconds * 1e9) };
+    nanosleep(&ts, NULL);
+}
+
+/**
+ * Load the next cases, each case being its own index.
+*/
+int fill(void *source_ptr, void *slot) {
+    source_t *source = (source_t *)source_ptr;
+    batch_t *batch = (batch_t *)slot;
+    int n = source->n_cases - source->index < BATCH_SIZE ? source->n_cases - source->index : BATCH_SIZE;
+    if (source->slow)
+        sleep_seconds(SLOW_FILL_SECONDS);
+    for (int i = 0; i < n; i++)
+        batch->cases[i] = source->index + i;
+    source->index += n;
+    return n;
+}
+
+void check_single_consumer(data_loader_t *loader, source_t *source) {
+    for (int epoch = 0; epoch < N_EPOCHS; epoch++) {
+        source->index = 0;
+        data_loader_start_epoch(loader);
+        int expected = 0;
+        int n_cases;
+        int slot;
+        while ((slot = data_loader_acquire(loader, &n_cases)) >= 0) {
+            batch_t *batch = (batch_t *)data_loader_slot(loader, slot);
+            for (int i = 0; i < n_cases; i++)
+                cnd_make_error(batch->cases[i] != expected++, "Data loader batches out of order.");
+            data_loader_release(loader, slot);
+        }
+        cnd_make_error(expected != N_CASES, "Data loader did not load every case of the epoch.");
+        cnd_make_error(data_loader_acquire(loader, &n_cases) != -1, "Data loader handed out a batch after its epoch ended.");
+    }
+}
+
+void consume(void *consumer_ptr) {
+    consumer_t *consumer = (consumer_t *)consumer_ptr;
+    int n_cases;
+    int slot;
+    while ((slot = data_loader_acquire(consumer->loader, &n_cases)) >= 0) {
+        batch_t *batch = (batch_t *)data_loader_slot(consumer->loader, slot);
+        for (int i = 0; i < n_cases; i++)
+            atomic_fetch_add(&consumer->visits[batch->cases[i]], 1);
+        data_loader_release(consumer->loader, slot);
+    }
+}
+
+void check_concurrent_consumers(data_loader_t *loader, source_t *source, thread_pool_t *pool) {
+    atomic_int visits[N_CASES];
+    for (int i = 0; i < N_CASES; i++)
+        atomic_init(&visits[i], 0);
+    consumer_t consumers[N_CONSUMERS];
+    source->index = 0;
+    data_loader_start_epoch(loader);
+    thread_pool_group_t group;
+    thread_pool_group_initialize(&group, pool);
+    for (int i = 0; i < N_CONSUMERS; i++) {
+        consumers[i].loader = loader;
+        consumers[i].visits = visits;
+        thread_pool_group_submit(&group, consume, &consumers[i]);
+    }
+    thread_pool_group_wait(&group);
+    for (int i = 0; i < N_CASES; i++)
+        cnd_make_error(atomic_load(&visits[i]) != 1, "Concurrent consumers did not take every case exactly once.");
+}
+
+int main() {
+    source_t source = { 0, N_CASES, 0 };
+    data_loader_t *loader = data_loader_create(N_SLOTS, sizeof(batch_t), fill, &source);
+    cnd_make_error(data_loader_size(loader) != N_SLOTS, "Data loader has the wrong number of slots.");
+    int n_cases;
+    cnd_make_error(data_loader_acquire(loader, &n_cases) != -1, "Data loader handed out a batch before an epoch started.");
+
+    check_single_consumer(loader, &source);
+    thread_pool_t *pool = thread_pool_create(N_CONSUMERS);
+    for (int epoch = 0; epoch < N_EPOCHS; epoch++)
+        check_concurrent_consumers(loader, &source, pool);
+    thread_pool_delete(pool);
+
+    // A source slower than its consumer stalls it for about the fill time of every batch.
+    source.slow = 1;
+    data_loader_reset_statistics(loader);
+    check_single_consumer(loader, &source);
+    cnd_make_error(data_loader_stall_seconds(loader) < SLOW_FILL_SECONDS, "Consumer of a slow source was not counted as stalled.");
+    data_loader_delete(loader);
+
+    printf("All data loader checks passed.\n");
+}
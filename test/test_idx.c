@@ -0,0 +1,95 @@
+#include "../src/idx.h"
+#include "../src/error.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * This file checks that IDX files of any item shape are mapped with their listed dimensions,
+ * that items and batches are viewed in place at their index, the last batch holding the remainder,
+ * and that a dataset pairs each input with its label.
+*/
+
+#define N_CASES 23
+#define HEIGHT 3
+#define WIDTH 5
+#define DEPTH 2
+#define BATCH_SIZE 8
+
+/**
+ * Write an IDX file of unsigned bytes, each byte a function of its item and position in the item.
+*/
+void write_idx(const char *filename, int n_dimensions, const int32_t *dimensions) {
+    FILE *file = fopen(filename, "wb");
+    cnd_make_error(file == NULL, "Failed to create IDX test file.");
+    unsigned char magic[4] = { 0, 0, 0x08, (unsigned char)n_dimensions };
+    fwrite(magic, 1, 4, file);
+    size_t item_size = 1;
+    for (int i = 0; i < n_dimensions; i++) {
+        unsigned char bytes[4] = { dimensions[i] >> 24, dimensions[i] >> 16, dimensions[i] >> 8, dimensions[i] };
+        fwrite(bytes, 1, 4, file);
+        if (i > 0)
+            item_size *= dimensions[i];
+    }
+    for (int32_t item = 0; item < dimensions[0]; item++) {
+        for (size_t j = 0; j < item_size; j++)
+            fputc((int)((item * 7 + j) % 256), file);
+    }
+    fclose(file);
+}
+
+void check_item(const uint8_t *bytes, int32_t item, size_t item_size) {
+    for (size_t j = 0; j < item_size; j++)
+        cnd_make_error(bytes[j] != (item * 7 + j) % 256, "IDX item viewed at the wrong place.");
+}
+
+int main() {
+    char inputs_filename[] = "/tmp/test_idx_inputs_XXXXXX";
+    char labels_filename[] = "/tmp/test_idx_labels_XXXXXX";
+    close(mkstemp(inputs_filename));
+    close(mkstemp(labels_filename));
+    int32_t input_dimensions[4] = { N_CASES, DEPTH, HEIGHT, WIDTH };
+    int32_t label_dimensions[1] = { N_CASES };
+    write_idx(inputs_filename, 4, input_dimensions);
+    write_idx(labels_filename, 1, label_dimensions);
+
+    idx_file_t file;
+    idx_file_open(&file, inputs_filename);
+    cnd_make_error(file.n_dimensions != 4 || file.n_items != N_CASES, "IDX file's listed dimensions were not read.");
+    cnd_make_error(file.dimensions[1] != DEPTH || file.dimensions[2] != HEIGHT || file.dimensions[3] != WIDTH, "IDX file's item dimensions were not read.");
+    cnd_make_error(file.item_size != DEPTH * HEIGHT * WIDTH, "IDX file's item size is wrong.");
+    for (int32_t i = 0; i < N_CASES; i++)
+        check_item(idx_file_item(&file, i), i, file.item_size);
+    int n_items;
+    idx_file_items(&file, N_CASES - 3, BATCH_SIZE, &n_items);
+    cnd_make_error(n_items != 3, "IDX items past the end of the file were viewed.");
+    idx_file_items(&file, N_CASES, BATCH_SIZE, &n_items);
+    cnd_make_error(n_items != 0, "IDX items past the end of the file were viewed.");
+    idx_file_close(&file);
+
+    idx_dataset_t dataset;
+    idx_dataset_open(&dataset, inputs_filename, labels_filename);
+    int32_t n_batches = idx_dataset_batch_count(&dataset, BATCH_SIZE);
+    cnd_make_error(n_batches != (N_CASES + BATCH_SIZE - 1) / BATCH_SIZE, "IDX dataset has the wrong number of batches.");
+    int n_cases = 0;
+    // Batches are viewed in any order.
+    for (int32_t b = n_batches - 1; b >= 0; b--) {
+        idx_batch_t batch = idx_dataset_batch(&dataset, b, BATCH_SIZE);
+        int expected = b == n_batches - 1 ? N_CASES - b * BATCH_SIZE : BATCH_SIZE;
+        cnd_make_error(batch.n_cases != expected, "IDX batch has the wrong number of cases.");
+        for (int i = 0; i < batch.n_cases; i++) {
+            int32_t item = b * BATCH_SIZE + i;
+            check_item(batch.inputs + i * dataset.inputs.item_size, item, dataset.inputs.item_size);
+            check_item(batch.labels + i, item, 1);
+        }
+        n_cases += batch.n_cases;
+    }
+    cnd_make_error(n_cases != N_CASES, "IDX batches did not cover the dataset.");
+    cnd_make_error(idx_dataset_batch(&dataset, n_batches, BATCH_SIZE).n_cases != 0, "IDX batch past the end of the dataset has cases.");
+    idx_dataset_close(&dataset);
+
+    remove(inputs_filename);
+    remove(labels_filename);
+    printf("All IDX checks passed.\n");
+}
@@ -0,0 +1,90 @@
+#include "../src/idx_cache.h"
+#include "../src/error.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * This file checks that an IDX cache holds its source's bytes divided by the scale, as floats or doubles, aligned to a cache line,
+ * that it is mapped rather than written again while its source and settings are unchanged,
+ * and that it is written again once its source is modified or a different type or scale is asked for.
+*/
+
+#define N_ITEMS 9
+#define ITEM_SIZE 12
+#define SCALE 255.0
+
+void write_idx(const char *filename, int offset) {
+    FILE *file = fopen(filename, "wb");
+    cnd_make_error(file == NULL, "Failed to create IDX test file.");
+    unsigned char header[12] = { 0, 0, 0x08, 2, 0, 0, 0, N_ITEMS, 0, 0, 0, ITEM_SIZE };
+    fwrite(header, 1, sizeof(header), file);
+    for (int i = 0; i < N_ITEMS * ITEM_SIZE; i++)
+        fputc((i * 3 + offset) % 256, file);
+    fclose(file);
+}
+
+/**
+ * Set the file's modification time, so a rewritten source differs from its cache's key even within the file system's time resolution.
+*/
+void set_mtime(const char *filename, time_t seconds) {
+    struct timespec times[2] = { { seconds, 0 }, { seconds, 0 } };
+    cnd_make_error(utimensat(AT_FDCWD, filename, times, 0) != 0, "Failed to set IDX test file's time.");
+}
+
+void check_values(idx_cache_t *cache, int offset) {
+    cnd_make_error(cache->n_items != N_ITEMS || cache->item_size != ITEM_SIZE, "IDX cache lists the wrong number of items.");
+    cnd_make_error((uintptr_t)cache->data % IDX_CACHE_ALIGNMENT != 0, "IDX cache values are not aligned.");
+    for (int32_t i = 0; i < N_ITEMS; i++) {
+        for (int j = 0; j < ITEM_SIZE; j++) {
+            double expected = ((i * ITEM_SIZE + j) * 3 + offset) % 256 / SCALE;
+            if (cache->type == IDX_CACHE_F32)
+                cnd_make_error(idx_cache_item_f32(cache, i)[j] != (float)expected, "IDX cache float is not its normalized byte.");
+            else
+                cnd_make_error(idx_cache_item_f64(cache, i)[j] != expected, "IDX cache double is not its normalized byte.");
+        }
+    }
+}
+
+int main() {
+    char source_filename[] = "/tmp/test_idx_cache_XXXXXX";
+    close(mkstemp(source_filename));
+    char cache_filename[64];
+    snprintf(cache_filename, sizeof(cache_filename), "%s.cache", source_filename);
+    write_idx(source_filename, 0);
+    set_mtime(source_filename, 1000000000);
+    remove(cache_filename);
+
+    idx_cache_t cache;
+    cnd_make_error(idx_cache_open(&cache, source_filename, cache_filename, IDX_CACHE_F32, SCALE) != 0, "Missing IDX cache was not written.");
+    check_values(&cache, 0);
+    idx_cache_close(&cache);
+    cnd_make_error(idx_cache_open(&cache, source_filename, cache_filename, IDX_CACHE_F32, SCALE) != 1, "Unchanged IDX cache was written again.");
+    check_values(&cache, 0);
+    idx_cache_close(&cache);
+
+    // Another type or scale is written over the cache.
+    cnd_make_error(idx_cache_open(&cache, source_filename, cache_filename, IDX_CACHE_F64, SCALE) != 0, "IDX cache of another type was not written.");
+    check_values(&cache, 0);
+    idx_cache_close(&cache);
+    cnd_make_error(idx_cache_open(&cache, source_filename, cache_filename, IDX_CACHE_F64, SCALE * 2) != 0, "IDX cache of another scale was not written.");
+    idx_cache_close(&cache);
+    cnd_make_error(idx_cache_open(&cache, source_filename, cache_filename, IDX_CACHE_F64, SCALE) != 0, "IDX cache of another scale was not written.");
+    idx_cache_close(&cache);
+
+    // A modified source is written over its cache.
+    write_idx(source_filename, 1);
+    set_mtime(source_filename, 1000000001);
+    cnd_make_error(idx_cache_open(&cache, source_filename, cache_filename, IDX_CACHE_F64, SCALE) != 0, "IDX cache of a modified source was not written.");
+    check_values(&cache, 1);
+    idx_cache_close(&cache);
+    cnd_make_error(idx_cache_open(&cache, source_filename, cache_filename, IDX_CACHE_F64, SCALE) != 1, "Unchanged IDX cache was written again.");
+    idx_cache_close(&cache);
+
+    remove(source_filename);
+    remove(cache_filename);
+    printf("All IDX cache checks passed.\n");
+}
@@ -0,0 +1,149 @@
+#include "../src/matrix.h"
+#include "../src/matrix_arena.h"
+#include "../src/neural_network.h"
+#include "../src/neural_network_train.h"
+#include "../src/random.h"
+#include "../src/error.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * This file checks that arena allocations are aligned and non-overlapping, that resets and checkpoints reuse the arena's blocks,
+ * and that a neural network created in an arena trains like one created on the heap without growing the scratch arena after the first case.
+*/
+
+#define TRAINING_CASES 100
+
+void check_aligned(void *ptr) {
+    cnd_make_error((uintptr_t)ptr % MATRIX_ARENA_ALIGNMENT != 0, "Arena allocation is not aligned.");
+}
+
+void check_allocations() {
+    // A zero-initialized arena is usable.
+    matrix_arena_t arena = { 0 };
+    int sizes[] = { 1, 7, 64, 65, 1000, 3 * MATRIX_ARENA_DEFAULT_CAPACITY, 12 };
+    unsigned char *ptrs[sizeof(sizes) / sizeof(sizes[0])];
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        ptrs[i] = (unsigned char *)matrix_arena_alloc(&arena, sizes[i]);
+        check_aligned(ptrs[i]);
+        for (int j = 0; j < sizes[i]; j++)
+            ptrs[i][j] = (unsigned char)i;
+    }
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        for (int j = 0; j < sizes[i]; j++)
+            cnd_make_error(ptrs[i][j] != (unsigned char)i, "Arena allocations overlap.");
+    }
+
+    // Reset reuses the same blocks, repeating the allocations allocates nothing new.
+    size_t capacity = matrix_arena_capacity(&arena);
+    matrix_arena_reset(&arena);
+    cnd_make_error(matrix_arena_alloc(&arena, sizes[0]) != ptrs[0], "Arena reset did not return to the first block.");
+    for (int i = 1; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++)
+        matrix_arena_alloc(&arena, sizes[i]);
+    cnd_make_error(matrix_arena_capacity(&arena) != capacity, "Arena grew when repeating allocations after a reset.");
+
+    // Restoring a checkpoint releases only what was allocated after it.
+    matrix_arena_reset(&arena);
+    void *kept = matrix_arena_alloc(&arena, 100);
+    matrix_arena_checkpoint_t checkpoint = matrix_arena_checkpoint(&arena);
+    void *released = matrix_arena_alloc(&arena, 2 * MATRIX_ARENA_DEFAULT_CAPACITY);
+    matrix_arena_restore(&arena, checkpoint);
+    void *after = matrix_arena_alloc(&arena, 100);
+    cnd_make_error(after == kept, "Arena checkpoint released an allocation made before it.");
+    size_t restored_capacity = matrix_arena_capacity(&arena);
+    cnd_make_error(matrix_arena_alloc(&arena, 2 * MATRIX_ARENA_DEFAULT_CAPACITY) != released, "Arena restore did not reuse the released block.");
+    cnd_make_error(matrix_arena_capacity(&arena) != restored_capacity, "Arena grew when repeating allocations after a restore.");
+
+    matrix_arena_free(&arena);
+    cnd_make_error(matrix_arena_capacity(&arena) != 0, "Freed arena still holds blocks.");
+}
+
+void check_matrices() {
+    matrix_arena_t *arena = matrix_arena_create(1024);
+    matrix_t *mat = matrix_create_from_arena(5, 3, arena);
+    matrix_t mat_f;
+    matrix_create_i_from_arena(&mat_f, 3, 5, arena);
+    check_aligned(mat->data);
+    check_aligned(mat_f.data);
+    cnd_make_error(mat->cols != 5 || mat->rows != 3 || mat->stride || mat->transposed, "Arena matrix has the wrong shape.");
+    for (int j = 0; j < 3; j++) {
+        for (int i = 0; i < 5; i++) {
+            matrix_set(mat, i, j, i + 5 * j);
+            matrix_set(&mat_f, j, i, i + 5 * j);
+        }
+    }
+    matrix_t view_t = matrix_transpose_view(&mat_f);
+    for (int j = 0; j < 3; j++) {
+        for (int i = 0; i < 5; i++)
+            cnd_make_error(matrix_get(mat, i, j) != matrix_get(&view_t, i, j), "Arena matrices overlap.");
+    }
+    matrix_arena_delete(arena);
+}
+
+void check_network() {
+    int hidden_layer_sizes[2] = { 13, 7 };
+    char *activation_functions[3] = { "sigmoid", "relu", "sigmoid" };
+    neural_network_t *nn_heap = neural_network_create(9, 4, 2, hidden_layer_sizes, activation_functions);
+    matrix_arena_t *arena = matrix_arena_create(0);
+    neural_network_t *nn_arena = neural_network_create_from_arena(9, 4, 2, hidden_layer_sizes, activation_functions, arena);
+    neural_network_layers_randomize(nn_heap);
+    for (int i = 0; i < nn_heap->hidden_layer_count + 1; i++) {
+        check_aligned(nn_arena->layers[i].weights.data);
+        check_aligned(nn_arena->layers[i].biases.data);
+        matrix_copy_o(&nn_heap->layers[i].weights, &nn_arena->layers[i].weights);
+        matrix_copy_o(&nn_heap->layers[i].biases, &nn_arena->layers[i].biases);
+    }
+
+    matrix_t *input = matrix_create_from_arena(1, 9, arena);
+    matrix_t *output = matrix_create_from_arena(1, 4, arena);
+    matrix_t *result_heap = matrix_create_from_arena(1, 4, arena);
+    matrix_t *result_arena = matrix_create_from_arena(1, 4, arena);
+
+    // The scratch arena only grows on the first case.
+    matrix_arena_t *scratch = matrix_arena_scratch();
+    size_t scratch_capacity = 0;
+    for (int n = 0; n < TRAINING_CASES; n++) {
+        for (int j = 0; j < 9; j++)
+            matrix_set(input, 0, j, random_double_between(-1, 1));
+        for (int j = 0; j < 4; j++)
+            matrix_set(output, 0, j, random_double_between(0, 1));
+        neural_network_train_case(nn_heap, input, output, 0.1);
+        neural_network_train_case(nn_arena, input, output, 0.1);
+        if (n == 0)
+            scratch_capacity = matrix_arena_capacity(scratch);
+        cnd_make_error(matrix_arena_capacity(scratch) != scratch_capacity, "Scratch arena grew after the first training case.");
+    }
+
+    neural_network_evaluate(nn_heap, 1, input, result_heap);
+    neural_network_evaluate(nn_arena, 1, input, result_arena);
+    cnd_make_error(matrix_arena_capacity(scratch) != scratch_capacity, "Scratch arena grew during evaluation.");
+    for (int j = 0; j < 4; j++)
+        cnd_make_error(matrix_get(result_heap, 0, j) != matrix_get(result_arena, 0, j), "Arena network trained differently to heap network.");
+
+    // An evaluation allocated from an arena matches one allocated on the heap.
+    neural_network_evaluation_t eval_heap, eval_arena;
+    neural_network_evaluation_initialize(nn_heap, &eval_heap);
+    neural_network_evaluation_initialize_from_arena(nn_arena, &eval_arena, arena);
+    neural_network_evaluation_outputs(nn_heap, input, eval_heap);
+    neural_network_evaluation_outputs(nn_arena, input, eval_arena);
+    for (int i = 0; i < nn_heap->hidden_layer_count + 1; i++) {
+        check_aligned(eval_arena.all_data);
+        for (int j = 0; j < eval_heap.layers[i].outputs.rows; j++)
+            cnd_make_error(matrix_get(&eval_heap.layers[i].outputs, 0, j) != matrix_get(&eval_arena.layers[i].outputs, 0, j), "Arena evaluation differs from heap evaluation.");
+    }
+    neural_network_evaluation_delete(eval_heap);
+
+    neural_network_delete(nn_heap);
+    matrix_arena_delete(arena);
+}
+
+int main() {
+    random_init_seeded(7);
+
+    check_allocations();
+    check_matrices();
+    check_network();
+
+    printf("All matrix arena checks passed.\n");
+}
@@ -0,0 +1,171 @@
+#include "../src/matrix.h"
+#include "../src/matrix_gemm.h"
+#include "../src/random.h"
+#include "../src/error.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * This file checks the blocked matrix multiplication engine against a direct triple loop,
+ * over shapes which exercise the vector, narrow, small, packed and threaded paths, partial register tiles, strided and transposed operands.
+*/
+
+#define TOLERANCE 1e-9
+
+double gemm_reference_entry(int k, const double *a, int rsa, int csa, const double *b, int rsb, int csb, int i, int j) {
+    double sum = 0;
+    for (int p = 0; p < k; p++)
+        sum += a[i * rsa + p * csa] * b[p * rsb + j * csb];
+    return sum;
+}
+
+void check_gemm(int m, int n, int k, int transpose_a, int transpose_b, double alpha, double beta) {
+    // Pad the leading dimension so strides differ from the logical width.
+    int lda = (transpose_a ? m : k) + 3;
+    int ldb = (transpose_b ? k : n) + 1;
+    int ldc = n + 2;
+    double *a = (double *)malloc((transpose_a ? k : m) * lda * sizeof(double));
+    double *b = (double *)malloc((transpose_b ? n : k) * ldb * sizeof(double));
+    double *c = (double *)malloc(m * ldc * sizeof(double));
+    double *c_initial = (double *)malloc(m * ldc * sizeof(double));
+    for (int i = 0; i < (transpose_a ? k : m) * lda; i++)
+        a[i] = random_double_between(-1, 1);
+    for (int i = 0; i < (transpose_b ? n : k) * ldb; i++)
+        b[i] = random_double_between(-1, 1);
+    for (int i = 0; i < m * ldc; i++)
+        c[i] = c_initial[i] = random_double_between(-1, 1);
+
+    int rsa = transpose_a ? 1 : lda;
+    int csa = transpose_a ? lda : 1;
+    int rsb = transpose_b ? 1 : ldb;
+    int csb = transpose_b ? ldb : 1;
+    matrix_gemm(m, n, k, alpha, a, rsa, csa, b, rsb, csb, beta, c, ldc, 1);
+
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < ldc; j++) {
+            double expected = c_initial[i * ldc + j];
+            if (j < n)
+                expected = alpha * gemm_reference_entry(k, a, rsa, csa, b, rsb, csb, i, j) + beta * expected;
+            if (fabs(c[i * ldc + j] - expected) > TOLERANCE * (k + 1)) {
+                printf("Mismatch for m=%d n=%d k=%d transpose_a=%d transpose_b=%d at (%d, %d): %lf != %lf\n", m, n, k, transpose_a, transpose_b, i, j, c[i * ldc + j], expected);
+                make_error("Matrix multiplication does not match the reference.");
+            }
+        }
+    }
+
+    free(a);
+    free(b);
+    free(c);
+    free(c_initial);
+}
+
+double epilogue_function(double z) {
+    return z * z + 1;
+}
+
+double epilogue_derivative(double z) {
+    return 2 * z;
+}
+
+void epilogue_function_batch(double *y, const double *x, int n) {
+    for (int i = 0; i < n; i++)
+        y[i] = epilogue_function(x[i]);
+}
+
+void epilogue_derivative_batch(double *y, const double *x, int n) {
+    for (int i = 0; i < n; i++)
+        y[i] = epilogue_derivative(x[i]);
+}
+
+/**
+ * Check the epilogue against the reference, with a bias per row, an activation and a derivative written in column-major order.
+*/
+void check_gemm_epilogue(int m, int n, int k, int transpose_a, double beta) {
+    int rsa = transpose_a ? 1 : k;
+    int csa = transpose_a ? m : 1;
+    double *a = (double *)malloc(m * k * sizeof(double));
+    double *b = (double *)malloc(k * n * sizeof(double));
+    double *c = (double *)malloc(m * n * sizeof(double));
+    double *c_initial = (double *)malloc(m * n * sizeof(double));
+    double *d = (double *)malloc(m * n * sizeof(double));
+    double *bias = (double *)malloc(m * sizeof(double));
+    for (int i = 0; i < m * k; i++)
+        a[i] = random_double_between(-1, 1);
+    for (int i = 0; i < k * n; i++)
+        b[i] = random_double_between(-1, 1);
+    for (int i = 0; i < m * n; i++)
+        c[i] = c_initial[i] = random_double_between(-1, 1);
+    for (int i = 0; i < m; i++)
+        bias[i] = random_double_between(-1, 1);
+
+    matrix_gemm_epilogue_t epilogue = { bias, epilogue_function_batch, epilogue_derivative_batch, NULL, d, 1, m };
+    matrix_gemm_epilogue(m, n, k, 1, a, rsa, csa, b, n, 1, beta, c, n, 1, &epilogue);
+
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) {
+            double z = gemm_reference_entry(k, a, rsa, csa, b, n, 1, i, j) + beta * c_initial[i * n + j] + bias[i];
+            if (fabs(c[i * n + j] - epilogue_function(z)) > TOLERANCE * (k + 1) * 4 || fabs(d[i + j * m] - epilogue_derivative(z)) > TOLERANCE * (k + 1) * 4) {
+                printf("Epilogue mismatch for m=%d n=%d k=%d transpose_a=%d at (%d, %d)\n", m, n, k, transpose_a, i, j);
+                make_error("Matrix multiplication epilogue does not match the reference.");
+            }
+        }
+    }
+
+    free(a);
+    free(b);
+    free(c);
+    free(c_initial);
+    free(d);
+    free(bias);
+}
+
+int main(int argc, char *argv[]) {
+    random_init_seeded(1);
+
+    int shapes[][3] = {
+        { 1, 1, 1 }, { 32, 1, 784 }, { 10, 1, 32 }, { 1, 32, 10 }, { 3, 5, 7 }, { 64, 3, 784 },
+        { 17, 13, 9 }, { 64, 64, 64 }, { 97, 101, 103 }, { 100, 37, 300 }, { 260, 130, 520 }
+    };
+    int n_shapes = sizeof(shapes) / sizeof(shapes[0]);
+    for (int s = 0; s < n_shapes; s++) {
+        for (int t = 0; t < 4; t++) {
+            check_gemm(shapes[s][0], shapes[s][1], shapes[s][2], t & 1, t >> 1, 1, 0);
+            check_gemm(shapes[s][0], shapes[s][1], shapes[s][2], t & 1, t >> 1, -0.5, 0.75);
+        }
+        check_gemm_epilogue(shapes[s][0], shapes[s][1], shapes[s][2], 0, 0);
+        check_gemm_epilogue(shapes[s][0], shapes[s][1], shapes[s][2], 1, 0.5);
+    }
+
+    // Products above the threading threshold split into tiles across pools of several sizes, tall, wide and with partial tiles.
+    int parallel_shapes[][3] = { { 260, 130, 520 }, { 32, 1031, 784 }, { 1001, 67, 129 } };
+    int pool_sizes[] = { 2, 3, 7 };
+    for (int p = 0; p < (int)(sizeof(pool_sizes) / sizeof(pool_sizes[0])); p++) {
+        thread_pool_t *pool = thread_pool_create(pool_sizes[p]);
+        matrix_gemm_set_thread_pool(pool);
+        for (int s = 0; s < (int)(sizeof(parallel_shapes) / sizeof(parallel_shapes[0])); s++) {
+            check_gemm(parallel_shapes[s][0], parallel_shapes[s][1], parallel_shapes[s][2], p & 1, p >> 1, -0.5, 0.75);
+            check_gemm_epilogue(parallel_shapes[s][0], parallel_shapes[s][1], parallel_shapes[s][2], 1, 0.5);
+        }
+        matrix_gemm_set_thread_pool(NULL);
+        thread_pool_delete(pool);
+    }
+
+    // The matrix API on top of the engine.
+    matrix_t *mat_A = matrix_create(3, 2);
+    matrix_t *mat_B = matrix_create(2, 3);
+    for (int i = 0; i < 6; i++) {
+        mat_A->data[i] = i + 1;
+        mat_B->data[i] = 6 - i;
+    }
+    matrix_t *mat_C = matrix_multiply(mat_A, mat_B);
+    double expected[4] = { 20, 14, 56, 41 };
+    for (int i = 0; i < 4; i++)
+        cnd_make_error(mat_C->data[i] != expected[i], "matrix_multiply result is incorrect.");
+    matrix_delete(mat_A);
+    matrix_delete(mat_B);
+    matrix_delete(mat_C);
+
+    printf("All matrix multiplication checks passed.\n");
+}
@@ -0,0 +1,174 @@
+#include "../src/matrix_kernels.h"
+#include "../src/random.h"
+#include "../src/error.h"
+
+#include <math.h>
+#include <stdio.h>
+
+/**
+ * This file checks every element-wise kernel, and every fused optimizer update, of every instruction set supported by the host against the reference loop,
+ * for doubles and floats, over lengths which exercise full vectors, remainders and unaligned starting addresses.
+*/
+
+#define MAX_LENGTH 131
+#define MAX_OFFSET 3
+#define TOLERANCE 1e-6
+// Relative error bounds of the 'exp' kernels, 2 ulp, checked over the whole clamped input range.
+#define EXP_SAMPLES 100000
+#define EXP_TOLERANCE_f64 4.5e-16
+#define EXP_TOLERANCE_f32 2.4e-7
+
+/**
+ * Define 'check_kernels_<suffix>', which runs every kernel of a table over arrays of type T.
+*/
+#define CHECK_KERNELS_DEFINE(suffix, T, KERNELS_T) \
+    void check_result_##suffix(const KERNELS_T *kernels, const char *kernel_name, const T *result, const T *expected, int n, int offset) { \
+        for (int i = 0; i < MAX_LENGTH + MAX_OFFSET; i++) { \
+            if (fabs((double)result[i] - (double)expected[i]) > TOLERANCE) { \
+                printf("Kernel '%s' of '%s' (" #T ") mismatches for n=%d offset=%d at %d: %lf != %lf\n", kernel_name, kernels->name, n, offset, i, (double)result[i], (double)expected[i]); \
+                make_error("Element-wise kernel does not match the reference loop."); \
+            } \
+        } \
+    } \
+    void check_kernels_##suffix(const KERNELS_T *kernels, double min, double max) { \
+        T a_data[MAX_LENGTH + MAX_OFFSET]; \
+        T b_data[MAX_LENGTH + MAX_OFFSET]; \
+        T result[MAX_LENGTH + MAX_OFFSET]; \
+        T expected[MAX_LENGTH + MAX_OFFSET]; \
+        T state[MAX_LENGTH + MAX_OFFSET]; \
+        T state_2[MAX_LENGTH + MAX_OFFSET]; \
+        T expected_state[MAX_LENGTH + MAX_OFFSET]; \
+        T expected_state_2[MAX_LENGTH + MAX_OFFSET]; \
+        for (int offset = 0; offset <= MAX_OFFSET; offset++) { \
+            for (int n = 0; n + offset <= MAX_LENGTH; n++) { \
+                for (int i = 0; i < MAX_LENGTH + MAX_OFFSET; i++) { \
+                    a_data[i] = (T)random_double_between(-1, 1); \
+                    b_data[i] = (T)random_double_between(-1, 1); \
+                } \
+                T *a = result + offset; \
+                T *e = expected + offset; \
+                T *b = b_data + offset; \
+                T alpha = (T)random_double_between(-2, 2); \
+                \
+                for (int i = 0; i < MAX_LENGTH + MAX_OFFSET; i++) \
+                    result[i] = expected[i] = a_data[i]; \
+                kernels->add(a, b, n); \
+                for (int i = 0; i < n; i++) \
+                    e[i] += b[i]; \
+                check_result_##suffix(kernels, "add", result, expected, n, offset); \
+                \
+                for (int i = 0; i < MAX_LENGTH + MAX_OFFSET; i++) \
+                    result[i] = expected[i] = a_data[i]; \
+                kernels->subtract(a, b, n); \
+                for (int i = 0; i < n; i++) \
+                    e[i] -= b[i]; \
+                check_result_##suffix(kernels, "subtract", result, expected, n, offset); \
+                \
+                for (int i = 0; i < MAX_LENGTH + MAX_OFFSET; i++) \
+                    result[i] = expected[i] = a_data[i]; \
+                kernels->multiply(a, b, n); \
+                for (int i = 0; i < n; i++) \
+                    e[i] *= b[i]; \
+                check_result_##suffix(kernels, "multiply", result, expected, n, offset); \
+                \
+                for (int i = 0; i < MAX_LENGTH + MAX_OFFSET; i++) \
+                    result[i] = expected[i] = 0; \
+                kernels->copy(a, b, n); \
+                for (int i = 0; i < n; i++) \
+                    e[i] = b[i]; \
+                check_result_##suffix(kernels, "copy", result, expected, n, offset); \
+                \
+                for (int i = 0; i < MAX_LENGTH + MAX_OFFSET; i++) \
+                    result[i] = expected[i] = a_data[i]; \
+                kernels->axpy(a, alpha, b, n); \
+                for (int i = 0; i < n; i++) \
+                    e[i] += alpha * b[i]; \
+                check_result_##suffix(kernels, "axpy", result, expected, n, offset); \
+                \
+                for (int i = 0; i < MAX_LENGTH + MAX_OFFSET; i++) \
+                    result[i] = expected[i] = a_data[i]; \
+                kernels->exp(a, b, n); \
+                for (int i = 0; i < n; i++) \
+                    e[i] = (T)exp((double)b[i]); \
+                check_result_##suffix(kernels, "exp", result, expected, n, offset); \
+                \
+                /* The optimizer updates, with their state in 'state' and 'state_2', kept non-negative where it is a mean square. */ \
+                T lr = (T)0.01, mu = (T)0.9, b2 = (T)0.999, eps = (T)1e-8; \
+                for (int op = 0; op < 4; op++) { \
+                    for (int i = 0; i < MAX_LENGTH + MAX_OFFSET; i++) { \
+                        result[i] = expected[i] = a_data[i]; \
+                        state[i] = expected_state[i] = (T)fabs((double)b_data[MAX_LENGTH + MAX_OFFSET - 1 - i]); \
+                        state_2[i] = expected_state_2[i] = (T)fabs((double)a_data[MAX_LENGTH + MAX_OFFSET - 1 - i]); \
+                    } \
+                    T *s = state + offset; \
+                    T *s_e = expected_state + offset; \
+                    T *s_2 = state_2 + offset; \
+                    T *s_2e = expected_state_2 + offset; \
+                    const char *names[4] = { "momentum", "nesterov", "rmsprop", "adam" }; \
+                    if (op == 0) \
+                        kernels->momentum(a, s, b, lr, mu, n); \
+                    if (op == 1) \
+                        kernels->nesterov(a, s, b, lr, mu, n); \
+                    if (op == 2) \
+                        kernels->rmsprop(a, s, b, lr, mu, eps, n); \
+                    if (op == 3) \
+                        kernels->adam(a, s, s_2, b, lr, mu, b2, eps, n); \
+                    for (int i = 0; i < n; i++) { \
+                        if (op == 0 || op == 1) { \
+                            s_e[i] = mu * s_e[i] + b[i]; \
+                            e[i] -= lr * (op == 0 ? s_e[i] : b[i] + mu * s_e[i]); \
+                        } \
+                        if (op == 2) { \
+                            s_e[i] = mu * s_e[i] + (1 - mu) * b[i] * b[i]; \
+                            e[i] -= lr * b[i] / ((T)sqrt((double)s_e[i]) + eps); \
+                        } \
+                        if (op == 3) { \
+                            s_e[i] = mu * s_e[i] + (1 - mu) * b[i]; \
+                            s_2e[i] = b2 * s_2e[i] + (1 - b2) * b[i] * b[i]; \
+                            e[i] -= lr * s_e[i] / ((T)sqrt((double)s_2e[i]) + eps); \
+                        } \
+                    } \
+                    check_result_##suffix(kernels, names[op], result, expected, n, offset); \
+                    check_result_##suffix(kernels, names[op], state, expected_state, n, offset); \
+                    check_result_##suffix(kernels, names[op], state_2, expected_state_2, n, offset); \
+                } \
+            } \
+        } \
+        \
+        /* 'exp' in-place and across its range, against the C library in long double. */ \
+        static T x[EXP_SAMPLES]; \
+        static T y[EXP_SAMPLES]; \
+        for (int i = 0; i < EXP_SAMPLES; i++) \
+            x[i] = y[i] = (T)(min + (max - min) * i / (EXP_SAMPLES - 1)); \
+        kernels->exp(y, y, EXP_SAMPLES); \
+        for (int i = 0; i < EXP_SAMPLES; i++) { \
+            long double reference = expl((long double)x[i]); \
+            if (fabsl((y[i] - reference) / reference) > EXP_TOLERANCE_##suffix) { \
+                printf("Kernel 'exp' of '%s' (" #T ") is out of bounds at %lf: %le != %Le\n", kernels->name, (double)x[i], (double)y[i], reference); \
+                make_error("Element-wise kernel 'exp' exceeds its error bound."); \
+            } \
+        } \
+    }
+
+CHECK_KERNELS_DEFINE(f64, double, matrix_kernels_t)
+CHECK_KERNELS_DEFINE(f32, float, matrix_kernels_f32_t)
+
+int main(int argc, char *argv[]) {
+    random_init_seeded(2);
+
+    cnd_make_error(matrix_kernels_get(MATRIX_ISA_SCALAR) == NULL, "The scalar kernels must always be available.");
+    cnd_make_error(matrix_f32_kernels_get(MATRIX_ISA_SCALAR) == NULL, "The scalar kernels must always be available.");
+    for (int isa = 0; isa < MATRIX_ISA_COUNT; isa++) {
+        const matrix_kernels_t *kernels = matrix_kernels_get((matrix_isa_t)isa);
+        const matrix_kernels_f32_t *kernels_f32 = matrix_f32_kernels_get((matrix_isa_t)isa);
+        if (kernels == NULL || kernels_f32 == NULL) {
+            printf("Instruction set %d not supported on this host, skipping.\n", isa);
+            continue;
+        }
+        cnd_make_error(kernels->isa != (matrix_isa_t)isa || kernels_f32->isa != (matrix_isa_t)isa, "Kernel table reports the wrong instruction set.");
+        check_kernels_f64(kernels, -708, 709);
+        check_kernels_f32(kernels_f32, -87, 88);
+        printf("Kernels '%s' passed.\n", kernels->name);
+    }
+    printf("Selected kernels: '%s'.\n", matrix_kernels()->name);
+}
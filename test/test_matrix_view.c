@@ -0,0 +1,128 @@
+#include "../src/matrix.h"
+#include "../src/random.h"
+#include "../src/error.h"
+
+#include <math.h>
+#include <stdio.h>
+
+/**
+ * This file checks that transposed and block views of a matrix address the same entries as their copies,
+ * and that multiplication and element-wise operations on views match the same operations on the copies.
+*/
+
+#define TOLERANCE 1e-12
+
+void check_equal(matrix_t *mat_A, matrix_t *mat_B, const char *operation) {
+    cnd_make_error(mat_A->cols != mat_B->cols || mat_A->rows != mat_B->rows, "View and copy dimensions differ.");
+    for (int j = 0; j < mat_A->rows; j++) {
+        for (int i = 0; i < mat_A->cols; i++) {
+            if (fabs(matrix_get(mat_A, i, j) - matrix_get(mat_B, i, j)) > TOLERANCE) {
+                printf("Mismatch after '%s' at (%d, %d): %lf != %lf\n", operation, i, j, matrix_get(mat_A, i, j), matrix_get(mat_B, i, j));
+                make_error("Operation on a view does not match the operation on a copy.");
+            }
+        }
+    }
+}
+
+void fill_random(matrix_t *mat) {
+    for (int j = 0; j < mat->rows; j++) {
+        for (int i = 0; i < mat->cols; i++)
+            matrix_set(mat, i, j, random_double_between(-1, 1));
+    }
+}
+
+/**
+ * Copy a view entry by entry into a new matrix with packed rows.
+*/
+matrix_t *copy_entries(matrix_t *mat) {
+    matrix_t *copy = matrix_create(mat->cols, mat->rows);
+    for (int j = 0; j < mat->rows; j++) {
+        for (int i = 0; i < mat->cols; i++)
+            matrix_set(copy, i, j, matrix_get(mat, i, j));
+    }
+    return copy;
+}
+
+void check_views(int cols, int rows) {
+    matrix_t *mat = matrix_create(cols, rows);
+    fill_random(mat);
+
+    // Transposed view addresses the transpose.
+    matrix_t view_t = matrix_transpose_view(mat);
+    matrix_t *copy_t = matrix_transpose_n(mat);
+    check_equal(&view_t, copy_t, "transpose_view");
+
+    // The transpose of the transposed view is the matrix.
+    matrix_t view_tt = matrix_transpose_view(&view_t);
+    check_equal(&view_tt, mat, "transpose_view twice");
+
+    // Blocks of the matrix and of its transpose, which have strided rows or columns.
+    matrix_t block = matrix_block_view(mat, 1, 1, cols - 2, rows - 2);
+    matrix_t *copy_block = copy_entries(&block);
+    matrix_t block_t = matrix_block_view(&view_t, 1, 1, rows - 2, cols - 2);
+    matrix_t *copy_block_t = copy_entries(&block_t);
+    matrix_t block_tt = matrix_transpose_view(&block_t);
+    check_equal(&block_tt, copy_block, "block_view of transpose_view");
+
+    // Multiplication through views, (block^T * block) and (mat * mat^T).
+    matrix_t *product_view = matrix_multiply(&block_t, &block);
+    matrix_t *product_copy = matrix_multiply(copy_block_t, copy_block);
+    check_equal(product_view, product_copy, "multiply");
+    matrix_t *gram_view = matrix_multiply(mat, &view_t);
+    matrix_t *gram_copy = matrix_multiply(mat, copy_t);
+    check_equal(gram_view, gram_copy, "multiply");
+
+    matrix_multiply_accumulate_o(&block_t, &block, 0.5, product_view);
+    matrix_multiply_accumulate_o(copy_block_t, copy_block, 0.5, product_copy);
+    check_equal(product_view, product_copy, "multiply_accumulate_o");
+
+    // Element-wise operations between a strided block and a transposed view, written in-place into the block.
+    matrix_t *other = matrix_create(rows - 2, cols - 2);
+    fill_random(other);
+    matrix_t other_t = matrix_transpose_view(other);
+    matrix_t *other_copy = copy_entries(&other_t);
+
+    matrix_add_i(&block, &other_t);
+    matrix_add_i(copy_block, other_copy);
+    check_equal(&block, copy_block, "add_i");
+    matrix_subtract_i(&block_tt, &other_t);
+    matrix_subtract_i(copy_block, other_copy);
+    check_equal(&block, copy_block, "subtract_i");
+    matrix_multiply_scalar_i(&block, &other_t);
+    matrix_multiply_scalar_i(copy_block, other_copy);
+    check_equal(&block, copy_block, "multiply_scalar_i");
+    matrix_add_scaled_i(&block, &other_t, -0.25);
+    matrix_add_scaled_i(copy_block, other_copy, -0.25);
+    check_equal(&block, copy_block, "add_scaled_i");
+    matrix_copy_o(&other_t, &block);
+    check_equal(&block, other_copy, "copy_o");
+
+    // Entries outside the block are untouched.
+    for (int j = 0; j < rows; j++) {
+        for (int i = 0; i < cols; i++) {
+            int border = i == 0 || j == 0 || i == cols - 1 || j == rows - 1;
+            cnd_make_error(border && matrix_get(mat, i, j) != matrix_get(copy_t, j, i), "Operation on a block view wrote outside the block.");
+        }
+    }
+
+    matrix_delete(mat);
+    matrix_delete(copy_t);
+    matrix_delete(copy_block);
+    matrix_delete(copy_block_t);
+    matrix_delete(product_view);
+    matrix_delete(product_copy);
+    matrix_delete(gram_view);
+    matrix_delete(gram_copy);
+    matrix_delete(other);
+    matrix_delete(other_copy);
+}
+
+int main() {
+    random_init_seeded(4);
+
+    int shapes[][2] = { { 3, 3 }, { 5, 9 }, { 17, 4 }, { 40, 33 }, { 64, 80 } };
+    for (int i = 0; i < (int)(sizeof(shapes) / sizeof(shapes[0])); i++)
+        check_views(shapes[i][0], shapes[i][1]);
+
+    printf("All matrix view checks passed.\n");
+}
@@ -0,0 +1,48 @@
+#include "test_network.h"
+
+#include "../src/error.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+//
+// 'test_network.h' implementations
+//
+
+neural_network_t *create_network(int input_size, int output_size, int hidden_layer_count, int *hidden_layer_sizes) {
+    char **activation_functions = (char **)malloc((hidden_layer_count + 1) * sizeof(char *));
+    cnd_make_error(activation_functions == NULL, "Failed to allocate the test network's activation functions.");
+    for (int i = 0; i < hidden_layer_count; i++)
+        activation_functions[i] = i % 2 ? "relu" : "sigmoid";
+    activation_functions[hidden_layer_count] = "sigmoid";
+    neural_network_t *nn = neural_network_create(input_size, output_size, hidden_layer_count, hidden_layer_sizes, activation_functions);
+    free(activation_functions);
+    return nn;
+}
+
+void copy_network(neural_network_t *nn_I, neural_network_t *nn_O) {
+    for (int i = 0; i < nn_I->hidden_layer_count + 1; i++) {
+        matrix_copy_o(&nn_I->layers[i].weights, &nn_O->layers[i].weights);
+        matrix_copy_o(&nn_I->layers[i].biases, &nn_O->layers[i].biases);
+    }
+}
+
+int networks_equal(neural_network_t *nn_A, neural_network_t *nn_B, double tolerance, int exact) {
+    for (int i = 0; i < nn_A->hidden_layer_count + 1; i++) {
+        matrix_t *matrices[2][2] = {
+            { &nn_A->layers[i].weights, &nn_B->layers[i].weights },
+            { &nn_A->layers[i].biases, &nn_B->layers[i].biases }
+        };
+        for (int m = 0; m < 2; m++) {
+            int length = matrices[m][0]->cols * matrices[m][0]->rows;
+            if (exact && memcmp(matrices[m][0]->data, matrices[m][1]->data, length * sizeof(double)) != 0)
+                return 0;
+            for (int j = 0; j < length; j++) {
+                if (fabs(matrices[m][0]->data[j] - matrices[m][1]->data[j]) > tolerance)
+                    return 0;
+            }
+        }
+    }
+    return 1;
+}
@@ -0,0 +1,34 @@
+#ifndef TEST_NETWORK
+#define TEST_NETWORK
+
+#include "../src/neural_network.h"
+
+//
+// 'test_network.h' definitions
+//
+
+/**
+ * Create a network for the tests, its hidden layers alternating between sigmoid and relu, starting with sigmoid, and a sigmoid output layer.
+ * @param input_size The number of inputs.
+ * @param output_size The number of outputs.
+ * @param hidden_layer_count The number of hidden layers.
+ * @param hidden_layer_sizes The size of each hidden layer.
+ * @return The network, its weights not yet initialized.
+*/
+neural_network_t *create_network(int input_size, int output_size, int hidden_layer_count, int *hidden_layer_sizes);
+
+/**
+ * Copy the weights and biases of a network into another of the same shape.
+ * @param nn_I The network copied from.
+ * @param nn_O The network copied to.
+*/
+void copy_network(neural_network_t *nn_I, neural_network_t *nn_O);
+
+/**
+ * @param tolerance The largest difference allowed between a weight or bias of each network.
+ * @param exact Not zero to also require the networks to be bit-identical.
+ * @return Non-zero if every weight and bias of the networks is within the tolerance, or bit-identical when 'exact' is set.
+*/
+int networks_equal(neural_network_t *nn_A, neural_network_t *nn_B, double tolerance, int exact);
+
+#endif
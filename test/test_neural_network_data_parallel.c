@@ -0,0 +1,86 @@
+#include "../src/neural_network.h"
+#include "../src/neural_network_train.h"
+#include "../src/thread_pool.h"
+#include "../src/random.h"
+#include "../src/error.h"
+#include "test_network.h"
+
+#include <stdio.h>
+
+/**
+ * This file checks that 'neural_network_train_data_parallel' applies the batch's mean gradient, as 'neural_network_trainer_train_batch' does,
+ * for any number of workers, and that for a fixed number of workers the trained weights are bit-identical whatever the size of the pool.
+*/
+
+#define INPUT_SIZE 5
+#define OUTPUT_SIZE 3
+#define N_CASES 13
+#define MAX_WORKERS 5
+#define STEPS 50
+#define TOLERANCE 1e-12
+
+/**
+ * Train a copy of the initial network for a number of steps with the inputted number of workers on the inputted pool.
+*/
+void train_copy(neural_network_t *nn_initial, neural_network_t *nn, int n_workers, thread_pool_t *pool, matrix_t *inputs, matrix_t *labels, int steps) {
+    copy_network(nn_initial, nn);
+    neural_network_trainer_t trainers[MAX_WORKERS];
+    for (int i = 0; i < n_workers; i++)
+        neural_network_trainer_initialize(nn, &trainers[i], (N_CASES + n_workers - 1) / n_workers);
+    for (int step = 0; step < steps; step++)
+        neural_network_train_data_parallel(trainers, n_workers, inputs, labels, N_CASES, 0.5, pool);
+    for (int i = 0; i < n_workers; i++)
+        neural_network_trainer_delete(&trainers[i]);
+}
+
+int main() {
+    random_init_seeded(15);
+
+    double input_data[N_CASES * INPUT_SIZE];
+    double label_data[N_CASES * OUTPUT_SIZE];
+    matrix_t inputs[N_CASES];
+    matrix_t labels[N_CASES];
+    matrix_initialize_multiple_from_array(inputs, N_CASES, 1, INPUT_SIZE, input_data);
+    matrix_initialize_multiple_from_array(labels, N_CASES, 1, OUTPUT_SIZE, label_data);
+    for (int i = 0; i < N_CASES * INPUT_SIZE; i++)
+        input_data[i] = random_double_between(-1, 1);
+    for (int i = 0; i < N_CASES * OUTPUT_SIZE; i++)
+        label_data[i] = random_double_between(0, 1);
+
+    int hidden_layer_sizes[2] = { 7, 4 };
+    neural_network_t *nn_initial = create_network(INPUT_SIZE, OUTPUT_SIZE, 2, hidden_layer_sizes);
+    neural_network_t *nn_reference = create_network(INPUT_SIZE, OUTPUT_SIZE, 2, hidden_layer_sizes);
+    neural_network_t *nn = create_network(INPUT_SIZE, OUTPUT_SIZE, 2, hidden_layer_sizes);
+    neural_network_t *nn_other = create_network(INPUT_SIZE, OUTPUT_SIZE, 2, hidden_layer_sizes);
+    neural_network_layers_randomize(nn_initial);
+    thread_pool_t *pools[3] = { thread_pool_create(1), thread_pool_create(2), thread_pool_create(3) };
+
+    // A single step matches the trainer's mean gradient for any number of workers.
+    copy_network(nn_initial, nn_reference);
+    neural_network_trainer_t trainer;
+    neural_network_trainer_initialize(nn_reference, &trainer, N_CASES);
+    neural_network_trainer_train_batch(&trainer, inputs, labels, N_CASES, 0.5);
+    neural_network_trainer_delete(&trainer);
+    for (int n_workers = 1; n_workers <= MAX_WORKERS; n_workers++) {
+        train_copy(nn_initial, nn, n_workers, pools[2], inputs, labels, 1);
+        cnd_make_error(!networks_equal(nn, nn_reference, TOLERANCE, 0), "Data-parallel training differs from the batch's mean gradient.");
+    }
+
+    // For a fixed number of workers, training is bit-identical whatever the pool.
+    for (int n_workers = 2; n_workers <= MAX_WORKERS; n_workers++) {
+        train_copy(nn_initial, nn, n_workers, pools[0], inputs, labels, STEPS);
+        for (int i = 0; i < 3; i++) {
+            train_copy(nn_initial, nn_other, n_workers, pools[i], inputs, labels, STEPS);
+            cnd_make_error(!networks_equal(nn, nn_other, TOLERANCE, 1), "Data-parallel training is not bit-identical between runs.");
+        }
+    }
+
+    for (int i = 0; i < 3; i++)
+        thread_pool_delete(pools[i]);
+    neural_network_delete(nn_initial);
+    neural_network_delete(nn_reference);
+    neural_network_delete(nn);
+    neural_network_delete(nn_other);
+
+    printf("All data-parallel training checks passed.\n");
+}
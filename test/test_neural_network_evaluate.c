@@ -3,7 +3,9 @@
 #include "../src/neural_network.h"
 #include "../src/random.h"
 #include "../src/matrix.h"
+#include "../src/error.h"
 
+#include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -48,8 +50,41 @@ int main(int argc, char *argv) {
         matrix_initialize_from_array(outputs+i, 1, OUTPUT_SIZE, output_data, &output_data_offset);
     }
     neural_network_evaluate(nn, N_CASES, inputs, outputs);
-    neural_network_delete(nn);
     for (int i = 0; i < N_CASES; i++) {
         matrix_print(outputs+i);
     }
+
+    printf("\nStep 4: Evaluate the inputs as one batch\n");
+    // The cases are the rows of the input and output data, so their transposed views have a column per case.
+    matrix_t input_rows, output_rows;
+    input_data_offset = 0;
+    matrix_initialize_from_array(&input_rows, INPUT_SIZE, N_CASES, input_data, &input_data_offset);
+    double batch_output_data[N_CASES * OUTPUT_SIZE];
+    output_data_offset = 0;
+    matrix_initialize_from_array(&output_rows, OUTPUT_SIZE, N_CASES, batch_output_data, &output_data_offset);
+    matrix_t batch_inputs = matrix_transpose_view(&input_rows);
+    matrix_t batch_outputs = matrix_transpose_view(&output_rows);
+    double *workspace = (double *)malloc(neural_network_evaluate_batch_workspace_size(nn, N_CASES) * sizeof(double));
+    neural_network_evaluate_batch(nn, &batch_inputs, &batch_outputs, workspace);
+    matrix_print(&batch_outputs);
+    for (int i = 0; i < N_CASES * OUTPUT_SIZE; i++)
+        cnd_make_error(fabs(batch_output_data[i] - output_data[i]) > 1e-12, "Batch evaluation does not match evaluation case by case.");
+    free(workspace);
+
+    printf("\nStep 5: Evaluate the inputs with an inference context, in batches of up to 4 cases\n");
+    neural_network_inference_ctx_t inference_ctx;
+    neural_network_inference_ctx_initialize(nn, &inference_ctx, 4);
+    for (int i = 0; i < N_CASES; i += 4) {
+        int n = N_CASES - i < 4 ? N_CASES - i : 4;
+        matrix_t batch_input_rows = matrix_block_view(&input_rows, 0, i, INPUT_SIZE, n);
+        matrix_t batch_inputs_view = matrix_transpose_view(&batch_input_rows);
+        matrix_t inference_outputs = neural_network_inference_evaluate(nn, &inference_ctx, &batch_inputs_view);
+        matrix_print(&inference_outputs);
+        for (int c = 0; c < n; c++) {
+            for (int j = 0; j < OUTPUT_SIZE; j++)
+                cnd_make_error(fabs(matrix_get(&inference_outputs, c, j) - output_data[(i + c) * OUTPUT_SIZE + j]) > 1e-12, "Inference evaluation does not match evaluation case by case.");
+        }
+    }
+    neural_network_inference_ctx_delete(&inference_ctx);
+    neural_network_delete(nn);
 }
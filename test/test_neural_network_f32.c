@@ -0,0 +1,112 @@
+#include "../src/neural_network.h"
+#include "../src/neural_network_f32.h"
+#include "../src/neural_network_train.h"
+#include "../src/neural_network_train_f32.h"
+#include "../src/neural_network_file.h"
+#include "../src/neural_network_file_f32.h"
+#include "../src/random.h"
+#include "../src/error.h"
+
+#include <math.h>
+#include <stdio.h>
+
+/**
+ * This file checks the single precision library against the double precision library it is generated alongside:
+ * - Matrix multiplication of the same values gives the same result, to float precision.
+ * - Training a copy of the same network on the same cases ends with the same weights, to float precision.
+ * - Double precision model files load as single precision networks, and the reverse.
+*/
+
+#define MODEL_FILE_F64 "test_f64.model.dynamic"
+#define MODEL_FILE_F32 "test_f32.model.dynamic"
+#define N_TRAINING_CASES 2000
+#define TOLERANCE 1e-4
+
+void compare_networks(neural_network_t *nn, neural_network_f32_t *nn_f32, double tolerance, const char *message) {
+    cnd_make_error(nn->hidden_layer_count != nn_f32->hidden_layer_count, message);
+    for (int i = 0; i < nn->hidden_layer_count + 1; i++) {
+        matrix_t *weights = &nn->layers[i].weights;
+        matrix_f32_t *weights_f32 = &nn_f32->layers[i].weights;
+        cnd_make_error(weights->cols != weights_f32->cols || weights->rows != weights_f32->rows, message);
+        for (int j = 0; j < weights->cols * weights->rows; j++)
+            cnd_make_error(fabs(weights->data[j] - weights_f32->data[j]) > tolerance, message);
+        for (int j = 0; j < nn->layers[i].biases.rows; j++)
+            cnd_make_error(fabs(nn->layers[i].biases.data[j] - nn_f32->layers[i].biases.data[j]) > tolerance, message);
+    }
+}
+
+void copy_network(neural_network_t *nn, neural_network_f32_t *nn_f32) {
+    for (int i = 0; i < nn->hidden_layer_count + 1; i++) {
+        for (int j = 0; j < nn->layers[i].weights.cols * nn->layers[i].weights.rows; j++)
+            nn_f32->layers[i].weights.data[j] = (float)nn->layers[i].weights.data[j];
+        for (int j = 0; j < nn->layers[i].biases.rows; j++)
+            nn_f32->layers[i].biases.data[j] = (float)nn->layers[i].biases.data[j];
+    }
+}
+
+int main(int argc, char *argv[]) {
+    random_init_seeded(3);
+
+    printf("Step 1: Compare matrix multiplication\n");
+    matrix_t *mat_A = matrix_create(37, 23);
+    matrix_t *mat_B = matrix_create(19, 37);
+    matrix_f32_t *mat_A_f32 = matrix_f32_create(37, 23);
+    matrix_f32_t *mat_B_f32 = matrix_f32_create(19, 37);
+    for (int i = 0; i < 37 * 23; i++)
+        mat_A_f32->data[i] = (float)(mat_A->data[i] = random_double_between(-1, 1));
+    for (int i = 0; i < 19 * 37; i++)
+        mat_B_f32->data[i] = (float)(mat_B->data[i] = random_double_between(-1, 1));
+    matrix_t *mat_C = matrix_multiply(mat_A, mat_B);
+    matrix_f32_t *mat_C_f32 = matrix_f32_multiply(mat_A_f32, mat_B_f32);
+    for (int i = 0; i < 19 * 23; i++)
+        cnd_make_error(fabs(mat_C->data[i] - mat_C_f32->data[i]) > TOLERANCE, "Single and double precision products differ.");
+    matrix_delete(mat_A);
+    matrix_delete(mat_B);
+    matrix_delete(mat_C);
+    matrix_f32_delete(mat_A_f32);
+    matrix_f32_delete(mat_B_f32);
+    matrix_f32_delete(mat_C_f32);
+
+    printf("Step 2: Compare training\n");
+    int hidden_layer_sizes[2] = { 6, 4 };
+    char *activation_functions[3] = { "sigmoid", "leaky_relu", "sigmoid" };
+    neural_network_t *nn = neural_network_create(3, 2, 2, hidden_layer_sizes, activation_functions);
+    neural_network_f32_t *nn_f32 = neural_network_f32_create(3, 2, 2, hidden_layer_sizes, activation_functions);
+    neural_network_layers_randomize(nn);
+    copy_network(nn, nn_f32);
+
+    double case_data[5];
+    float case_data_f32[5];
+    matrix_t input, output;
+    matrix_f32_t input_f32, output_f32;
+    int offset = 0;
+    matrix_initialize_from_array(&input, 1, 3, case_data, &offset);
+    matrix_initialize_from_array(&output, 1, 2, case_data, &offset);
+    offset = 0;
+    matrix_f32_initialize_from_array(&input_f32, 1, 3, case_data_f32, &offset);
+    matrix_f32_initialize_from_array(&output_f32, 1, 2, case_data_f32, &offset);
+    for (int i = 0; i < N_TRAINING_CASES; i++) {
+        for (int j = 0; j < 5; j++)
+            case_data_f32[j] = (float)(case_data[j] = random_double_between(0, 1));
+        neural_network_train_case(nn, &input, &output, 0.05);
+        neural_network_f32_train_case(nn_f32, &input_f32, &output_f32, 0.05f);
+    }
+    compare_networks(nn, nn_f32, TOLERANCE, "Single and double precision training diverged.");
+
+    printf("Step 3: Convert model files\n");
+    neural_network_save_dynamic(nn, MODEL_FILE_F64);
+    neural_network_f32_t *nn_f32_loaded = neural_network_f32_load_dynamic(MODEL_FILE_F64);
+    compare_networks(nn, nn_f32_loaded, 1e-6, "Double precision model file did not convert to single precision.");
+
+    neural_network_f32_save_dynamic(nn_f32_loaded, MODEL_FILE_F32);
+    neural_network_t *nn_loaded = neural_network_load_dynamic(MODEL_FILE_F32);
+    compare_networks(nn_loaded, nn_f32_loaded, 0, "Single precision model file did not convert to double precision.");
+    remove(MODEL_FILE_F64);
+    remove(MODEL_FILE_F32);
+
+    neural_network_delete(nn);
+    neural_network_delete(nn_loaded);
+    neural_network_f32_delete(nn_f32);
+    neural_network_f32_delete(nn_f32_loaded);
+    printf("All single precision checks passed.\n");
+}
@@ -0,0 +1,116 @@
+#include "../src/neural_network.h"
+#include "../src/neural_network_train.h"
+#include "../src/thread_pool.h"
+#include "../src/random.h"
+#include "../src/error.h"
+#include "test_network.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+/**
+ * This file checks that 'neural_network_train_hogwild' trains on every batch of its source once, that a single worker trains exactly as
+ * 'neural_network_trainer_train_batch' does on the same batches, and that workers sharing the network's weights still learn the XOR gate.
+*/
+
+#define BATCH_SIZE 4
+#define XOR_REPEATS 16
+#define N_CASES (4 * XOR_REPEATS)
+#define N_WORKERS 4
+#define EPOCHS 2500
+#define TOLERANCE 1e-12
+
+/**
+ * The cases of an epoch, handed out a batch at a time in order.
+*/
+typedef struct {
+    matrix_t *inputs;
+    matrix_t *labels;
+    int n_cases;
+    atomic_int next;
+    atomic_int cases_given;
+} xor_source_t;
+
+int xor_next_batch(void *source_data, int worker, matrix_t **inputs, matrix_t **labels) {
+    (void)worker;
+    xor_source_t *source = (xor_source_t *)source_data;
+    int start = atomic_fetch_add(&source->next, BATCH_SIZE);
+    if (start >= source->n_cases)
+        return 0;
+    int n = source->n_cases - start < BATCH_SIZE ? source->n_cases - start : BATCH_SIZE;
+    atomic_fetch_add(&source->cases_given, n);
+    *inputs = source->inputs + start;
+    *labels = source->labels + start;
+    return n;
+}
+
+void xor_source_reset(xor_source_t *source) {
+    atomic_store(&source->next, 0);
+    atomic_store(&source->cases_given, 0);
+}
+
+int main() {
+    random_init_seeded(14);
+
+    double input_data[N_CASES * 2];
+    double label_data[N_CASES];
+    for (int i = 0; i < N_CASES; i++) {
+        int a = i % 2;
+        int b = (i / 2) % 2;
+        input_data[2 * i] = a;
+        input_data[2 * i + 1] = b;
+        label_data[i] = a ^ b;
+    }
+    matrix_t inputs[N_CASES];
+    matrix_t labels[N_CASES];
+    matrix_initialize_multiple_from_array(inputs, N_CASES, 1, 2, input_data);
+    matrix_initialize_multiple_from_array(labels, N_CASES, 1, 1, label_data);
+    xor_source_t source = { .inputs=inputs, .labels=labels, .n_cases=N_CASES - 1 };
+
+    thread_pool_t *pool = thread_pool_create(N_WORKERS);
+
+    // A single worker takes the batches in order, as the trainer does.
+    int hidden_layer_sizes[1] = { 4 };
+    neural_network_t *nn_hogwild = create_network(2, 1, 1, hidden_layer_sizes);
+    neural_network_t *nn_trainer = create_network(2, 1, 1, hidden_layer_sizes);
+    neural_network_layers_randomize(nn_hogwild);
+    copy_network(nn_hogwild, nn_trainer);
+    neural_network_trainer_t trainers[N_WORKERS];
+    for (int i = 0; i < N_WORKERS; i++)
+        neural_network_trainer_initialize(nn_hogwild, &trainers[i], BATCH_SIZE);
+    neural_network_trainer_t trainer;
+    neural_network_trainer_initialize(nn_trainer, &trainer, BATCH_SIZE);
+    xor_source_reset(&source);
+    neural_network_train_hogwild(trainers, 1, xor_next_batch, &source, 2, pool);
+    cnd_make_error(atomic_load(&source.cases_given) != source.n_cases, "Hogwild training did not take every case of the source once.");
+    for (int start = 0; start < source.n_cases; start += BATCH_SIZE) {
+        int n = source.n_cases - start < BATCH_SIZE ? source.n_cases - start : BATCH_SIZE;
+        neural_network_trainer_train_batch(&trainer, inputs + start, labels + start, n, 2);
+    }
+    cnd_make_error(!networks_equal(nn_hogwild, nn_trainer, TOLERANCE, 0), "A single Hogwild worker trained differently to the trainer.");
+
+    // Workers sharing the weights learn the XOR gate.
+    source.n_cases = N_CASES;
+    for (int epoch = 0; epoch < EPOCHS; epoch++) {
+        xor_source_reset(&source);
+        neural_network_train_hogwild(trainers, N_WORKERS, xor_next_batch, &source, 2, pool);
+        cnd_make_error(atomic_load(&source.cases_given) != source.n_cases, "Hogwild training did not take every case of the source once.");
+    }
+    double output_data[4];
+    matrix_t outputs[4];
+    matrix_initialize_multiple_from_array(outputs, 4, 1, 1, output_data);
+    neural_network_evaluate(nn_hogwild, 4, inputs, outputs);
+    printf("Hogwild XOR outputs: [%.3f, %.3f, %.3f, %.3f]\n", output_data[0], output_data[1], output_data[2], output_data[3]);
+    for (int i = 0; i < 4; i++)
+        cnd_make_error(fabs(output_data[i] - label_data[i]) > 0.1, "Hogwild training did not learn the XOR gate.");
+
+    for (int i = 0; i < N_WORKERS; i++)
+        neural_network_trainer_delete(&trainers[i]);
+    neural_network_trainer_delete(&trainer);
+    neural_network_delete(nn_hogwild);
+    neural_network_delete(nn_trainer);
+    thread_pool_delete(pool);
+
+    printf("All Hogwild training checks passed.\n");
+}
@@ -0,0 +1,169 @@
+#include "../src/neural_network.h"
+#include "../src/neural_network_f32.h"
+#include "../src/neural_network_mixed.h"
+#include "../src/neural_network_train.h"
+#include "../src/optimizer.h"
+#include "../src/random.h"
+#include "../src/error.h"
+#include "test_network.h"
+
+#include <math.h>
+#include <stdio.h>
+
+/**
+ * This file checks that mixed precision training keeps the float copy equal to the rounded master weights after every update,
+ * that it follows double precision training to within single precision, with and without an optimizer,
+ * and that updates too small to change a float weight still accumulate in the master weights.
+*/
+
+#define INPUT_SIZE 6
+#define OUTPUT_SIZE 3
+#define HIDDEN_LAYER_COUNT 1
+#define N_LAYERS (HIDDEN_LAYER_COUNT + 1)
+#define N_CASES 8
+#define STEPS 20
+#define LEARNING_RATE 0.5
+#define TOLERANCE 1e-4
+// Small enough that a single update moves no float weight of magnitude around 1, whose spacing is 2^-23.
+#define TINY_LEARNING_RATE 1e-9
+#define TINY_STEPS 1000
+
+int hidden_layer_sizes[HIDDEN_LAYER_COUNT] = { 9 };
+
+/**
+ * @return The largest difference between the weights and biases of the networks.
+*/
+double networks_difference(neural_network_t *nn_A, neural_network_t *nn_B) {
+    double difference = 0;
+    for (int i = 0; i < N_LAYERS; i++) {
+        matrix_t *matrices[2][2] = {
+            { &nn_A->layers[i].weights, &nn_B->layers[i].weights },
+            { &nn_A->layers[i].biases, &nn_B->layers[i].biases }
+        };
+        for (int m = 0; m < 2; m++) {
+            int length = matrices[m][0]->cols * matrices[m][0]->rows;
+            for (int j = 0; j < length; j++)
+                difference = fmax(difference, fabs(matrices[m][0]->data[j] - matrices[m][1]->data[j]));
+        }
+    }
+    return difference;
+}
+
+void check_copy_rounded(neural_network_mixed_trainer_t *trainer) {
+    for (int i = 0; i < N_LAYERS; i++) {
+        matrix_t *weights = &trainer->nn->layers[i].weights;
+        matrix_t *biases = &trainer->nn->layers[i].biases;
+        for (int j = 0; j < weights->cols * weights->rows; j++)
+            cnd_make_error(trainer->nn_f32->layers[i].weights.data[j] != (float)weights->data[j], "Float copy of a weight is not its rounded master weight.");
+        for (int j = 0; j < biases->rows; j++)
+            cnd_make_error(trainer->nn_f32->layers[i].biases.data[j] != (float)biases->data[j], "Float copy of a bias is not its rounded master bias.");
+    }
+}
+
+/**
+ * Train one network with mixed precision and a copy in double precision, with the optimizer if one is named.
+*/
+void check_follows_double(const char *optimizer_name, neural_network_t *nn_initial, matrix_t *inputs, matrix_t *labels, matrix_f32_t *inputs_f32, matrix_f32_t *labels_f32) {
+    neural_network_t *nn = create_network(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes);
+    neural_network_t *nn_reference = create_network(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes);
+    copy_network(nn_initial, nn);
+    copy_network(nn_initial, nn_reference);
+
+    neural_network_mixed_trainer_t trainer;
+    neural_network_trainer_t reference_trainer;
+    neural_network_mixed_trainer_initialize(nn, &trainer, N_CASES);
+    neural_network_trainer_initialize(nn_reference, &reference_trainer, N_CASES);
+    check_copy_rounded(&trainer);
+
+    neural_network_optimizer_t optimizer;
+    neural_network_optimizer_t reference_optimizer;
+    if (optimizer_name) {
+        neural_network_optimizer_initialize(nn, &optimizer, optimizer_config_get(optimizer_name));
+        neural_network_optimizer_initialize(nn_reference, &reference_optimizer, optimizer_config_get(optimizer_name));
+        neural_network_mixed_trainer_set_optimizer(&trainer, &optimizer);
+        neural_network_trainer_set_optimizer(&reference_trainer, &reference_optimizer);
+    }
+    double learning_rate = optimizer_name ? LEARNING_RATE * 0.01 : LEARNING_RATE;
+    for (int step = 0; step < STEPS; step++) {
+        neural_network_mixed_trainer_train_batch(&trainer, inputs_f32, labels_f32, N_CASES, learning_rate);
+        neural_network_trainer_train_batch(&reference_trainer, inputs, labels, N_CASES, learning_rate);
+        check_copy_rounded(&trainer);
+    }
+    cnd_make_error(networks_difference(nn, nn_reference) > TOLERANCE, "Mixed precision training differs from double precision training.");
+
+    if (optimizer_name) {
+        neural_network_optimizer_delete(&optimizer);
+        neural_network_optimizer_delete(&reference_optimizer);
+    }
+    neural_network_mixed_trainer_delete(&trainer);
+    neural_network_trainer_delete(&reference_trainer);
+    neural_network_delete(nn);
+    neural_network_delete(nn_reference);
+}
+
+/**
+ * Train at a learning rate too small to move float weights, checking pure single precision training stalls where the master weights move.
+*/
+void check_small_updates_accumulate(neural_network_t *nn_initial, matrix_f32_t *inputs_f32, matrix_f32_t *labels_f32) {
+    neural_network_t *nn = create_network(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes);
+    copy_network(nn_initial, nn);
+    neural_network_mixed_trainer_t trainer;
+    neural_network_mixed_trainer_initialize(nn, &trainer, N_CASES);
+
+    neural_network_trainer_f32_t trainer_f32;
+    char *activation_functions[N_LAYERS] = { "sigmoid", "sigmoid" };
+    neural_network_f32_t *nn_f32 = neural_network_f32_create(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes, activation_functions);
+    for (int i = 0; i < N_LAYERS; i++) {
+        matrix_f32_copy_o(&trainer.nn_f32->layers[i].weights, &nn_f32->layers[i].weights);
+        matrix_f32_copy_o(&trainer.nn_f32->layers[i].biases, &nn_f32->layers[i].biases);
+    }
+    neural_network_f32_trainer_initialize(nn_f32, &trainer_f32, N_CASES);
+
+    for (int step = 0; step < TINY_STEPS; step++) {
+        neural_network_mixed_trainer_train_batch(&trainer, inputs_f32, labels_f32, N_CASES, TINY_LEARNING_RATE);
+        neural_network_f32_trainer_train_batch(&trainer_f32, inputs_f32, labels_f32, N_CASES, (float)TINY_LEARNING_RATE);
+    }
+    float moved_f32 = 0;
+    for (int j = 0; j < nn_f32->layers[1].biases.rows; j++)
+        moved_f32 = fmaxf(moved_f32, fabsf(nn_f32->layers[1].biases.data[j] - (float)nn_initial->layers[1].biases.data[j]));
+    cnd_make_error(moved_f32 != 0, "Single precision weights moved by updates below their precision.");
+    cnd_make_error(networks_difference(nn, nn_initial) == 0, "Master weights lost updates below single precision.");
+
+    neural_network_f32_trainer_delete(&trainer_f32);
+    neural_network_f32_delete(nn_f32);
+    neural_network_mixed_trainer_delete(&trainer);
+    neural_network_delete(nn);
+}
+
+int main() {
+    random_init_seeded(31);
+
+    double input_data[N_CASES * INPUT_SIZE];
+    double label_data[N_CASES * OUTPUT_SIZE];
+    float input_data_f32[N_CASES * INPUT_SIZE];
+    float label_data_f32[N_CASES * OUTPUT_SIZE];
+    matrix_t inputs[N_CASES];
+    matrix_t labels[N_CASES];
+    matrix_f32_t inputs_f32[N_CASES];
+    matrix_f32_t labels_f32[N_CASES];
+    matrix_initialize_multiple_from_array(inputs, N_CASES, 1, INPUT_SIZE, input_data);
+    matrix_initialize_multiple_from_array(labels, N_CASES, 1, OUTPUT_SIZE, label_data);
+    matrix_f32_initialize_multiple_from_array(inputs_f32, N_CASES, 1, INPUT_SIZE, input_data_f32);
+    matrix_f32_initialize_multiple_from_array(labels_f32, N_CASES, 1, OUTPUT_SIZE, label_data_f32);
+    // Values exact in single precision, so both precisions train on the same cases.
+    for (int i = 0; i < N_CASES * INPUT_SIZE; i++)
+        input_data_f32[i] = (float)(input_data[i] = (float)random_double_between(-1, 1));
+    for (int i = 0; i < N_CASES * OUTPUT_SIZE; i++)
+        label_data_f32[i] = (float)(label_data[i] = (float)random_double_between(0, 1));
+
+    neural_network_t *nn_initial = create_network(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes);
+    neural_network_layers_randomize(nn_initial);
+
+    check_follows_double(NULL, nn_initial, inputs, labels, inputs_f32, labels_f32);
+    check_follows_double("adam", nn_initial, inputs, labels, inputs_f32, labels_f32);
+    check_small_updates_accumulate(nn_initial, inputs_f32, labels_f32);
+
+    neural_network_delete(nn_initial);
+
+    printf("All mixed precision checks passed.\n");
+}
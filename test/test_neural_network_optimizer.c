@@ -0,0 +1,133 @@
+#include "../src/neural_network.h"
+#include "../src/neural_network_train.h"
+#include "../src/optimizer.h"
+#include "../src/random.h"
+#include "../src/error.h"
+#include "test_network.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * This file checks that every optimizer's fused update matches its update rule computed directly from the trainer's gradients,
+ * Adam's bias corrections included, over several steps, and that resetting an optimizer restarts it.
+*/
+
+#define INPUT_SIZE 5
+#define OUTPUT_SIZE 3
+#define HIDDEN_LAYER_COUNT 2
+#define N_LAYERS (HIDDEN_LAYER_COUNT + 1)
+#define N_CASES 8
+#define STEPS 10
+#define LEARNING_RATE 0.05
+#define TOLERANCE 1e-12
+
+/**
+ * Apply the update rule to a single parameter, with its state 's1' and 's2', as written in the literature.
+*/
+void reference_update(optimizer_config_t *config, double *w, double *s1, double *s2, double g, double lr, long long step) {
+    switch (config->kind) {
+        case OPTIMIZER_SGD:
+            *w -= lr * g;
+            break;
+        case OPTIMIZER_MOMENTUM:
+            *s1 = config->momentum * *s1 + g;
+            *w -= lr * *s1;
+            break;
+        case OPTIMIZER_NESTEROV:
+            *s1 = config->momentum * *s1 + g;
+            *w -= lr * (g + config->momentum * *s1);
+            break;
+        case OPTIMIZER_RMSPROP:
+            *s1 = config->decay * *s1 + (1 - config->decay) * g * g;
+            *w -= lr * g / (sqrt(*s1) + config->epsilon);
+            break;
+        case OPTIMIZER_ADAM: {
+            *s1 = config->beta1 * *s1 + (1 - config->beta1) * g;
+            *s2 = config->beta2 * *s2 + (1 - config->beta2) * g * g;
+            double m_hat = *s1 / (1 - pow(config->beta1, step));
+            double v_hat = *s2 / (1 - pow(config->beta2, step));
+            *w -= lr * m_hat / (sqrt(v_hat) + config->epsilon);
+            break;
+        }
+    }
+}
+
+/**
+ * Train one network through a trainer with the optimizer, and a copy by applying the update rule to the gradients of a trainer without one.
+*/
+void check_optimizer(const char *name, neural_network_t *nn_initial, neural_network_t *nn, neural_network_t *nn_reference, matrix_t *inputs, matrix_t *labels) {
+    optimizer_config_t config = optimizer_config_get(name);
+    copy_network(nn_initial, nn);
+    copy_network(nn_initial, nn_reference);
+
+    neural_network_trainer_t trainer;
+    neural_network_trainer_t reference_trainer;
+    neural_network_optimizer_t optimizer;
+    neural_network_trainer_initialize(nn, &trainer, N_CASES);
+    neural_network_trainer_initialize(nn_reference, &reference_trainer, N_CASES);
+    neural_network_optimizer_initialize(nn, &optimizer, config);
+    neural_network_trainer_set_optimizer(&trainer, &optimizer);
+
+    size_t parameter_count = reference_trainer.parameter_count;
+    double *state = (double *)calloc(2 * parameter_count, sizeof(double));
+    for (int repeat = 0; repeat < 2; repeat++) {
+        for (long long step = 1; step <= STEPS; step++) {
+            neural_network_trainer_train_batch(&trainer, inputs, labels, N_CASES, LEARNING_RATE);
+
+            neural_network_trainer_gradients(&reference_trainer, inputs, labels, N_CASES);
+            size_t offset = 0;
+            for (int k = 0; k < N_LAYERS; k++) {
+                matrix_t *parameters[2] = { &nn_reference->layers[k].weights, &nn_reference->layers[k].biases };
+                matrix_t *gradients[2] = { &reference_trainer.gradients[k].weights, &reference_trainer.gradients[k].biases };
+                for (int m = 0; m < 2; m++) {
+                    int length = parameters[m]->cols * parameters[m]->rows;
+                    for (int j = 0; j < length; j++, offset++)
+                        reference_update(&config, &parameters[m]->data[j], &state[offset], &state[parameter_count + offset], gradients[m]->data[j], LEARNING_RATE, step);
+                }
+            }
+            cnd_make_error(!networks_equal(nn, nn_reference, TOLERANCE, 0), "Fused optimizer update differs from its update rule.");
+        }
+        // Restart both from their current weights with fresh state.
+        neural_network_optimizer_reset(&optimizer);
+        for (size_t i = 0; i < 2 * parameter_count; i++)
+            state[i] = 0;
+    }
+
+    free(state);
+    neural_network_optimizer_delete(&optimizer);
+    neural_network_trainer_delete(&trainer);
+    neural_network_trainer_delete(&reference_trainer);
+}
+
+int main() {
+    random_init_seeded(23);
+
+    double input_data[N_CASES * INPUT_SIZE];
+    double label_data[N_CASES * OUTPUT_SIZE];
+    matrix_t inputs[N_CASES];
+    matrix_t labels[N_CASES];
+    matrix_initialize_multiple_from_array(inputs, N_CASES, 1, INPUT_SIZE, input_data);
+    matrix_initialize_multiple_from_array(labels, N_CASES, 1, OUTPUT_SIZE, label_data);
+    for (int i = 0; i < N_CASES * INPUT_SIZE; i++)
+        input_data[i] = random_double_between(-1, 1);
+    for (int i = 0; i < N_CASES * OUTPUT_SIZE; i++)
+        label_data[i] = random_double_between(0, 1);
+
+    int hidden_layer_sizes[HIDDEN_LAYER_COUNT] = { 9, 6 };
+    neural_network_t *nn_initial = create_network(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes);
+    neural_network_t *nn = create_network(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes);
+    neural_network_t *nn_reference = create_network(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes);
+    neural_network_layers_randomize(nn_initial);
+
+    const char *names[5] = { "sgd", "momentum", "nesterov", "rmsprop", "adam" };
+    for (int i = 0; i < 5; i++)
+        check_optimizer(names[i], nn_initial, nn, nn_reference, inputs, labels);
+
+    neural_network_delete(nn_initial);
+    neural_network_delete(nn);
+    neural_network_delete(nn_reference);
+
+    printf("All optimizer checks passed.\n");
+}
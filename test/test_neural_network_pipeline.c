@@ -0,0 +1,93 @@
+#include "../src/neural_network.h"
+#include "../src/neural_network_train.h"
+#include "../src/pipeline.h"
+#include "../src/random.h"
+#include "../src/error.h"
+#include "test_network.h"
+
+#include <stdio.h>
+
+/**
+ * This file checks that 'neural_network_train_pipeline' applies the batch's mean gradient, as 'neural_network_trainer_train_batch' does,
+ * for every number of stages, micro-batch size and schedule, that both schedules give bit-identical weights,
+ * and that the pipeline's bubble fraction is a proportion.
+*/
+
+#define INPUT_SIZE 5
+#define OUTPUT_SIZE 3
+#define HIDDEN_LAYER_COUNT 4
+#define N_LAYERS (HIDDEN_LAYER_COUNT + 1)
+#define N_CASES 13
+#define STEPS 20
+#define TOLERANCE 1e-12
+
+/**
+ * Train a copy of the initial network for a number of steps through a pipeline, checking its stages cover every layer.
+*/
+void train_copy(neural_network_t *nn_initial, neural_network_t *nn, int n_stages, int micro_batch_size, pipeline_schedule_t schedule, matrix_t *inputs, matrix_t *labels, int steps) {
+    copy_network(nn_initial, nn);
+    neural_network_pipeline_t pipeline;
+    neural_network_pipeline_initialize(nn, &pipeline, n_stages, micro_batch_size, (N_CASES + micro_batch_size - 1) / micro_batch_size, schedule);
+    cnd_make_error(pipeline.stage_layers[0] != 0 || pipeline.stage_layers[n_stages] != N_LAYERS, "Pipeline stages do not cover every layer.");
+    for (int s = 0; s < n_stages; s++)
+        cnd_make_error(pipeline.stage_layers[s + 1] <= pipeline.stage_layers[s], "A pipeline stage has no layers.");
+    for (int step = 0; step < steps; step++)
+        neural_network_train_pipeline(&pipeline, inputs, labels, N_CASES, 0.5);
+    double bubble = pipeline_bubble_fraction(pipeline.pipeline);
+    cnd_make_error(bubble < 0 || bubble > 1, "Pipeline bubble fraction is not a proportion.");
+    neural_network_pipeline_delete(&pipeline);
+}
+
+int main() {
+    random_init_seeded(17);
+
+    double input_data[N_CASES * INPUT_SIZE];
+    double label_data[N_CASES * OUTPUT_SIZE];
+    matrix_t inputs[N_CASES];
+    matrix_t labels[N_CASES];
+    matrix_initialize_multiple_from_array(inputs, N_CASES, 1, INPUT_SIZE, input_data);
+    matrix_initialize_multiple_from_array(labels, N_CASES, 1, OUTPUT_SIZE, label_data);
+    for (int i = 0; i < N_CASES * INPUT_SIZE; i++)
+        input_data[i] = random_double_between(-1, 1);
+    for (int i = 0; i < N_CASES * OUTPUT_SIZE; i++)
+        label_data[i] = random_double_between(0, 1);
+
+    int hidden_layer_sizes[HIDDEN_LAYER_COUNT] = { 9, 7, 6, 4 };
+    neural_network_t *nn_initial = create_network(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes);
+    neural_network_t *nn_reference = create_network(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes);
+    neural_network_t *nn = create_network(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes);
+    neural_network_t *nn_other = create_network(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes);
+    neural_network_layers_randomize(nn_initial);
+
+    // A single step matches the trainer's mean gradient for every number of stages and micro-batch size.
+    copy_network(nn_initial, nn_reference);
+    neural_network_trainer_t trainer;
+    neural_network_trainer_initialize(nn_reference, &trainer, N_CASES);
+    neural_network_trainer_train_batch(&trainer, inputs, labels, N_CASES, 0.5);
+    neural_network_trainer_delete(&trainer);
+    int micro_batch_sizes[4] = { 1, 3, 5, N_CASES };
+    for (int n_stages = 1; n_stages <= N_LAYERS; n_stages++) {
+        for (int i = 0; i < 4; i++) {
+            train_copy(nn_initial, nn, n_stages, micro_batch_sizes[i], PIPELINE_SCHEDULE_GPIPE, inputs, labels, 1);
+            cnd_make_error(!networks_equal(nn, nn_reference, TOLERANCE, 0), "GPipe training differs from the batch's mean gradient.");
+            train_copy(nn_initial, nn, n_stages, micro_batch_sizes[i], PIPELINE_SCHEDULE_1F1B, inputs, labels, 1);
+            cnd_make_error(!networks_equal(nn, nn_reference, TOLERANCE, 0), "1F1B training differs from the batch's mean gradient.");
+        }
+    }
+
+    // Both schedules, and every number of stages, sum the micro-batches' gradients in the same order.
+    for (int i = 0; i < 4; i++) {
+        train_copy(nn_initial, nn, 1, micro_batch_sizes[i], PIPELINE_SCHEDULE_GPIPE, inputs, labels, STEPS);
+        for (int n_stages = 1; n_stages <= N_LAYERS; n_stages++) {
+            train_copy(nn_initial, nn_other, n_stages, micro_batch_sizes[i], PIPELINE_SCHEDULE_1F1B, inputs, labels, STEPS);
+            cnd_make_error(!networks_equal(nn, nn_other, TOLERANCE, 1), "Pipeline training is not bit-identical between schedules and stage counts.");
+        }
+    }
+
+    neural_network_delete(nn_initial);
+    neural_network_delete(nn_reference);
+    neural_network_delete(nn);
+    neural_network_delete(nn_other);
+
+    printf("All pipeline training checks passed.\n");
+}
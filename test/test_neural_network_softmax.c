@@ -0,0 +1,194 @@
+#include "../src/neural_network.h"
+#include "../src/neural_network_train.h"
+#include "../src/loss.h"
+#include "../src/random.h"
+#include "../src/error.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * This file checks that softmax outputs are normalized without overflowing on large inputs, that training on class indices
+ * matches training on the equivalent one-hot labels, and that the gradient of a softmax network matches finite differences
+ * of the mean cross-entropy, as does the gradient of a sigmoid network trained with the cross-entropy.
+ * It also checks that the softmax is rejected on any layer but the output layer, whose derivative is the only one training may skip.
+*/
+
+#define INPUT_SIZE 5
+#define OUTPUT_SIZE 4
+#define HIDDEN_LAYER_COUNT 1
+#define N_LAYERS (HIDDEN_LAYER_COUNT + 1)
+#define N_CASES 6
+#define TOLERANCE 1e-12
+#define DIFFERENCE_STEP 1e-6
+#define DIFFERENCE_TOLERANCE 1e-6
+
+neural_network_t *create_network(char *output_activation_function) {
+    int hidden_layer_sizes[HIDDEN_LAYER_COUNT] = { 7 };
+    char *activation_functions[N_LAYERS] = { "sigmoid", output_activation_function };
+    return neural_network_create(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes, activation_functions);
+}
+
+void check_softmax_columns() {
+    // Logits large enough to overflow 'exp' unless the column's maximum is subtracted first.
+    double data[2 * 3] = { 1000, 1001, 1002, -3, 0, 2 };
+    softmax_columns(data, 2, 3, 1, 3);
+    for (int j = 0; j < 2; j++) {
+        double sum = 0;
+        for (int r = 0; r < 3; r++) {
+            cnd_make_error(!isfinite(data[j * 3 + r]), "Softmax output is not finite.");
+            sum += data[j * 3 + r];
+        }
+        cnd_make_error(fabs(sum - 1) > TOLERANCE, "Softmax column does not sum to 1.");
+    }
+    double expected = exp(-2) / (exp(-2) + exp(-1) + 1);
+    cnd_make_error(fabs(data[0] - expected) > TOLERANCE, "Softmax output differs from its definition.");
+
+    // The same columns stored a row at a time, so each column's logits are strided.
+    double rows[3 * 2] = { 1000, -3, 1001, 0, 1002, 2 };
+    softmax_columns(rows, 2, 3, 2, 1);
+    for (int j = 0; j < 2; j++) {
+        for (int r = 0; r < 3; r++)
+            cnd_make_error(fabs(rows[r * 2 + j] - data[j * 3 + r]) > TOLERANCE, "Strided softmax differs from contiguous softmax.");
+    }
+}
+
+/**
+ * Create a network with a softmax hidden layer, and load the layers of a valid network with one, each in a child process.
+ * Both must fail, as training cannot propagate errors through the softmax.
+*/
+void check_hidden_softmax_rejected() {
+    int hidden_layer_sizes[HIDDEN_LAYER_COUNT] = { 7 };
+    char *hidden_softmax[N_LAYERS] = { "softmax", "sigmoid" };
+    for (int load = 0; load < 2; load++) {
+        pid_t child = fork();
+        cnd_make_error(child < 0, "Failed to fork the softmax check.");
+        if (child == 0) {
+            // The child's error message is expected.
+            freopen("/dev/null", "w", stdout);
+            if (load) {
+                neural_network_t *nn = create_network("softmax");
+                double *data = (double *)calloc((INPUT_SIZE + 1) * 7 + (7 + 1) * OUTPUT_SIZE, sizeof(double));
+                neural_network_layers_from_array(nn, data, hidden_softmax);
+            }
+            else {
+                neural_network_create(INPUT_SIZE, OUTPUT_SIZE, HIDDEN_LAYER_COUNT, hidden_layer_sizes, hidden_softmax);
+            }
+            exit(EXIT_SUCCESS);
+        }
+        int status;
+        waitpid(child, &status, 0);
+        cnd_make_error(!WIFEXITED(status) || WEXITSTATUS(status) == EXIT_SUCCESS, load ? "Loaded layers with a softmax hidden layer." : "Created a network with a softmax hidden layer.");
+    }
+}
+
+/**
+ * @return The cross-entropy of the network's outputs and the classes, averaged over the cases.
+*/
+double mean_cross_entropy(neural_network_t *nn, matrix_t *inputs, int *classes, int softmax) {
+    double output_data[OUTPUT_SIZE];
+    matrix_t output;
+    matrix_initialize_from_array(&output, 1, OUTPUT_SIZE, output_data, &(int){ 0 });
+    double loss = 0;
+    for (int j = 0; j < N_CASES; j++) {
+        neural_network_evaluate(nn, 1, &inputs[j], &output);
+        for (int r = 0; r < OUTPUT_SIZE; r++) {
+            if (r == classes[j])
+                loss -= log(output_data[r]);
+            else if (!softmax)
+                loss -= log(1 - output_data[r]);
+        }
+    }
+    return loss / N_CASES;
+}
+
+/**
+ * Compare the trainer's gradient of every weight and bias against central differences of the mean cross-entropy.
+*/
+void check_finite_differences(neural_network_t *nn, neural_network_trainer_t *trainer, matrix_t *inputs, int *classes, int softmax) {
+    neural_network_trainer_gradients_classes(trainer, inputs, classes, N_CASES);
+    for (int k = 0; k < N_LAYERS; k++) {
+        matrix_t *parameters[2] = { &nn->layers[k].weights, &nn->layers[k].biases };
+        matrix_t *gradients[2] = { &trainer->gradients[k].weights, &trainer->gradients[k].biases };
+        for (int m = 0; m < 2; m++) {
+            int length = parameters[m]->cols * parameters[m]->rows;
+            for (int i = 0; i < length; i++) {
+                double value = parameters[m]->data[i];
+                parameters[m]->data[i] = value + DIFFERENCE_STEP;
+                double loss_up = mean_cross_entropy(nn, inputs, classes, softmax);
+                parameters[m]->data[i] = value - DIFFERENCE_STEP;
+                double loss_down = mean_cross_entropy(nn, inputs, classes, softmax);
+                parameters[m]->data[i] = value;
+                double difference = (loss_up - loss_down) / (2 * DIFFERENCE_STEP);
+                cnd_make_error(fabs(difference - gradients[m]->data[i]) > DIFFERENCE_TOLERANCE, "Cross-entropy gradient differs from finite differences.");
+            }
+        }
+    }
+}
+
+/**
+ * Compare the gradients of the class index path against the one-hot label path, with the inputted loss.
+*/
+void check_classes_match_labels(neural_network_t *nn, matrix_t *inputs, matrix_t *labels, int *classes, loss_t loss) {
+    neural_network_trainer_t trainer;
+    neural_network_trainer_t label_trainer;
+    neural_network_trainer_initialize(nn, &trainer, N_CASES);
+    neural_network_trainer_initialize(nn, &label_trainer, N_CASES);
+    neural_network_trainer_set_loss(&trainer, loss);
+    neural_network_trainer_set_loss(&label_trainer, loss);
+
+    neural_network_trainer_gradients_classes(&trainer, inputs, classes, N_CASES);
+    neural_network_trainer_gradients(&label_trainer, inputs, labels, N_CASES);
+    for (size_t i = 0; i < trainer.parameter_count; i++)
+        cnd_make_error(fabs(trainer.gradient_data[i] - label_trainer.gradient_data[i]) > TOLERANCE, "Class index gradient differs from one-hot label gradient.");
+
+    neural_network_trainer_delete(&trainer);
+    neural_network_trainer_delete(&label_trainer);
+}
+
+int main() {
+    random_init_seeded(29);
+    check_softmax_columns();
+    check_hidden_softmax_rejected();
+
+    double input_data[N_CASES * INPUT_SIZE];
+    double label_data[N_CASES * OUTPUT_SIZE] = { 0 };
+    int classes[N_CASES];
+    matrix_t inputs[N_CASES];
+    matrix_t labels[N_CASES];
+    matrix_initialize_multiple_from_array(inputs, N_CASES, 1, INPUT_SIZE, input_data);
+    matrix_initialize_multiple_from_array(labels, N_CASES, 1, OUTPUT_SIZE, label_data);
+    for (int i = 0; i < N_CASES * INPUT_SIZE; i++)
+        input_data[i] = random_double_between(-1, 1);
+    for (int j = 0; j < N_CASES; j++) {
+        classes[j] = j % OUTPUT_SIZE;
+        label_data[j * OUTPUT_SIZE + classes[j]] = 1;
+    }
+
+    neural_network_t *softmax_nn = create_network("softmax");
+    neural_network_t *sigmoid_nn = create_network("sigmoid");
+    neural_network_layers_randomize(softmax_nn);
+    neural_network_layers_randomize(sigmoid_nn);
+
+    check_classes_match_labels(softmax_nn, inputs, labels, classes, LOSS_CROSS_ENTROPY);
+    check_classes_match_labels(sigmoid_nn, inputs, labels, classes, LOSS_SQUARED_ERROR);
+    check_classes_match_labels(sigmoid_nn, inputs, labels, classes, LOSS_CROSS_ENTROPY);
+
+    neural_network_trainer_t trainer;
+    neural_network_trainer_initialize(softmax_nn, &trainer, N_CASES);
+    check_finite_differences(softmax_nn, &trainer, inputs, classes, 1);
+    neural_network_trainer_delete(&trainer);
+
+    neural_network_trainer_initialize(sigmoid_nn, &trainer, N_CASES);
+    neural_network_trainer_set_loss(&trainer, loss_get("cross_entropy"));
+    check_finite_differences(sigmoid_nn, &trainer, inputs, classes, 0);
+    neural_network_trainer_delete(&trainer);
+
+    neural_network_delete(softmax_nn);
+    neural_network_delete(sigmoid_nn);
+
+    printf("All softmax and cross-entropy checks passed.\n");
+}
@@ -0,0 +1,105 @@
+#include "../src/neural_network.h"
+#include "../src/neural_network_train.h"
+#include "../src/random.h"
+#include "../src/error.h"
+#include "test_network.h"
+
+#include <math.h>
+#include <stdio.h>
+
+/**
+ * This file checks that 'neural_network_train_batch' applies the mean of the gradients 'neural_network_train_case' would compute for each case
+ * against the same weights, for full and partial batches, and that it trains the XOR gate as 'test_neural_network_train' does.
+*/
+
+#define INPUT_SIZE 5
+#define OUTPUT_SIZE 3
+#define BATCH_SIZE 8
+#define TOLERANCE 1e-12
+
+#define XOR_EPOCHS 20000
+
+/**
+ * Train on the first n cases with 'neural_network_train_batch', and with the case by case evaluation against a frozen copy of the weights.
+*/
+void check_batch(int n) {
+    int hidden_layer_sizes[2] = { 7, 4 };
+    neural_network_t *nn_batch = create_network(INPUT_SIZE, OUTPUT_SIZE, 2, hidden_layer_sizes);
+    neural_network_t *nn_cases = create_network(INPUT_SIZE, OUTPUT_SIZE, 2, hidden_layer_sizes);
+    neural_network_t *nn_frozen = create_network(INPUT_SIZE, OUTPUT_SIZE, 2, hidden_layer_sizes);
+    neural_network_layers_randomize(nn_batch);
+    copy_network(nn_batch, nn_cases);
+    copy_network(nn_batch, nn_frozen);
+
+    double input_data[BATCH_SIZE * INPUT_SIZE];
+    double label_data[BATCH_SIZE * OUTPUT_SIZE];
+    matrix_t inputs[BATCH_SIZE];
+    matrix_t labels[BATCH_SIZE];
+    matrix_initialize_multiple_from_array(inputs, BATCH_SIZE, 1, INPUT_SIZE, input_data);
+    matrix_initialize_multiple_from_array(labels, BATCH_SIZE, 1, OUTPUT_SIZE, label_data);
+    for (int i = 0; i < BATCH_SIZE * INPUT_SIZE; i++)
+        input_data[i] = random_double_between(-1, 1);
+    for (int i = 0; i < BATCH_SIZE * OUTPUT_SIZE; i++)
+        label_data[i] = random_double_between(0, 1);
+    // Labels may also be given as rows.
+    matrix_t label_row = matrix_transpose_view(&labels[0]);
+    labels[0] = label_row;
+
+    double p = 0.5;
+    neural_network_train_ctx_t ctx;
+    neural_network_train_ctx_initialize(nn_batch, &ctx, BATCH_SIZE);
+    neural_network_train_batch(nn_batch, inputs, labels, n, p, &ctx);
+    neural_network_train_ctx_delete(&ctx);
+
+    neural_network_evaluation_t eval;
+    neural_network_evaluation_initialize(nn_frozen, &eval);
+    for (int j = 0; j < n; j++) {
+        neural_network_evaluation_outputs(nn_frozen, &inputs[j], eval);
+        neural_network_evaluation_errors(nn_frozen, &labels[j], eval);
+        neural_network_evaluation_apply(nn_cases, &inputs[j], eval, p / n);
+    }
+    neural_network_evaluation_delete(eval);
+
+    cnd_make_error(!networks_equal(nn_batch, nn_cases, TOLERANCE, 0), "Batch trained weights and biases differ from the mean of the case gradients.");
+    neural_network_delete(nn_batch);
+    neural_network_delete(nn_cases);
+    neural_network_delete(nn_frozen);
+}
+
+void check_xor() {
+    int hidden_layer_sizes[1] = { 4 };
+    neural_network_t *nn = create_network(2, 1, 1, hidden_layer_sizes);
+    neural_network_layers_randomize(nn);
+
+    double input_data[8] = { 0, 0, 1, 0, 0, 1, 1, 1 };
+    double label_data[4] = { 0, 1, 1, 0 };
+    matrix_t inputs[4];
+    matrix_t labels[4];
+    matrix_initialize_multiple_from_array(inputs, 4, 1, 2, input_data);
+    matrix_initialize_multiple_from_array(labels, 4, 1, 1, label_data);
+
+    neural_network_train_ctx_t ctx;
+    neural_network_train_ctx_initialize(nn, &ctx, 4);
+    for (int i = 0; i < XOR_EPOCHS; i++)
+        neural_network_train_batch(nn, inputs, labels, 4, 2, &ctx);
+    neural_network_train_ctx_delete(&ctx);
+
+    double output_data[4];
+    matrix_t outputs[4];
+    matrix_initialize_multiple_from_array(outputs, 4, 1, 1, output_data);
+    neural_network_evaluate(nn, 4, inputs, outputs);
+    printf("XOR outputs: [%.3f, %.3f, %.3f, %.3f]\n", output_data[0], output_data[1], output_data[2], output_data[3]);
+    for (int i = 0; i < 4; i++)
+        cnd_make_error(fabs(output_data[i] - label_data[i]) > 0.1, "Batch training did not learn the XOR gate.");
+    neural_network_delete(nn);
+}
+
+int main() {
+    random_init_seeded(12);
+
+    for (int n = 1; n <= BATCH_SIZE; n++)
+        check_batch(n);
+    check_xor();
+
+    printf("All batch training checks passed.\n");
+}
@@ -0,0 +1,118 @@
+#include "../src/neural_network.h"
+#include "../src/neural_network_train.h"
+#include "../src/random.h"
+#include "../src/error.h"
+#include "test_network.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * This file checks that a 'neural_network_trainer_t' trains as 'neural_network_train_case' and 'neural_network_train_batch' do,
+ * and counts the heap allocations made while training to check that none are made once the trainer has warmed up.
+ * Allocations are counted by wrapping malloc, calloc and realloc at link time where the linker supports it, see 'CMakeLists.txt'.
+*/
+
+#define INPUT_SIZE 5
+#define OUTPUT_SIZE 3
+#define BATCH_SIZE 8
+#define TOLERANCE 1e-12
+
+#define STEADY_STATE_STEPS 100
+
+static size_t allocation_count;
+
+#ifdef COUNT_ALLOCATIONS
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    allocation_count++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    allocation_count++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    allocation_count++;
+    return __real_realloc(ptr, size);
+}
+#endif
+
+int main() {
+    random_init_seeded(13);
+
+    int hidden_layer_sizes[2] = { 7, 4 };
+    neural_network_t *nn_trainer = create_network(INPUT_SIZE, OUTPUT_SIZE, 2, hidden_layer_sizes);
+    neural_network_t *nn_reference = create_network(INPUT_SIZE, OUTPUT_SIZE, 2, hidden_layer_sizes);
+    neural_network_layers_randomize(nn_trainer);
+    copy_network(nn_trainer, nn_reference);
+
+    double input_data[BATCH_SIZE * INPUT_SIZE];
+    double label_data[BATCH_SIZE * OUTPUT_SIZE];
+    matrix_t inputs[BATCH_SIZE];
+    matrix_t labels[BATCH_SIZE];
+    matrix_initialize_multiple_from_array(inputs, BATCH_SIZE, 1, INPUT_SIZE, input_data);
+    matrix_initialize_multiple_from_array(labels, BATCH_SIZE, 1, OUTPUT_SIZE, label_data);
+    for (int i = 0; i < BATCH_SIZE * INPUT_SIZE; i++)
+        input_data[i] = random_double_between(-1, 1);
+    for (int i = 0; i < BATCH_SIZE * OUTPUT_SIZE; i++)
+        label_data[i] = random_double_between(0, 1);
+
+    allocation_count = 0;
+    neural_network_trainer_t trainer;
+    neural_network_trainer_initialize(nn_trainer, &trainer, BATCH_SIZE);
+    size_t initialize_allocations = allocation_count;
+    neural_network_train_ctx_t ctx;
+    neural_network_train_ctx_initialize(nn_reference, &ctx, BATCH_SIZE);
+
+    size_t parameter_count = 0;
+    for (int i = 0; i < nn_trainer->hidden_layer_count + 1; i++)
+        parameter_count += (nn_trainer->layers[i].weights.cols + 1) * nn_trainer->layers[i].weights.rows;
+    cnd_make_error(trainer.parameter_count != parameter_count, "Trainer gradients do not cover every weight and bias.");
+
+    // Warm up, growing the scratch arena and the matrix multiplication packing buffers to fit.
+    for (int i = 0; i < BATCH_SIZE; i++) {
+        neural_network_trainer_train_case(&trainer, &inputs[i], &labels[i], 0.1);
+        neural_network_train_case(nn_reference, &inputs[i], &labels[i], 0.1);
+    }
+    cnd_make_error(!networks_equal(nn_trainer, nn_reference, TOLERANCE, 0), "Trainer case training differs from 'neural_network_train_case'.");
+    for (int n = 1; n <= BATCH_SIZE; n++) {
+        neural_network_trainer_train_batch(&trainer, inputs, labels, n, 0.5);
+        neural_network_train_batch(nn_reference, inputs, labels, n, 0.5, &ctx);
+    }
+    cnd_make_error(!networks_equal(nn_trainer, nn_reference, TOLERANCE, 0), "Trainer batch training differs from 'neural_network_train_batch'.");
+
+    // Steady state, training through the trainer allocates nothing.
+    allocation_count = 0;
+    for (int step = 0; step < STEADY_STATE_STEPS; step++) {
+        neural_network_trainer_train_case(&trainer, &inputs[step % BATCH_SIZE], &labels[step % BATCH_SIZE], 0.1);
+        neural_network_trainer_train_batch(&trainer, inputs, labels, 1 + step % BATCH_SIZE, 0.5);
+    }
+    size_t trainer_allocations = allocation_count;
+    for (int step = 0; step < STEADY_STATE_STEPS; step++)
+        neural_network_train_case(nn_reference, &inputs[step % BATCH_SIZE], &labels[step % BATCH_SIZE], 0.1);
+    size_t train_case_allocations = allocation_count - trainer_allocations;
+
+#ifdef COUNT_ALLOCATIONS
+    printf("Allocations in %d steady state steps: trainer %zu, 'neural_network_train_case' %zu\n", STEADY_STATE_STEPS, trainer_allocations, train_case_allocations);
+    cnd_make_error(initialize_allocations == 0, "Allocations are not being counted.");
+    cnd_make_error(trainer_allocations != 0, "The trainer allocated after warming up.");
+    cnd_make_error(train_case_allocations != 0, "'neural_network_train_case' allocated after warming up.");
+#else
+    (void)initialize_allocations;
+    (void)train_case_allocations;
+    printf("Allocation counting is not supported by this linker, only the trainer's results were checked.\n");
+#endif
+
+    neural_network_trainer_delete(&trainer);
+    neural_network_train_ctx_delete(&ctx);
+    neural_network_delete(nn_trainer);
+    neural_network_delete(nn_reference);
+
+    printf("All trainer checks passed.\n");
+}
@@ -0,0 +1,169 @@
+#include "../src/neural_network.h"
+#include "../src/neural_network_train.h"
+#include "../src/process_ring.h"
+#include "../src/random.h"
+#include "../src/error.h"
+#include "test_network.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * This file forks rings of processes on this machine and checks that every process receives the exact sum of an all-reduce,
+ * for arrays shorter and longer than the ring, that a broadcast copies the first process's array, and that distributed training
+ * over shards of a batch applies the batch's mean gradient while keeping every process's network bit-identical,
+ * for shards of equal size and for shards of different sizes, some empty.
+*/
+
+#define MAX_RING_SIZE 4
+#define INPUT_SIZE 5
+#define OUTPUT_SIZE 3
+#define N_CASES 8
+#define TOLERANCE 1e-12
+
+typedef void (*ring_check_t)(process_ring_t *ring);
+
+void check_allreduce(process_ring_t *ring) {
+    int rank = process_ring_rank(ring);
+    int size = process_ring_size(ring);
+    size_t counts[5] = { 1, 3, 7, 1000, 100003 };
+    for (int c = 0; c < 5; c++) {
+        size_t count = counts[c];
+        double *data = (double *)malloc(count * sizeof(double));
+        float *data_f32 = (float *)malloc(count * sizeof(float));
+        for (size_t i = 0; i < count; i++) {
+            data[i] = (double)(i % 1000) * (rank + 1);
+            data_f32[i] = (float)((i % 100) * (rank + 1));
+        }
+        // Both queued before waiting, they are exchanged in order.
+        process_ring_allreduce_async(ring, data, count);
+        process_ring_f32_allreduce(ring, data_f32, count);
+        double rank_sum = size * (size + 1) / 2;
+        for (size_t i = 0; i < count; i++) {
+            cnd_make_error(data[i] != (double)(i % 1000) * rank_sum, "All-reduce did not produce the sum across the ring.");
+            cnd_make_error(data_f32[i] != (float)((i % 100) * rank_sum), "Single precision all-reduce did not produce the sum across the ring.");
+        }
+        free(data);
+        free(data_f32);
+    }
+
+    double broadcast[10];
+    for (int i = 0; i < 10; i++)
+        broadcast[i] = rank ? -1 : i;
+    process_ring_broadcast(ring, broadcast, 10);
+    for (int i = 0; i < 10; i++)
+        cnd_make_error(broadcast[i] != i, "Broadcast did not copy the first process's array.");
+}
+
+/**
+ * Every process trains on its shard [start, end) of the same batch, and compares against training on the batch's first 'n_cases' in one process.
+*/
+void check_train_shard(process_ring_t *ring, int start, int end, int n_cases) {
+    int rank = process_ring_rank(ring);
+    // The same data in every process, and different initial weights until the broadcast.
+    random_init_seeded(16);
+    double input_data[N_CASES * INPUT_SIZE];
+    double label_data[N_CASES * OUTPUT_SIZE];
+    matrix_t inputs[N_CASES];
+    matrix_t labels[N_CASES];
+    matrix_initialize_multiple_from_array(inputs, N_CASES, 1, INPUT_SIZE, input_data);
+    matrix_initialize_multiple_from_array(labels, N_CASES, 1, OUTPUT_SIZE, label_data);
+    for (int i = 0; i < N_CASES * INPUT_SIZE; i++)
+        input_data[i] = random_double_between(-1, 1);
+    for (int i = 0; i < N_CASES * OUTPUT_SIZE; i++)
+        label_data[i] = random_double_between(0, 1);
+    random_init_seeded(100 + rank);
+
+    int hidden_layer_sizes[2] = { 7, 4 };
+    neural_network_t *nn = create_network(INPUT_SIZE, OUTPUT_SIZE, 2, hidden_layer_sizes);
+    neural_network_t *nn_reference = create_network(INPUT_SIZE, OUTPUT_SIZE, 2, hidden_layer_sizes);
+    neural_network_layers_randomize(nn);
+    neural_network_distributed_broadcast(nn, ring);
+    copy_network(nn, nn_reference);
+
+    neural_network_trainer_t trainer;
+    neural_network_trainer_initialize(nn, &trainer, N_CASES);
+    neural_network_train_distributed(&trainer, ring, inputs + start, labels + start, end - start, 0.5);
+    // A process with no cases still takes part.
+    neural_network_train_distributed(&trainer, ring, NULL, NULL, 0, 0.5);
+    neural_network_trainer_delete(&trainer);
+
+    neural_network_trainer_t trainer_reference;
+    neural_network_trainer_initialize(nn_reference, &trainer_reference, N_CASES);
+    neural_network_trainer_train_batch(&trainer_reference, inputs, labels, n_cases, 0.5);
+    neural_network_trainer_delete(&trainer_reference);
+
+    for (int k = 0; k < nn->hidden_layer_count + 1; k++) {
+        matrix_t *weights = &nn->layers[k].weights;
+        int length = weights->cols * weights->rows;
+        for (int j = 0; j < length; j++)
+            cnd_make_error(fabs(weights->data[j] - nn_reference->layers[k].weights.data[j]) > TOLERANCE, "Distributed training differs from the batch's mean gradient.");
+        // Every process holds the first process's bits.
+        double *copy = (double *)malloc(length * sizeof(double));
+        memcpy(copy, weights->data, length * sizeof(double));
+        process_ring_broadcast(ring, copy, length);
+        cnd_make_error(memcmp(copy, weights->data, length * sizeof(double)) != 0, "Distributed training left the processes' networks different.");
+        free(copy);
+    }
+    neural_network_delete(nn);
+    neural_network_delete(nn_reference);
+}
+
+/**
+ * Shards of equal size.
+*/
+void check_train(process_ring_t *ring) {
+    int rank = process_ring_rank(ring);
+    int shard = N_CASES / process_ring_size(ring);
+    check_train_shard(ring, rank * shard, (rank + 1) * shard, shard * process_ring_size(ring));
+}
+
+/**
+ * Shards growing with the rank, the first empty in rings of more than one process, as the last batches of an epoch over a dataset the ring does not divide.
+*/
+void check_train_uneven(process_ring_t *ring) {
+    int rank = process_ring_rank(ring);
+    int size = process_ring_size(ring);
+    check_train_shard(ring, N_CASES * rank * rank / (size * size), N_CASES * (rank + 1) * (rank + 1) / (size * size), N_CASES);
+}
+
+/**
+ * Fork a ring of processes which each run the check, failing if any of them fails.
+*/
+void run_ring(const char *address, int size, ring_check_t check) {
+    pid_t children[MAX_RING_SIZE];
+    for (int rank = 0; rank < size; rank++) {
+        children[rank] = fork();
+        cnd_make_error(children[rank] < 0, "Failed to fork a process of the ring.");
+        if (children[rank] == 0) {
+            process_ring_t *ring = process_ring_create(address, rank, size);
+            check(ring);
+            process_ring_delete(ring);
+            exit(EXIT_SUCCESS);
+        }
+    }
+    for (int rank = 0; rank < size; rank++) {
+        int status;
+        waitpid(children[rank], &status, 0);
+        cnd_make_error(!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS, "A process of the ring failed.");
+    }
+}
+
+int main() {
+    char address[128];
+    for (int size = 1; size <= MAX_RING_SIZE; size++) {
+        sprintf(address, "unix:/tmp/test_process_ring_%d_%d", (int)getpid(), size);
+        run_ring(address, size, check_allreduce);
+        run_ring(address, size, check_train);
+        run_ring(address, size, check_train_uneven);
+    }
+    // Consecutive ports on the loopback interface, away from the ports of other runs.
+    sprintf(address, "tcp:127.0.0.1:%d", 20000 + (int)getpid() % 20000);
+    run_ring(address, 3, check_allreduce);
+
+    printf("All process ring checks passed.\n");
+}
@@ -0,0 +1,72 @@
+#include "../src/random.h"
+#include "../src/error.h"
+
+#include <stdio.h>
+
+/**
+ * This file checks that seeded generators draw reproducible sequences in range,
+ * and that shuffles are permutations, reproducible by seed, putting each index first about equally often.
+*/
+
+#define N_INDICES 1000
+#define N_DRAWS 100000
+#define N_SMALL 5
+#define N_SHUFFLES 50000
+// The largest accepted relative difference of a count from its expectation.
+#define TOLERANCE 0.05
+
+void check_permutation(const int32_t *indices, int32_t n) {
+    int seen[N_INDICES] = { 0 };
+    for (int32_t i = 0; i < n; i++) {
+        cnd_make_error(indices[i] < 0 || indices[i] >= n, "Shuffled index out of range.");
+        cnd_make_error(seen[indices[i]]++, "Shuffled index repeated.");
+    }
+}
+
+int main() {
+    random_state_t state_a;
+    random_state_t state_b;
+    random_state_seed(&state_a, 17);
+    random_state_seed(&state_b, 17);
+    for (int i = 0; i < N_DRAWS; i++)
+        cnd_make_error(random_state_next(&state_a) != random_state_next(&state_b), "Generators of the same seed drew different sequences.");
+    random_state_seed(&state_b, 18);
+    cnd_make_error(random_state_next(&state_a) == random_state_next(&state_b), "Generators of different seeds drew the same value.");
+
+    int counts[N_SMALL] = { 0 };
+    for (int i = 0; i < N_DRAWS; i++) {
+        uint32_t value = random_state_below(&state_a, N_SMALL);
+        cnd_make_error(value >= N_SMALL, "Random value out of range.");
+        counts[value]++;
+    }
+    for (int i = 0; i < N_SMALL; i++)
+        cnd_make_error(counts[i] < (1 - TOLERANCE) * N_DRAWS / N_SMALL || counts[i] > (1 + TOLERANCE) * N_DRAWS / N_SMALL, "Random values are not uniform.");
+
+    int32_t indices_a[N_INDICES];
+    int32_t indices_b[N_INDICES];
+    for (int i = 0; i < N_INDICES; i++)
+        indices_a[i] = indices_b[i] = i;
+    random_state_seed(&state_a, 5);
+    random_state_seed(&state_b, 5);
+    random_state_shuffle(&state_a, indices_a, N_INDICES);
+    random_state_shuffle(&state_b, indices_b, N_INDICES);
+    check_permutation(indices_a, N_INDICES);
+    int moved = 0;
+    for (int i = 0; i < N_INDICES; i++) {
+        cnd_make_error(indices_a[i] != indices_b[i], "Shuffles of the same seed differ.");
+        moved += indices_a[i] != i;
+    }
+    cnd_make_error(moved < N_INDICES / 2, "Shuffle left most indices in place.");
+
+    int firsts[N_SMALL] = { 0 };
+    for (int s = 0; s < N_SHUFFLES; s++) {
+        int32_t small[N_SMALL] = { 0, 1, 2, 3, 4 };
+        random_state_shuffle(&state_a, small, N_SMALL);
+        check_permutation(small, N_SMALL);
+        firsts[small[0]]++;
+    }
+    for (int i = 0; i < N_SMALL; i++)
+        cnd_make_error(firsts[i] < (1 - TOLERANCE) * N_SHUFFLES / N_SMALL || firsts[i] > (1 + TOLERANCE) * N_SHUFFLES / N_SMALL, "Shuffles are not uniform.");
+
+    printf("All random checks passed.\n");
+}
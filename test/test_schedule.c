@@ -0,0 +1,156 @@
+#include "../src/neural_network.h"
+#include "../src/neural_network_train.h"
+#include "../src/random.h"
+#include "../src/schedule.h"
+#include "../src/error.h"
+
+#include <math.h>
+#include <stdio.h>
+
+/**
+ * This file checks the shape of every learning rate schedule, that the plateau schedule decays only after its patience runs out,
+ * and that a trainer with a schedule scales its updates by the schedule's factors.
+*/
+
+#define TOTAL_STEPS 100
+#define TOLERANCE 1e-12
+
+#define INPUT_SIZE 4
+#define OUTPUT_SIZE 2
+#define N_CASES 6
+
+int close_to(double a, double b) {
+    return fabs(a - b) <= TOLERANCE;
+}
+
+/**
+ * Check that the schedule's factors never rise, or never fall, over the steps [start, end).
+*/
+void check_monotonic(schedule_t *schedule, long long start, long long end, int rising, const char *message) {
+    for (long long step = start + 1; step < end; step++) {
+        double previous = schedule_factor(schedule, step - 1);
+        double factor = schedule_factor(schedule, step);
+        cnd_make_error(rising ? factor < previous : factor > previous, message);
+    }
+}
+
+void check_shapes() {
+    schedule_t schedule;
+
+    schedule_initialize(&schedule, "constant", TOTAL_STEPS);
+    for (long long step = 0; step < 2 * TOTAL_STEPS; step++)
+        cnd_make_error(schedule_factor(&schedule, step) != 1, "Constant schedule is not constant.");
+
+    schedule_initialize(&schedule, "step", TOTAL_STEPS);
+    cnd_make_error(!close_to(schedule_factor(&schedule, 0), 1), "Step schedule does not start at 1.");
+    cnd_make_error(!close_to(schedule_factor(&schedule, schedule.step_size - 1), 1), "Step schedule decays early.");
+    cnd_make_error(!close_to(schedule_factor(&schedule, schedule.step_size), schedule.decay), "Step schedule does not decay after its step size.");
+    check_monotonic(&schedule, 0, TOTAL_STEPS, 0, "Step schedule rises.");
+
+    const char *decaying[2] = { "exponential", "cosine" };
+    for (int i = 0; i < 2; i++) {
+        schedule_initialize(&schedule, decaying[i], TOTAL_STEPS);
+        cnd_make_error(!close_to(schedule_factor(&schedule, 0), 1), "Decaying schedule does not start at 1.");
+        cnd_make_error(!close_to(schedule_factor(&schedule, TOTAL_STEPS - 1), schedule.final_factor), "Decaying schedule does not end at its final factor.");
+        cnd_make_error(!close_to(schedule_factor(&schedule, 10 * TOTAL_STEPS), schedule.final_factor), "Decaying schedule moves past its last step.");
+        check_monotonic(&schedule, 0, TOTAL_STEPS, 0, "Decaying schedule rises.");
+    }
+
+    const char *cycling[2] = { "warmup", "one-cycle" };
+    for (int i = 0; i < 2; i++) {
+        schedule_initialize(&schedule, cycling[i], TOTAL_STEPS);
+        long long peak = schedule.warmup_steps - 1;
+        double initial = i == 0 ? 0 : schedule.initial_factor;
+        cnd_make_error(schedule_factor(&schedule, 0) <= initial || schedule_factor(&schedule, 0) > 1, "Cycling schedule does not start just above its initial factor.");
+        cnd_make_error(!close_to(schedule_factor(&schedule, peak), 1), "Cycling schedule does not peak at 1 at the end of its warmup.");
+        cnd_make_error(!close_to(schedule_factor(&schedule, TOTAL_STEPS - 1), schedule.final_factor), "Cycling schedule does not end at its final factor.");
+        check_monotonic(&schedule, 0, peak + 1, 1, "Cycling schedule falls during its warmup.");
+        check_monotonic(&schedule, peak, TOTAL_STEPS, 0, "Cycling schedule rises after its warmup.");
+    }
+}
+
+void check_plateau() {
+    schedule_t schedule;
+    schedule_initialize(&schedule, "plateau", TOTAL_STEPS);
+    schedule.patience = 2;
+    schedule_observe(&schedule, 0.5);
+    schedule_observe(&schedule, 0.6);
+    schedule_observe(&schedule, 0.6);
+    cnd_make_error(schedule_factor(&schedule, 0) != 1, "Plateau schedule decays before its patience runs out.");
+    schedule_observe(&schedule, 0.55);
+    cnd_make_error(!close_to(schedule_factor(&schedule, 0), schedule.decay), "Plateau schedule does not decay once its patience runs out.");
+    schedule_observe(&schedule, 0.7);
+    schedule_observe(&schedule, 0.65);
+    cnd_make_error(!close_to(schedule_factor(&schedule, 0), schedule.decay), "Plateau schedule does not restart its patience on improvement.");
+    for (int i = 0; i < 100; i++)
+        schedule_observe(&schedule, 0);
+    cnd_make_error(!close_to(schedule_factor(&schedule, 0), schedule.final_factor), "Plateau schedule decays past its final factor.");
+
+    // Other schedules ignore observations.
+    schedule_initialize(&schedule, "cosine", TOTAL_STEPS);
+    for (int i = 0; i < 10; i++)
+        schedule_observe(&schedule, 0);
+    cnd_make_error(schedule_factor(&schedule, 0) != 1, "Cosine schedule reacts to observations.");
+}
+
+/**
+ * Train two copies of a network, one with a schedule and one passing the schedule's factors in the training parameter.
+*/
+void check_trainer() {
+    int hidden_layer_sizes[1] = { 3 };
+    char *activation_functions[2] = { "sigmoid", "sigmoid" };
+    neural_network_t *nn = neural_network_create(INPUT_SIZE, OUTPUT_SIZE, 1, hidden_layer_sizes, activation_functions);
+    neural_network_t *nn_reference = neural_network_create(INPUT_SIZE, OUTPUT_SIZE, 1, hidden_layer_sizes, activation_functions);
+    neural_network_layers_randomize(nn);
+    for (int i = 0; i < 2; i++) {
+        matrix_copy_o(&nn->layers[i].weights, &nn_reference->layers[i].weights);
+        matrix_copy_o(&nn->layers[i].biases, &nn_reference->layers[i].biases);
+    }
+
+    double input_data[N_CASES * INPUT_SIZE];
+    double label_data[N_CASES * OUTPUT_SIZE];
+    matrix_t inputs[N_CASES];
+    matrix_t labels[N_CASES];
+    matrix_initialize_multiple_from_array(inputs, N_CASES, 1, INPUT_SIZE, input_data);
+    matrix_initialize_multiple_from_array(labels, N_CASES, 1, OUTPUT_SIZE, label_data);
+    for (int i = 0; i < N_CASES * INPUT_SIZE; i++)
+        input_data[i] = random_double_between(-1, 1);
+    for (int i = 0; i < N_CASES * OUTPUT_SIZE; i++)
+        label_data[i] = random_double_between(0, 1);
+
+    schedule_t schedule;
+    schedule_initialize(&schedule, "one-cycle", 10);
+    neural_network_trainer_t trainer;
+    neural_network_trainer_t reference_trainer;
+    neural_network_trainer_initialize(nn, &trainer, N_CASES);
+    neural_network_trainer_initialize(nn_reference, &reference_trainer, N_CASES);
+    neural_network_trainer_set_schedule(&trainer, &schedule);
+    for (long long step = 0; step < 12; step++) {
+        neural_network_trainer_train_batch(&trainer, inputs, labels, N_CASES, 0.5);
+        neural_network_trainer_train_batch(&reference_trainer, inputs, labels, N_CASES, 0.5 * schedule_factor(&schedule, step));
+    }
+    cnd_make_error(schedule_steps(&schedule) != 12, "Trainer does not move its schedule a step per update.");
+    for (int i = 0; i < 2; i++) {
+        matrix_t *matrices[2][2] = {
+            { &nn->layers[i].weights, &nn_reference->layers[i].weights },
+            { &nn->layers[i].biases, &nn_reference->layers[i].biases }
+        };
+        for (int m = 0; m < 2; m++) {
+            for (int j = 0; j < matrices[m][0]->cols * matrices[m][0]->rows; j++)
+                cnd_make_error(!close_to(matrices[m][0]->data[j], matrices[m][1]->data[j]), "Trainer does not scale its updates by its schedule.");
+        }
+    }
+
+    neural_network_trainer_delete(&trainer);
+    neural_network_trainer_delete(&reference_trainer);
+    neural_network_delete(nn);
+    neural_network_delete(nn_reference);
+}
+
+int main() {
+    random_init_seeded(31);
+    check_shapes();
+    check_plateau();
+    check_trainer();
+    printf("All schedule checks passed.\n");
+}
@@ -0,0 +1,100 @@
+#include "../src/thread_pool.h"
+#include "../src/error.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * This file checks that 'thread_pool_parallel_for' visits every index of a range exactly once for pools of several sizes and grains,
+ * that task groups run every task before their wait returns, and that tasks can themselves submit and wait on work.
+*/
+
+#define RANGE_SIZE 100003
+#define N_TASKS 1000
+#define NESTED_OUTER 16
+#define NESTED_INNER 1000
+
+typedef struct {
+    atomic_int *visits;
+    int offset;
+} range_data_t;
+
+void visit_range(void *data, int start, int end) {
+    range_data_t *range = (range_data_t *)data;
+    for (int i = start; i < end; i++)
+        atomic_fetch_add(&range->visits[i - range->offset], 1);
+}
+
+void check_parallel_for(thread_pool_t *pool, int start, int end, int grain) {
+    int n = end - start;
+    atomic_int *visits = (atomic_int *)calloc(n > 0 ? n : 1, sizeof(atomic_int));
+    range_data_t range = { visits, start };
+    thread_pool_parallel_for(pool, start, end, grain, visit_range, &range);
+    for (int i = 0; i < n; i++)
+        cnd_make_error(atomic_load(&visits[i]) != 1, "Parallel for did not visit an index exactly once.");
+    free(visits);
+}
+
+void increment(void *data) {
+    atomic_fetch_add((atomic_int *)data, 1);
+}
+
+void check_group(thread_pool_t *pool) {
+    atomic_int counter;
+    atomic_init(&counter, 0);
+    thread_pool_group_t group;
+    thread_pool_group_initialize(&group, pool);
+    for (int i = 0; i < N_TASKS; i++)
+        thread_pool_group_submit(&group, increment, &counter);
+    thread_pool_group_wait(&group);
+    cnd_make_error(atomic_load(&counter) != N_TASKS, "Task group wait returned before every task ran.");
+}
+
+typedef struct {
+    thread_pool_t *pool;
+    atomic_int *visits;
+} nested_data_t;
+
+/**
+ * Each outer index runs its own parallel for over a slice of the visits, from inside a pool task.
+*/
+void nested_range(void *data, int start, int end) {
+    nested_data_t *nested = (nested_data_t *)data;
+    for (int i = start; i < end; i++) {
+        range_data_t range = { nested->visits + i * NESTED_INNER, 0 };
+        thread_pool_parallel_for(nested->pool, 0, NESTED_INNER, 10, visit_range, &range);
+    }
+}
+
+void check_nested(thread_pool_t *pool) {
+    atomic_int *visits = (atomic_int *)calloc(NESTED_OUTER * NESTED_INNER, sizeof(atomic_int));
+    nested_data_t nested = { pool, visits };
+    thread_pool_parallel_for(pool, 0, NESTED_OUTER, 1, nested_range, &nested);
+    for (int i = 0; i < NESTED_OUTER * NESTED_INNER; i++)
+        cnd_make_error(atomic_load(&visits[i]) != 1, "Nested parallel for did not visit an index exactly once.");
+    free(visits);
+}
+
+int main() {
+    cnd_make_error(thread_pool_size(NULL) != thread_pool_cpu_count(), "Default thread pool is not sized to the online CPU count.");
+
+    int sizes[] = { 1, 2, 3, 8 };
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        thread_pool_t *pool = thread_pool_create(sizes[s]);
+        cnd_make_error(thread_pool_size(pool) != sizes[s], "Thread pool has the wrong size.");
+        check_parallel_for(pool, 0, RANGE_SIZE, 1);
+        check_parallel_for(pool, -57, RANGE_SIZE, 1000);
+        check_parallel_for(pool, 10, 11, 1);
+        check_parallel_for(pool, 5, 5, 1);
+        check_group(pool);
+        check_nested(pool);
+        thread_pool_delete(pool);
+    }
+
+    check_parallel_for(NULL, 0, RANGE_SIZE, 64);
+    check_group(NULL);
+    check_nested(NULL);
+
+    printf("All thread pool checks passed.\n");
+}